@@ -0,0 +1,63 @@
+#include "../Chess/engine/Annotate.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "Annotate <.pgn | > <.pgn> [-t ] [-n ] [-mistake ] [-blunder ]"
+	// -      
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o annotate
+	std::vector<std::string> paths;
+	annotate::Options options;
+	options.threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	bool usage = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-t" && i + 1 < argc)             options.threads = std::atoi(argv[++i]);
+		else if (arg == "-n" && i + 1 < argc)        options.nodes = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "-mistake" && i + 1 < argc)  options.mistake = std::atoi(argv[++i]);
+		else if (arg == "-blunder" && i + 1 < argc)  options.blunder = std::atoi(argv[++i]);
+		else if (!arg.empty() && arg[0] != '-')      paths.emplace_back(arg);
+		else                                         usage = true;
+	}
+	if (usage || paths.size() != 2)
+	{
+		std::cerr << "usage: Annotate <games.pgn | archive> <out.pgn> [-t threads] [-n nodes] [-mistake cp] [-blunder cp]\n";
+		return 1;
+	}
+
+	try
+	{
+		std::ofstream pgn(paths[1]);
+		if (!pgn)
+			throw std::runtime_error("annotate: cannot write " + paths[1]);
+		auto stats = annotate::run(paths[0], pgn, options);
+
+		std::cout << std::fixed << std::setprecision(2)
+			      << "games          " << std::setw(12) << stats.games << " ( errors " << stats.errors << " )\n"
+			      << "positions      " << std::setw(12) << stats.positions << "\n"
+			      << "mistakes       " << std::setw(12) << stats.mistakes << "\n"
+			      << "blunders       " << std::setw(12) << stats.blunders << "\n"
+			      << "time           " << std::setw(12) << stats.seconds << " s ( " << options.threads << " threads )\n"
+			      << "positions/s    " << std::setw(12) << (stats.seconds > 0 ? stats.positions / stats.seconds : 0.0) << "\n"
+			      << "knps           " << std::setw(12) << (stats.seconds > 0 ? stats.nodes / stats.seconds / 1000 : 0.0) << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
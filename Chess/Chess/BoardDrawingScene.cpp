@@ -1,11 +1,18 @@
 #include "BoardDrawingScene.h"
 
+#include <cmath>
+#include <cstdio>
+
 using namespace core;
 
 constexpr int  BoardBorder     = SquareLength / 2;
 constexpr auto RightPaneWidth  = SquareLength * 4;
 constexpr int  RightPaneMargin = BoardBorder * 3 / 4;
 
+constexpr int AnalysisLines = 3;
+constexpr Color BestArrowCol  = Color::Green.withAlpha(170);
+constexpr Color OtherArrowCol = Color::Blue.withAlpha(110);
+
 BoardDrawingScene::BoardDrawingScene() : pieceMovingData(*this) {}
 
 void BoardDrawingScene::onSizeChanged(Point size)
@@ -136,7 +143,191 @@ void BoardDrawingScene::drawRightPaneInfo(Paint& p) const
 	{
 		p.drawText(rect2 - Point(0, rect2.height()), "CHECK");
 	}
+
+	drawExplorerInfo(p);
+	drawAnalysisInfo(p);
+}
+
+void BoardDrawingScene::drawExplorerInfo(Paint& p) const
+{
+	constexpr int MaxMoves   = 5;
+	constexpr int lineHeight = 26;
+
+	auto explorer = getExplorer();
+	if (!explorer)
+		return;
+
+	auto pos = engine::Position::fromState(getBoard().getState());
+	if (!explorerCache.valid || explorerCache.key != pos.getKey())
+	{
+		explorerCache.valid = true;
+		explorerCache.key = pos.getKey();
+		explorerCache.stats = explorer->lookup(pos);
+		explorerCache.moves.clear();
+		if (explorerCache.stats)
+		{
+			for (auto& m : explorerCache.stats->moves)
+			{
+				if (explorerCache.moves.size() == MaxMoves)
+					break;
+				engine::san::write(pos, engine::Move::fromRaw(m.move), explorerCache.moves.emplace_back().data());
+			}
+		}
+	}
+
+	auto& stats = explorerCache.stats;
+	int lines = 1 + int(explorerCache.moves.size());
+	Rect line
+	{
+		paneRect.left + MarginSize,
+		(paneRect.top + paneRect.bottom) / 2 - lines * lineHeight / 2,
+		paneRect.right - MarginSize,
+		(paneRect.top + paneRect.bottom) / 2 - lines * lineHeight / 2 + lineHeight,
+	};
+
+	p.setFont("Arial", 22);
+	p.setTextColor(MenuTextCol);
+	if (!stats)
+	{
+		p.drawText(line, "no games");
+		return;
+	}
+	p.drawText(line, concat(stats->results.games(), " games, white ", stats->results.whiteScore(), "%"));
+
+	//  |  |  
+	int column = line.width() / 3;
+	for (size_t i = 0; i < explorerCache.moves.size(); ++i)
+	{
+		line = line + Point(0, lineHeight);
+		auto& results = stats->moves[i].results;
+		Rect left  { line.left,              line.top, line.left + column,     line.bottom };
+		Rect mid   { line.left + column,     line.top, line.left + column * 2, line.bottom };
+		Rect right { line.left + column * 2, line.top, line.right,             line.bottom };
+		p.drawText(left, explorerCache.moves[i].data());
+		p.drawText(mid, concat(results.games()));
+		p.drawText(right, concat(results.whiteScore(), "%"));
+	}
+}
+void BoardDrawingScene::setAnalysing(bool val)
+{
+	if (val == isAnalysing())
+		return;
+	analysis = nullptr;
+	if (!val)
+	{
+		analyzer.reset();
+		return;
+	}
+
+	analyzer = std::make_unique<engine::Analyzer>(AnalysisLines);
+	//       :     
+	analyzer->onUpdate = []() { WindowHandler::instance().post([]() { redraw(); }); };
+}
+
+void BoardDrawingScene::drawAnalysisArrows(Paint& p) const
+{
+	if (!analysis)
+		return;
+
+	//    :     
+	int count = std::min(int(analysis->lines.size()), AnalysisLines);
+	for (int i = count - 1; i >= 0; --i)
+	{
+		auto& pv = analysis->lines[i].pv;
+		if (pv.empty())
+			continue;
+		auto from = boardPosToScreen(engine::toPos(pv[0].from())) + SquareSize / 2;
+		auto to   = boardPosToScreen(engine::toPos(pv[0].to()))   + SquareSize / 2;
+		p.drawArrow(from, to, i == 0 ? SquareLength / 6 : SquareLength / 8, i == 0 ? BestArrowCol : OtherArrowCol);
+	}
 }
+
+void BoardDrawingScene::drawAnalysisInfo(Paint& p) const
+{
+	constexpr int MaxMoves   = 4;
+	constexpr int lineHeight = 22;
+	constexpr int barMargin  = 4;
+	constexpr auto leftFormat = DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS;
+
+	if (!isAnalysing())
+		return;
+
+	//      :  -  ,    ( 4  ~ 90% )
+	int whiteScore = 0;
+	if (analysis)
+	{
+		whiteScore = analysis->lines[0].score;
+		if (analysis->side == chess::Side::Black)
+			whiteScore = -whiteScore;
+	}
+	double whiteShare = std::abs(whiteScore) >= engine::MateBound ? (whiteScore > 0 ? 1.0 : 0.0)
+	                                                              : 1 / (1 + std::pow(10.0, -whiteScore / 400.0));
+
+	//      ,  -    
+	Rect bar
+	{
+		boardRect.right + BoardBorder + barMargin,
+		boardRect.top,
+		paneRect.left - barMargin,
+		boardRect.bottom,
+	};
+	int split = int(bar.height() * whiteShare);
+	bool whiteBelow = getPlayerSide() == chess::Side::White;
+	int border = whiteBelow ? bar.bottom - split : bar.top + split;
+	p.fillRect(bar, Color::Black);
+	p.fillRect(whiteBelow ? Rect{ bar.left, border, bar.right, bar.bottom }
+	                      : Rect{ bar.left, bar.top, bar.right, border }, Color::White);
+	p.drawRectOut(bar, MarginSize, MenuMarginCol);
+
+	Rect line
+	{
+		paneRect.left + MarginSize * 3,
+		paneRect.top + 110,
+		paneRect.right - MarginSize * 3,
+		paneRect.top + 110 + lineHeight,
+	};
+	p.setFont("Arial", 18);
+	p.setTextColor(MenuTextCol);
+	if (!analysis)
+	{
+		p.drawText(line, "analysing...", leftFormat);
+		return;
+	}
+	p.drawText(line, concat("depth ", analysis->depth, analysis->finished ? " (done)" : ""), leftFormat);
+
+	//       SAN   
+	auto pos = engine::Position::fromState(getBoard().getState());
+	int count = std::min(int(analysis->lines.size()), AnalysisLines);
+	for (int i = 0; i < count; ++i)
+	{
+		auto& pvLine = analysis->lines[i];
+		int score = analysis->side == chess::Side::White ? pvLine.score : -pvLine.score;
+
+		char buffer[16];
+		if (std::abs(score) >= engine::MateBound)
+			std::snprintf(buffer, sizeof(buffer), "#%s%d", score < 0 ? "-" : "", (engine::MateScore - std::abs(score) + 1) / 2);
+		else
+			std::snprintf(buffer, sizeof(buffer), "%+.2f", score / 100.0);
+		std::string text = buffer;
+
+		std::array<engine::Undo, MaxMoves> undos;
+		int made = 0;
+		for (; made < MaxMoves && made < int(pvLine.pv.size()); ++made)
+		{
+			char san[engine::san::BufferSize];
+			engine::san::write(pos, pvLine.pv[made], san);
+			text += ' ';
+			text += san;
+			pos.makeMove(pvLine.pv[made], undos[made]);
+		}
+		while (made-- > 0)
+			pos.unmakeMove(pvLine.pv[made], undos[made]);
+
+		line = line + Point(0, lineHeight);
+		p.drawText(line, text, leftFormat);
+	}
+}
+
 void BoardDrawingScene::drawEatenPieces(Paint& p) const
 {
 	constexpr int pieceSize     = 30;
@@ -183,7 +374,19 @@ void BoardDrawingScene::drawEatenPieces(Paint& p) const
 
 void BoardDrawingScene::onDraw(Paint& paint)
 {
+	//     :     ,    
+	analysis = nullptr;
+	if (analyzer)
+	{
+		auto pos = engine::Position::fromState(getBoard().getState());
+		analyzer->setPosition(pos);
+		auto snapshot = analyzer->read();
+		if (snapshot && snapshot->key == pos.getKey() && !snapshot->lines.empty())
+			analysis = snapshot;
+	}
+
 	drawBoard(paint);
+	drawAnalysisArrows(paint);
 	drawEatenPieces(paint);
 	drawRightPaneInfo(paint);
 
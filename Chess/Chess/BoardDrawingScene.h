@@ -2,8 +2,14 @@
 
 #include "SceneCommon.h"
 #include "chess/Board.h"
+#include "engine/Analyzer.h"
+#include "engine/Explorer.h"
+#include "engine/San.h"
 
+#include <array>
 #include <chrono>
+#include <memory>
+#include <optional>
 
 /// <summary>
 ///    
@@ -34,6 +40,20 @@ public:
 	/// <param name="paint"></param>
 	void onDraw(core::Paint& paint) override;
 
+	/// <summary>
+	///   :    ,     
+	/// </summary>
+	/// <returns>true -   </returns>
+	bool isAnalysing() const { return analyzer != nullptr; }
+
+	/// <summary>
+	///      [     ]
+	/// </summary>
+	/// <param name="val"></param>
+	void setAnalysing(bool val);
+
+	void toggleAnalysing() { setAnalysing(!isAnalysing()); }
+
 protected:
 	/// <summary>
 	///      
@@ -103,6 +123,30 @@ protected:
 	/// <param name="paint"> </param>
 	virtual void drawRightPaneInfo(core::Paint& paint) const;
 
+	/// <summary>
+	///      
+	/// </summary>
+	/// <returns> [ nullptr -     ]</returns>
+	virtual const engine::explorer::Explorer* getExplorer() const { return nullptr; }
+
+	/// <summary>
+	///        :  ,     
+	/// </summary>
+	/// <param name="paint"> </param>
+	void drawExplorerInfo(core::Paint& paint) const;
+
+	/// <summary>
+	///         (   -  )
+	/// </summary>
+	/// <param name="paint"> </param>
+	void drawAnalysisArrows(core::Paint& paint) const;
+
+	/// <summary>
+	///            
+	/// </summary>
+	/// <param name="paint"> </param>
+	void drawAnalysisInfo(core::Paint& paint) const;
+
 	/// <summary>
 	///  
 	/// </summary>
@@ -135,6 +179,28 @@ private:
 	core::Rect boardRect; //   (    { 1..8, A..H } )
 	core::Rect paneRect;
 
+	/// <summary>
+	///      :  -    
+	/// </summary>
+	struct ExplorerCache
+	{
+		bool valid = false;
+		uint64_t key = 0;
+		std::optional<engine::explorer::PositionStats> stats;
+		std::vector<std::array<char, engine::san::BufferSize>> moves;
+	};
+	mutable ExplorerCache explorerCache;
+
+	/// <summary>
+	///   [ nullptr -    ]
+	/// </summary>
+	std::unique_ptr<engine::Analyzer> analyzer;
+
+	/// <summary>
+	///         [ nullptr -    ]
+	/// </summary>
+	const engine::AnalysisSnapshot* analysis = nullptr;
+
 protected:
 	/// <summary>
 	///   
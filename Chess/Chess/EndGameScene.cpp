@@ -54,6 +54,10 @@ const std::string& EndGameScene::getPlayerName(chess::Side s) const
 {
 	return GameScene::instance().getPlayerName(s);
 }
+const engine::explorer::Explorer* EndGameScene::getExplorer() const
+{
+	return GameScene::instance().getExplorer();
+}
 chess::Side EndGameScene::getPlayerSide() const
 {
 	return GameScene::instance().getPlayerSide();
@@ -101,6 +101,12 @@ public:
 	/// <returns> </returns>
 	const std::string& getPlayerName(chess::Side) const override;
 
+	/// <summary>
+	///   
+	/// </summary>
+	/// <returns></returns>
+	const engine::explorer::Explorer* getExplorer() const override;
+
 	/// <summary>
 	///    
 	/// </summary>
@@ -4,28 +4,111 @@
 #include "PauseScene.h"
 #include "PromotionScene.h"
 
+#include <ctime>
+
 using namespace core;
 
 static void onPromotion(chess::Side side) { PromotionScene::onPromotion(side); }
 static void onCheckmate(chess::FullMove move, chess::Side whoWon)
 {
+	GameScene::onGameOver(whoWon == chess::Side::White ? engine::archive::Result::WhiteWins : engine::archive::Result::BlackWins);
 	EndGameScene::onCheckmate(move, concat(whoWon, " (", GameScene::instance().getPlayerName(whoWon), ") won!"));
 }
 
 static void onStalemate(chess::FullMove move, chess::Side whoCantMove)
 {
+	GameScene::onGameOver(engine::archive::Result::Draw);
 	EndGameScene::onStalemate(move, concat(whoCantMove, " can't move"));
 }
 static void onGameDraw(chess::FullMove move, std::string_view why)
 {
+	GameScene::onGameOver(engine::archive::Result::Draw);
 	EndGameScene::onGameDraw(move, std::string(why));
 }
+
+/// <summary>
+///      
+/// </summary>
+static constexpr const char* ArchivePath = "games.cga";
+
+/// <summary>
+///   ( Games explorer )   
+/// </summary>
+static constexpr const char* ExplorerPath = "explorer.bin";
+
+/// <summary>
+///       
+/// </summary>
+static constexpr const char* JournalPath = "game.journal";
+
+/// <summary>
+///   :   
+/// </summary>
+static constexpr uint16_t JournalPlayingComputer = 1;
+
+void GameScene::onGameOver(engine::archive::Result result)
+{
+	auto& i = instance();
+	i.gameOver = true;
+	i.computer.stopPondering();
+	i.journal.clear();
+
+	//           :  -   
+	int game = i.gameNumber;
+	WindowHandler::instance().post([game, result]() { instance().archiveGame(game, result); });
+}
+
+void GameScene::archiveGame(int game, engine::archive::Result result)
+{
+	using engine::archive::Result;
+	if (game != gameNumber)
+		return;
+
+	char date[16] = {};
+	auto now = std::time(nullptr);
+	std::strftime(date, sizeof(date), "%Y.%m.%d", std::localtime(&now));
+	std::string_view resultText = result == Result::WhiteWins ? "1-0" : result == Result::BlackWins ? "0-1" : "1/2-1/2";
+
+	try
+	{
+		engine::archive::Writer writer(ArchivePath, engine::archive::Encoding::Ranked, true);
+		writer.add(board, result, {
+			{ "Date", date },
+			{ "White", playerNames[chess::Side::White] },
+			{ "Black", playerNames[chess::Side::Black] },
+			{ "Result", resultText },
+		});
+		writer.close();
+	}
+	catch (const std::exception& e)
+	{
+		std::clog << "game not archived: " << e.what() << "\n";
+	}
+}
+
+chess::GameResult GameScene::onAdjudicate(const chess::BoardState& state, chess::Side& whoWon)
+{
+	auto& tablebase = instance().tablebase;
+	if (!tablebase)
+		return chess::GameResult::Continue;
+
+	auto res = tablebase->probe(state);
+	if (!res)
+		return chess::GameResult::Continue;
+	if (res->wdl == engine::tb::Wdl::Draw)
+		return chess::GameResult::Draw;
+	whoWon = res->wdl == engine::tb::Wdl::Win ? state.getCurrentSide() : chess::getOtherSide(state.getCurrentSide());
+	return chess::GameResult::Win;
+}
+
 void GameScene::onExecutedMove(chess::FullMove m)
 {
 	char buff[6] = {};
 	m.writeStringAt(buff);
 	std::string move(buff);
-	return;
+
+	//    -  ,     
+	WindowHandler::instance().post([]() { instance().playComputerMove(); });
 }
 
 void GameScene::onFoundMove(chess::FullMove m)
@@ -36,9 +119,117 @@ void GameScene::onFoundMove(chess::FullMove m)
 	i.redraw();
 }
 
-GameScene::GameScene() : board(onPromotion, onCheckmate, onStalemate, onGameDraw)
+GameScene::GameScene() : board(onPromotion, onCheckmate, onStalemate, onGameDraw), journal(JournalPath)
 {
+	board.setJournal(&journal);
 	showingValidMoves = true;
+	playingComputer = true;
+	gameOver = false;
+
+	//   :      
+	try
+	{
+		computer.setBook(engine::PolyglotBook::open("book.bin"));
+	}
+	catch (const std::exception& e)
+	{
+		std::clog << "no opening book: " << e.what() << "\n";
+	}
+
+	//     :      
+	try
+	{
+		explorer = std::make_unique<engine::explorer::Explorer>(ExplorerPath);
+	}
+	catch (const std::exception& e)
+	{
+		std::clog << "no opening explorer: " << e.what() << "\n";
+	}
+
+	//      :     
+	tablebase = std::make_shared<engine::tb::Tablebase>("tablebases");
+	computer.setTablebase(tablebase);
+	board.setAdjudicationCallback(onAdjudicate);
+
+	//    :      
+	try
+	{
+		external = engine::ExternalEngine::fromConfig("engine.txt");
+	}
+	catch (const std::exception& e)
+	{
+		std::clog << "no external engine: " << e.what() << "\n";
+	}
+}
+
+void GameScene::playComputerMove()
+{
+	if (!playingComputer || gameOver || board.getCurrentSide() == getPlayerSide())
+		return;
+
+	//       :       post()
+	if (external && external->isAlive())
+	{
+		int game = gameNumber;
+		external->requestMove(board.getState(), board.getMoveHistory(), computer.limits.movetimeMs,
+			[game](chess::FullMove m)
+			{
+				WindowHandler::instance().post([game, m]() { instance().onExternalMove(game, m); });
+			});
+		return;
+	}
+
+	searchComputerMove();
+}
+
+void GameScene::searchComputerMove()
+{
+	//       :  ,   
+	int game = gameNumber;
+	computer.findMoveAsync(board.getState(), [game](chess::FullMove m)
+	{
+		WindowHandler::instance().post([game, m]() { instance().onComputerMove(game, m); });
+	});
+}
+
+void GameScene::onExternalMove(int game, chess::FullMove m)
+{
+	if (game != gameNumber || !playingComputer || gameOver || board.getCurrentSide() == getPlayerSide())
+		return;
+
+	if (!m.from.isValid())
+	{
+		searchComputerMove();
+		return;
+	}
+	onFoundMove(m);
+}
+
+void GameScene::onComputerMove(int game, chess::FullMove m)
+{
+	if (game != gameNumber || !playingComputer || gameOver || board.getCurrentSide() == getPlayerSide() || !m.from.isValid())
+		return;
+	onFoundMove(m);
+
+	//   ,       
+	if (!gameOver)
+		computer.startPondering(board.getState());
+}
+
+bool GameScene::getPlayingComputer() { return instance().playingComputer; }
+void GameScene::togglePlayingComputer()
+{
+	auto& i = instance();
+	i.playingComputer = !i.playingComputer;
+	i.computer.cancelMove();
+	i.computer.stopPondering();
+	i.playerNames[chess::Side::Black] = i.playingComputer ? "Computer" : "Player 2";
+}
+
+bool GameScene::getShowingAnalysis() { return instance().isAnalysing(); }
+void GameScene::toggleShowingAnalysis()
+{
+	instance().toggleAnalysing();
 }
 
 bool GameScene::getShowingValidMoves() { return instance().showingValidMoves; }
@@ -56,14 +247,45 @@ void GameScene::newGameImpl()
 	cursor = { 4, 0 }; //  
 
 	playerNames[chess::Side::White] = "Player 1";
-	playerNames[chess::Side::Black] = "Player 2";
+	playerNames[chess::Side::Black] = playingComputer ? "Computer" : "Player 2";
+	gameOver = false;
+	computer.newGame();
+	++gameNumber;
+	if (external)
+	{
+		external->newGame();
+		if (playingComputer && !external->getName().empty())
+			playerNames[chess::Side::Black] = external->getName();
+	}
 	selectedPos = chess::Pos::Invalid;
 	pieceMovingData.reset();
 	board.reset();
+	journal.begin(playingComputer ? JournalPlayingComputer : 0);
 	validMoves.clear();
 	SceneManager::load(*this);
 }
 
+bool GameScene::restoreGame()
+{
+	auto saved = chess::MoveJournal::load(JournalPath);
+	if (!saved)
+		return false;
+
+	//          
+	auto& i = instance();
+	i.playingComputer = (saved->flags & JournalPlayingComputer) != 0;
+	i.newGameImpl();
+	for (auto m : saved->moves)
+	{
+		if (i.gameOver)
+			break;
+		i.board.doFullMove(m);
+	}
+	i.redraw();
+	WindowHandler::instance().post([]() { instance().playComputerMove(); });
+	return true;
+}
+
 void GameScene::drawBoard(Paint& paint) const
 {
 	if (isSelected())
@@ -104,6 +326,8 @@ void GameScene::deselect()
 bool GameScene::trySelect(chess::Pos pos)
 {
 	deselect();
+	if (playingComputer && board.getCurrentSide() != getPlayerSide())
+		return false;
 	auto& val = board.at(pos);
 
 	if (!val || val->getSide() != board.getCurrentSide())
@@ -219,6 +443,9 @@ void GameScene::onKeyDown(char k)
 		case VK_SPACE:
 			spaceAction();
 			break;
+		case 'E':
+			toggleAnalysing();
+			break;
 		default:
 			return;
 	}
@@ -2,6 +2,10 @@
 
 #include "BoardDrawingScene.h"
 #include "chess/Board.h"
+#include "chess/Journal.h"
+#include "engine/Archive.h"
+#include "engine/ComputerPlayer.h"
+#include "engine/ExternalEngine.h"
 
 #include <chrono>
 
@@ -22,6 +26,12 @@ public:
 	/// </summary>
 	static void newGame() { instance().newGameImpl(); }
 
+	/// <summary>
+	///       (    )
+	/// </summary>
+	/// <returns>true -       </returns>
+	static bool restoreGame();
+
 	/// <summary>
 	///   
 	/// </summary>
@@ -69,6 +79,34 @@ public:
 	/// </summary>
 	static void toggleShowingValidMoves();
 
+	/// <summary>
+	///    
+	/// </summary>
+	/// <returns>true -      </returns>
+	static bool getPlayingComputer();
+
+	/// <summary>
+	///    
+	/// </summary>
+	static void togglePlayingComputer();
+
+	/// <summary>
+	///   
+	/// </summary>
+	/// <returns>true -      </returns>
+	static bool getShowingAnalysis();
+
+	/// <summary>
+	///   
+	/// </summary>
+	static void toggleShowingAnalysis();
+
+	/// <summary>
+	///      ( , ,  ) :    
+	/// </summary>
+	/// <param name="result"> </param>
+	static void onGameOver(engine::archive::Result result);
+
 	/// <summary>
 	///   
 	/// </summary>
@@ -97,6 +135,12 @@ public:
 		return playerNames[s];
 	}
 
+	/// <summary>
+	///   
+	/// </summary>
+	/// <returns> [ nullptr -     ]</returns>
+	const engine::explorer::Explorer* getExplorer() const override { return explorer.get(); }
+
 private:
 	GameScene();
 
@@ -109,12 +153,51 @@ private:
 
 	chess::Board board;
 
+	/// <summary>
+	///     :          
+	/// </summary>
+	chess::MoveJournal journal;
+
 	chess::Pos selectedPos;
 	chess::Pos cursor;
 	std::vector<chess::Move> validMoves;
 
 	bool showingValidMoves;
 
+	bool playingComputer;
+	bool gameOver;
+	engine::ComputerPlayer computer;
+	std::shared_ptr<const engine::tb::Tablebase> tablebase;
+	std::unique_ptr<engine::explorer::Explorer> explorer;
+
+	/// <summary>
+	///     engine.txt [ nullptr -   ComputerPlayer ]
+	/// </summary>
+	std::unique_ptr<engine::ExternalEngine> external;
+
+	/// <summary>
+	///   :          
+	/// </summary>
+	int gameNumber = 0;
+
+	/// <summary>
+	///      
+	/// [       ]
+	/// </summary>
+	/// <param name="game">   [     -   ]</param>
+	/// <param name="result"> </param>
+	void archiveGame(int game, engine::archive::Result result);
+
+	/// <summary>
+	///  ,     
+	/// </summary>
+	void playComputerMove();
+
+	/// <summary>
+	///    ComputerPlayer    [    onComputerMove() ]
+	/// </summary>
+	void searchComputerMove();
+
 	/// <summary>
 	/// ,      
 	/// </summary>
@@ -157,4 +240,27 @@ private:
 	/// </summary>
 	/// <param name="m"></param>
 	static void onFoundMove(chess::FullMove m);
+
+	/// <summary>
+	///   ComputerPlayer,     :       
+	/// </summary>
+	/// <param name="game"> ,    </param>
+	/// <param name="m"> </param>
+	void onComputerMove(int game, chess::FullMove m);
+
+	/// <summary>
+	///   ,    
+	/// [      -    ComputerPlayer ]
+	/// </summary>
+	/// <param name="game"> ,    </param>
+	/// <param name="m"> </param>
+	void onExternalMove(int game, chess::FullMove m);
+
+	/// <summary>
+	///     :    
+	/// </summary>
+	/// <param name="state"> </param>
+	/// <param name="whoWon"> [   -  ]</param>
+	/// <returns>  </returns>
+	static chess::GameResult onAdjudicate(const chess::BoardState& state, chess::Side& whoWon);
 };
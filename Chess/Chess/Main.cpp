@@ -1,6 +1,9 @@
 #include "MainMenuScene.h"
+#include "engine/Bench.h"
 
 #include <signal.h>
+#include <cstdlib>
+#include <string_view>
 
 using namespace core;
 
@@ -34,7 +37,25 @@ int WINAPI wWinMain(HINSTANCE, HINSTANCE, PWSTR, int nCmdShow)
 }
 #endif
 
-int main()
+int main(int argc, char* argv[])
 {
+	// "Chess.exe bench [depth]" -     
+	// "Chess.exe bench selective [depth]" -    
+	// "Chess.exe bench nnue <file>" -   
+	// "Chess.exe bench reuse [plies] [nodes]" -        
+	// "Chess.exe bench mate [nodes]" -         
+	if (argc > 1 && std::string_view(argv[1]) == "bench")
+	{
+		if (argc > 2 && std::string_view(argv[2]) == "selective")
+			return engine::runSelectiveBench(std::cout, argc > 3 ? std::atoi(argv[3]) : 6);
+		if (argc > 3 && std::string_view(argv[2]) == "nnue")
+			return engine::runNnueBench(std::cout, argv[3]);
+		if (argc > 2 && std::string_view(argv[2]) == "reuse")
+			return engine::runReuseBench(std::cout, argc > 3 ? std::atoi(argv[3]) : 40,
+				                         argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 200000);
+		if (argc > 2 && std::string_view(argv[2]) == "mate")
+			return engine::runMateBench(std::cout, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000);
+		return engine::runBench(std::cout, argc > 2 ? std::atoi(argv[2]) : 5);
+	}
 	return WinMain(0, 0, 0, SW_SHOWDEFAULT);
 }
@@ -8,6 +8,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <utility>
 
 using namespace core;
 
@@ -36,6 +37,15 @@ MainMenuScene::MainMenuScene()
 		}, Mode::Vertical), rects(2)
 {}
 
+void MainMenuScene::onStart()
+{
+	MenuScene::onStart();
+
+	//    ,    
+	if (!std::exchange(restoreChecked, true))
+		WindowHandler::instance().post([]() { GameScene::restoreGame(); });
+}
+
 void MainMenuScene::onSizeChanged(core::Point size)
 {
 	constexpr Point titleSize{ 580, 130 };
@@ -15,6 +15,11 @@ public:
 		return s;
 	}
 
+	/// <summary>
+	///      :      
+	/// </summary>
+	void onStart() override;
+
 	/// <summary>
 	///      
 	/// </summary>
@@ -48,4 +53,9 @@ private:
 	chess::Side side;
 	bool stretch;
 	bool isFullScreen;
+
+	/// <summary>
+	///        
+	/// </summary>
+	bool restoreChecked = false;
 };
@@ -11,6 +11,8 @@ enum Button : int
 {
 	Back = 0,
 	ShowValidMoves,
+	PlayComputer,
+	ShowAnalysis,
 	IsResizeable,
 
 	BtnCount,
@@ -27,6 +29,10 @@ OptionsScene::OptionsScene()
 			ButtonData::makeNormal("Back"),
 			ButtonData::makeRadio("Show valid moves",
 								  GameScene::getShowingValidMoves),
+			ButtonData::makeRadio("Play vs computer",
+								  GameScene::getPlayingComputer),
+			ButtonData::makeRadio("Analysis mode",
+								  GameScene::getShowingAnalysis),
 			ButtonData::makeRadio("Is Resizeable", getIsResizeable),
 		}, Mode::Vertical), rects(2)
 {}
@@ -70,6 +76,14 @@ void OptionsScene::onButtonSelected(int index)
 			GameScene::toggleShowingValidMoves();
 			redraw();
 			break;
+		case Button::PlayComputer:
+			GameScene::togglePlayingComputer();
+			redraw();
+			break;
+		case Button::ShowAnalysis:
+			GameScene::toggleShowingAnalysis();
+			redraw();
+			break;
 		case Button::IsResizeable:
 		{
 			auto& wh = WindowHandler::instance();
@@ -1,9 +1,121 @@
 #include "Board.h"
 
+#include "Journal.h"
 #include "Piece.h"
 
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
 namespace chess
 {
+	namespace
+	{
+		/// <summary>
+		///    ( little-endian ).  :   ( 3 , 0 -  ),
+		///  (  3 ),    (  4 ).   -  .
+		///   : moveCount  ( MoveJournal::pack, 2  ),  repetitionCount 
+		/// (   - 1 ,   - 1 ,   FEN )
+		/// </summary>
+		struct SnapshotHeader
+		{
+			char     magic[4];
+			uint16_t version;
+			uint16_t moveCount;
+			uint8_t  squares[64];
+			uint16_t halfMoveClock;
+			uint16_t moveCounter;
+			uint8_t  side;
+			uint8_t  passing;
+			uint8_t  inCheck;
+			uint8_t  reserved;
+			uint8_t  eatenCount[2];
+			uint16_t repetitionCount;
+			uint8_t  eaten[2][16];
+			uint32_t repetitionBytes;
+		};
+		static_assert(sizeof(SnapshotHeader) == 120);
+
+		constexpr char     SnapshotMagic[4] = { 'C', 'B', 'R', 'D' };
+		constexpr uint16_t SnapshotVersion  = 1;
+		constexpr uint8_t  NoPassing        = 0xFF;
+
+		constexpr std::string_view PieceLetters = " PNBRQK";
+
+		uint8_t pieceCode(const Piece& p)
+		{
+			return uint8_t(PieceLetters.find(char(toupper(p.getLetter()))));
+		}
+
+		std::unique_ptr<Piece> makePiece(uint8_t code, Side side)
+		{
+			switch (code)
+			{
+				case 1: return std::make_unique<Pawn>(side);
+				case 2: return std::make_unique<Knight>(side);
+				case 3: return std::make_unique<Bishop>(side);
+				case 4: return std::make_unique<Rook>(side);
+				case 5: return std::make_unique<Queen>(side);
+				case 6: return std::make_unique<King>(side);
+			}
+			return nullptr;
+		}
+
+		/// <summary>
+		///       :   ,     
+		/// [    ,      ]
+		/// </summary>
+		struct Material
+		{
+			uint64_t pawns[2] = {};
+			uint8_t counts[2][7] = {};
+
+			void add(char letter, int square)
+			{
+				int side = letter >= 'a' ? 1 : 0;
+				auto code = PieceLetters.find(char(side ? letter - 'a' + 'A' : letter));
+				if (code == std::string_view::npos)
+					return;
+				++counts[side][code];
+				if (code == 1)
+					pawns[side] |= uint64_t(1) << square;
+			}
+
+			/// <summary>
+			///     FEN (    )
+			/// </summary>
+			static Material fromFen(std::string_view fen)
+			{
+				Material m;
+				int x = 0, y = 7;
+				for (char c : fen)
+				{
+					if (c == ' ')
+						break;
+					if (c == '/')
+					{
+						x = 0;
+						--y;
+					}
+					else if (c >= '1' && c <= '8')
+					{
+						x += c - '0';
+					}
+					else
+					{
+						m.add(c, y * 8 + x++);
+					}
+				}
+				return m;
+			}
+
+			bool operator==(const Material& o) const
+			{
+				return std::memcmp(this, &o, sizeof(Material)) == 0;
+			}
+		};
+	}
+
 	template <class T>
 	void addBoth(Board* p, int x)
 	{
@@ -16,6 +128,8 @@ namespace chess
 		pieces = {};
 		for (auto& vec : eatenPieces)
 			vec.clear();
+		moveHistory.clear();
+		boardHistory.clear();
 		state.reset();
 
 		for (int i = 0; i < 8; ++i)
@@ -51,18 +165,22 @@ namespace chess
 	void Board::finishMove(FullMove move)
 	{
 		state.update(pieces);
+		bool finished = false;
 
 		for (auto side : { Side::White, Side::Black })
 		{
-			if (!state.isInCheck[side]) continue;
+			//     ,   ,   
+			if (!state.isInCheck[side] && side == state.currentSide) continue;
 			auto res = state.testWinOrStalemate(side);
 
 			switch (res)
 			{
 				case GameResult::Win:
+					finished = true;
 					checkmateCallback(move, getOtherSide(side));
 					break;
 				case GameResult::Stalemate:
+					finished = true;
 					stalemateCallback(move, side);
 					break;
 				default:
@@ -71,16 +189,40 @@ namespace chess
 		}
 		std::clog << state << "\n";
 
-		if (state.halfMoveClock >= 100) drawCallback(move, " 50- "); // 50 moves = 100 half-moves
+		if (state.halfMoveClock >= 100) // 50 moves = 100 half-moves
+		{
+			finished = true;
+			drawCallback(move, " 50- ");
+		}
 
 		auto count = ++boardHistory[state.getShortenedFEN()];
 
 		if (count == 3)
 		{
+			finished = true;
 			drawCallback(move, " ");
 		}
 		moveHistory.push_back(move);
 		state.incrementHalfMove();
+		if (journal)
+			journal->append(move);
+
+		//    -    
+		if (!finished && adjudicationCallback)
+		{
+			auto whoWon = Side::White;
+			switch (adjudicationCallback(state, whoWon))
+			{
+				case GameResult::Win:
+					checkmateCallback(move, whoWon);
+					break;
+				case GameResult::Draw:
+					drawCallback(move, " ");
+					break;
+				default:
+					break;
+			}
+		}
 	}
 
 	void Board::eatAt(Pos p)
@@ -196,6 +338,7 @@ namespace chess
 			case Move::Type::Passing:
 			{
 				eatAt(state.passingTarget);
+				state.passingTarget = Pos::Invalid;
 			} break;
 			case Move::Type::Promotion:
 				promotionMove = move;
@@ -223,4 +366,177 @@ namespace chess
 
 		return true;
 	}
+
+	size_t Board::getSerializedSize() const
+	{
+		Material current;
+		for (int i = 0; i < 64; ++i)
+		{
+			if (pieces[i])
+				current.add(pieces[i]->getLetter(), i);
+		}
+
+		size_t size = sizeof(SnapshotHeader) + moveHistory.size() * 2;
+		for (auto& [fen, count] : boardHistory)
+		{
+			if (fen.size() <= 255 && Material::fromFen(fen) == current)
+				size += 2 + fen.size();
+		}
+		return size;
+	}
+
+	size_t Board::serialize(std::span<std::byte> buffer) const
+	{
+		if (buffer.size() < sizeof(SnapshotHeader) || moveHistory.size() > UINT16_MAX)
+			return 0;
+
+		SnapshotHeader h = {};
+		std::memcpy(h.magic, SnapshotMagic, 4);
+		h.version = SnapshotVersion;
+		h.moveCount = uint16_t(moveHistory.size());
+
+		Material current;
+		for (int i = 0; i < 64; ++i)
+		{
+			auto& p = pieces[i];
+			if (!p)
+				continue;
+			h.squares[i] = uint8_t(pieceCode(*p) | (p->getSide() == Side::Black ? 8 : 0) | (p->getMadeFirstMove() ? 16 : 0));
+			current.add(p->getLetter(), i);
+		}
+
+		h.halfMoveClock = uint16_t(state.halfMoveClock);
+		h.moveCounter = uint16_t(state.moveCounter);
+		h.side = uint8_t(state.currentSide);
+		h.passing = state.passingTarget.isValid() ? uint8_t(state.passingTarget.y() * 8 + state.passingTarget.x()) : NoPassing;
+		h.inCheck = uint8_t((state.isInCheck[Side::White] ? 1 : 0) | (state.isInCheck[Side::Black] ? 2 : 0));
+		for (auto side : { Side::White, Side::Black })
+		{
+			auto& eaten = eatenPieces[side];
+			h.eatenCount[int(side)] = uint8_t(std::min<size_t>(eaten.size(), 16));
+			for (size_t i = 0; i < h.eatenCount[int(side)]; ++i)
+				h.eaten[int(side)][i] = pieceCode(*eaten[i]);
+		}
+
+		// 
+		auto out = buffer.data() + sizeof(SnapshotHeader);
+		auto end = buffer.data() + buffer.size();
+		if (size_t(end - out) < moveHistory.size() * 2)
+			return 0;
+		for (auto m : moveHistory)
+		{
+			auto packed = MoveJournal::pack(m);
+			std::memcpy(out, &packed, 2);
+			out += 2;
+		}
+
+		//        :    
+		auto repetitionStart = out;
+		for (auto& [fen, count] : boardHistory)
+		{
+			if (fen.size() > 255 || !(Material::fromFen(fen) == current))
+				continue;
+			if (size_t(end - out) < 2 + fen.size())
+				return 0;
+			*out++ = std::byte(std::min(count, 255));
+			*out++ = std::byte(fen.size());
+			std::memcpy(out, fen.data(), fen.size());
+			out += fen.size();
+			++h.repetitionCount;
+		}
+		h.repetitionBytes = uint32_t(out - repetitionStart);
+
+		std::memcpy(buffer.data(), &h, sizeof(h));
+		return size_t(out - buffer.data());
+	}
+
+	void Board::deserialize(std::span<const std::byte> data)
+	{
+		auto invalid = [](const char* what) { return std::invalid_argument(core::concat("board snapshot: ", what)); };
+
+		SnapshotHeader h;
+		if (data.size() < sizeof(h))
+			throw invalid("too short");
+		std::memcpy(&h, data.data(), sizeof(h));
+		if (std::memcmp(h.magic, SnapshotMagic, 4) != 0 || h.version != SnapshotVersion)
+			throw invalid("unknown format");
+		if (data.size() != sizeof(h) + h.moveCount * size_t(2) + h.repetitionBytes)
+			throw invalid("size mismatch");
+		if (h.side > 1 || h.eatenCount[0] > 16 || h.eatenCount[1] > 16 || (h.passing != NoPassing && h.passing >= 64))
+			throw invalid("bad header");
+
+		//      :     
+		std::array<std::unique_ptr<Piece>, 64> newPieces;
+		SideEntries<Pos> kings;
+		kings[Side::White] = kings[Side::Black] = Pos::Invalid;
+		for (int i = 0; i < 64; ++i)
+		{
+			uint8_t sq = h.squares[i];
+			if (sq == 0)
+				continue;
+			auto side = (sq & 8) ? Side::Black : Side::White;
+			newPieces[i] = makePiece(sq & 7, side);
+			if (!newPieces[i] || (sq & ~0x1F) != 0)
+				throw invalid("bad square");
+			if (sq & 16)
+				newPieces[i]->onMoved();
+			if ((sq & 7) == 6)
+				kings[side] = { i % 8, i / 8 };
+		}
+		if (!kings[Side::White].isValid() || !kings[Side::Black].isValid())
+			throw invalid("missing king");
+
+		SideEntries<std::vector<std::unique_ptr<Piece>>> newEaten;
+		for (auto side : { Side::White, Side::Black })
+		{
+			for (int i = 0; i < h.eatenCount[int(side)]; ++i)
+			{
+				auto p = makePiece(h.eaten[int(side)][i], side);
+				if (!p)
+					throw invalid("bad eaten piece");
+				newEaten[side].push_back(std::move(p));
+			}
+		}
+
+		auto in = data.data() + sizeof(h);
+		std::vector<FullMove> newHistory(h.moveCount);
+		for (auto& m : newHistory)
+		{
+			uint16_t packed;
+			std::memcpy(&packed, in, 2);
+			in += 2;
+			m = MoveJournal::unpack(packed);
+		}
+
+		std::map<std::string, int> newBoardHistory;
+		auto end = data.data() + data.size();
+		for (int i = 0; i < h.repetitionCount; ++i)
+		{
+			if (end - in < 2 || end - in < 2 + std::to_integer<int>(in[1]))
+				throw invalid("bad repetition table");
+			int count = std::to_integer<int>(in[0]);
+			size_t length = std::to_integer<size_t>(in[1]);
+			newBoardHistory.emplace(std::string(reinterpret_cast<const char*>(in + 2), length), count);
+			in += 2 + length;
+		}
+		if (in != end)
+			throw invalid("bad repetition table");
+
+		pieces = std::move(newPieces);
+		eatenPieces = std::move(newEaten);
+		moveHistory = std::move(newHistory);
+		boardHistory = std::move(newBoardHistory);
+		promotionMove = {};
+
+		//       :   BoardState::update()  
+		for (int i = 0; i < 64; ++i)
+			state.val[i] = pieces[i].get();
+		state.kingPos = kings;
+		state.isInCheck[Side::White] = (h.inCheck & 1) != 0;
+		state.isInCheck[Side::Black] = (h.inCheck & 2) != 0;
+		state.halfMoveClock = h.halfMoveClock;
+		state.moveCounter = h.moveCounter;
+		state.currentSide = Side(h.side);
+		state.passingTarget = h.passing == NoPassing ? Pos::Invalid : Pos{ h.passing % 8, h.passing / 8 };
+	}
 }
@@ -4,13 +4,17 @@
 #include "Piece.h"
 #include "BoardState.h"
 
+#include <cstddef>
 #include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 #include <map>
 
 namespace chess
 {
 	class Piece;
+	class MoveJournal;
 
 	/// <summary>
 	///  
@@ -24,6 +28,12 @@ namespace chess
 		using DrawCallback = void(*)(FullMove, std::string_view why);
 		using MoveExecutedCallback = void(*)(FullMove);
 
+		/// <summary>
+		///    ( ,    ) :
+		/// Win -   whoWon, Draw - , Continue -  
+		/// </summary>
+		using AdjudicationCallback = GameResult(*)(const BoardState&, Side& whoWon);
+
 		/// <summary>
 		///        
 		/// </summary>
@@ -46,6 +56,18 @@ namespace chess
 		/// </summary>
 		void reset();
 
+		/// <summary>
+		///       
+		/// </summary>
+		/// <param name="callback">[   null ]     </param>
+		void setAdjudicationCallback(AdjudicationCallback callback) { adjudicationCallback = callback; }
+
+		/// <summary>
+		///  ,      
+		/// </summary>
+		/// <param name="val">[   null ]  </param>
+		void setJournal(MoveJournal* val) { journal = val; }
+
 		/// <summary>
 		///       
 		/// </summary>
@@ -139,6 +161,29 @@ namespace chess
 			return eatenPieces[side];
 		}
 
+		/// <summary>
+		///     ( serialize() )
+		/// </summary>
+		/// <returns> </returns>
+		size_t getSerializedSize() const;
+
+		/// <summary>
+		///     :    (     ,
+		/// ,   , ,   ),     2 
+		///  ,     (     )
+		/// </summary>
+		/// <param name="buffer">   getSerializedSize() </param>
+		/// <returns>   [ 0 -    ]</returns>
+		size_t serialize(std::span<std::byte> buffer) const;
+
+		/// <summary>
+		///     serialize()   
+		/// [        ]
+		/// </summary>
+		/// <param name="data"> </param>
+		/// <exception cref="std::invalid_argument">  [    ]</exception>
+		void deserialize(std::span<const std::byte> data);
+
 	private:
 		std::array<std::unique_ptr<Piece>, 64> pieces;
 		BoardState state;
@@ -163,6 +208,8 @@ namespace chess
 		CheckmateCallback checkmateCallback;
 		StalemateCallback stalemateCallback;
 		DrawCallback      drawCallback;
+		AdjudicationCallback adjudicationCallback = nullptr;
+		MoveJournal* journal = nullptr;
 
 		/// <summary>
 		///     [     ]
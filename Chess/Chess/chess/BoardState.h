@@ -5,6 +5,7 @@
 #include "Piece.h"
 
 #include <array>
+#include <memory>
 
 namespace chess
 {
@@ -111,6 +112,24 @@ namespace chess
 			return passingTarget;
 		}
 
+		/// <summary>
+		///  ,   
+		/// </summary>
+		/// <returns> </returns>
+		constexpr Side getCurrentSide() const { return currentSide; }
+
+		/// <summary>
+		///      "50- "
+		/// </summary>
+		/// <returns> </returns>
+		constexpr int getHalfMoveClock() const { return halfMoveClock; }
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <returns> </returns>
+		constexpr int getMoveCounter() const { return moveCounter; }
+
 	private:
 		std::array<const Piece*, 64> val;
 		SideEntries<bool> isInCheck;
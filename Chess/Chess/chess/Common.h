@@ -3,6 +3,7 @@
 #include "../core/Utils.h"
 
 #include <array>
+#include <string_view>
 
 namespace chess
 {
@@ -124,6 +125,36 @@ namespace chess
 			p[4] = (char)promotionResult;
 		};
 
+		/// <summary>
+		///   ,  writeStringAt() ( "e2e4", "e7e8q" )
+		/// </summary>
+		/// <param name="s"> </param>
+		/// <returns>  [ from == Pos::Invalid -    ]</returns>
+		static constexpr FullMove fromString(std::string_view s)
+		{
+			if (s.size() < 4 || s.size() > 5)
+				return {};
+
+			Pos from = { s[0] - 'a', s[1] - '1' };
+			Pos to   = { s[2] - 'a', s[3] - '1' };
+			if (!from.isValid() || !to.isValid())
+				return {};
+
+			auto promotion = PromotionResult::None;
+			if (s.size() == 5)
+			{
+				switch (s[4])
+				{
+					case 'n': case 'N': promotion = PromotionResult::Knight; break;
+					case 'b': case 'B': promotion = PromotionResult::Bishop; break;
+					case 'r': case 'R': promotion = PromotionResult::Rook;   break;
+					case 'q': case 'Q': promotion = PromotionResult::Queen;  break;
+					default: return {};
+				}
+			}
+			return { from, to, promotion };
+		}
+
 		/// <summary>
 		///       writeStringAt()
 		/// </summary>
@@ -0,0 +1,190 @@
+#include "Journal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace chess
+{
+	namespace
+	{
+		constexpr char     Magic[4] = { 'C', 'J', 'R', 'N' };
+		constexpr uint16_t Version  = 1;
+		constexpr size_t   HeaderSize = 8;
+
+		/// <summary>
+		///       :      
+		/// </summary>
+		constexpr auto WakeInterval = std::chrono::milliseconds(50);
+
+		constexpr PromotionResult Promotions[] = {
+			PromotionResult::None, PromotionResult::Knight, PromotionResult::Bishop,
+			PromotionResult::Rook, PromotionResult::Queen,
+		};
+	}
+
+	uint16_t MoveJournal::pack(FullMove move)
+	{
+		int promotion = 0;
+		while (promotion < 4 && Promotions[promotion] != move.promotionResult)
+			++promotion;
+		int from = move.from.y() * 8 + move.from.x();
+		int to = move.to.y() * 8 + move.to.x();
+		return uint16_t(from | (to << 6) | (promotion << 12));
+	}
+
+	FullMove MoveJournal::unpack(uint16_t packed)
+	{
+		int from = packed & 63, to = (packed >> 6) & 63, promotion = packed >> 12;
+		if (promotion > 4)
+			return {};
+		return { { from % 8, from / 8 }, { to % 8, to / 8 }, Promotions[promotion] };
+	}
+
+	uint16_t MoveJournal::checksum(uint16_t previous, uint16_t packed)
+	{
+		uint32_t h = (previous * 0x9E3779B1u) ^ ((packed + 1u) * 0x85EBCA77u);
+		h ^= h >> 15;
+		h *= 0xC2B2AE3Du;
+		return uint16_t(h >> 16);
+	}
+
+	MoveJournal::MoveJournal(std::string path) : path(std::move(path))
+	{
+		writer = std::thread([this]() { writerLoop(); });
+	}
+
+	MoveJournal::~MoveJournal()
+	{
+		stopping = true;
+		wake.notify_one();
+		writer.join();
+	}
+
+	void MoveJournal::begin(uint16_t flags) { push({ Command::Kind::Begin, flags }); }
+	void MoveJournal::append(FullMove move) { push({ Command::Kind::Move, pack(move) }); }
+	void MoveJournal::clear()               { push({ Command::Kind::Clear, 0 }); }
+
+	void MoveJournal::push(Command command)
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+
+		//          
+		while (h - tail.load(std::memory_order_acquire) >= QueueSize)
+			std::this_thread::yield();
+
+		queue[h % QueueSize] = command;
+		head.store(h + 1, std::memory_order_release);
+		wake.notify_one();
+	}
+
+	void MoveJournal::writerLoop()
+	{
+		std::FILE* file = nullptr;
+		uint16_t sum = 0;
+		std::vector<unsigned char> batch;
+
+		while (true)
+		{
+			{
+				std::unique_lock lock(wakeLock);
+				wake.wait_for(lock, WakeInterval, [this]()
+				{
+					return stopping || head.load(std::memory_order_acquire) != tail.load(std::memory_order_relaxed);
+				});
+			}
+			bool stop = stopping;
+
+			//   -  
+			batch.clear();
+			size_t t = tail.load(std::memory_order_relaxed), h = head.load(std::memory_order_acquire);
+			for (; t != h; ++t)
+			{
+				auto command = queue[t % QueueSize];
+				switch (command.kind)
+				{
+					case Command::Kind::Move:
+					{
+						if (!file)
+							break;
+						sum = checksum(sum, command.value);
+						uint32_t record = command.value | (uint32_t(sum) << 16);
+						unsigned char bytes[4];
+						std::memcpy(bytes, &record, 4);
+						batch.insert(batch.end(), bytes, bytes + 4);
+						break;
+					}
+					case Command::Kind::Begin:
+					case Command::Kind::Clear:
+					{
+						if (file)
+						{
+							std::fwrite(batch.data(), 1, batch.size(), file);
+							std::fclose(file);
+						}
+						batch.clear();
+						file = std::fopen(path.c_str(), "wb");
+						if (file && command.kind == Command::Kind::Begin)
+						{
+							uint16_t header[2] = { Version, command.value };
+							batch.insert(batch.end(), Magic, Magic + 4);
+							batch.insert(batch.end(), reinterpret_cast<unsigned char*>(header),
+								         reinterpret_cast<unsigned char*>(header) + sizeof(header));
+							sum = checksum(0, command.value);
+						}
+						else if (file)
+						{
+							std::fclose(file);
+							file = nullptr;
+						}
+						break;
+					}
+				}
+			}
+			tail.store(t, std::memory_order_release);
+
+			if (file && !batch.empty())
+			{
+				std::fwrite(batch.data(), 1, batch.size(), file);
+				std::fflush(file);
+			}
+			if (stop && t == head.load(std::memory_order_acquire))
+				break;
+		}
+		if (file)
+			std::fclose(file);
+	}
+
+	std::optional<MoveJournal::SavedGame> MoveJournal::load(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::vector<char> data{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+		if (data.size() < HeaderSize || std::memcmp(data.data(), Magic, 4) != 0)
+			return std::nullopt;
+
+		uint16_t header[2];
+		std::memcpy(header, data.data() + 4, sizeof(header));
+		if (header[0] != Version)
+			return std::nullopt;
+
+		SavedGame game;
+		game.flags = header[1];
+		uint16_t sum = checksum(0, game.flags);
+		for (size_t i = HeaderSize; i + 4 <= data.size(); i += 4)
+		{
+			uint32_t record;
+			std::memcpy(&record, data.data() + i, 4);
+			uint16_t packed = uint16_t(record), stored = uint16_t(record >> 16);
+			sum = checksum(sum, packed);
+			auto move = unpack(packed);
+			if (stored != sum || !move.from.isValid())
+				break;
+			game.moves.push_back(move);
+		}
+		if (game.moves.empty())
+			return std::nullopt;
+		return game;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Common.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chess
+{
+	/// <summary>
+	///         .
+	///  :  ( "CJRN", ,   ),  4    -
+	///   ( 16  )    ( 16  ),     .
+	///    -     :        
+	/// </summary>
+	class MoveJournal
+	{
+	public:
+		/// <summary>
+		/// ,   
+		/// </summary>
+		struct SavedGame
+		{
+			uint16_t flags = 0;
+			std::vector<FullMove> moves;
+		};
+
+		/// <summary>
+		///   .       begin()
+		/// </summary>
+		/// <param name="path">   </param>
+		explicit MoveJournal(std::string path);
+
+		/// <summary>
+		///       
+		/// </summary>
+		~MoveJournal();
+
+		MoveJournal(const MoveJournal&) = delete;
+		MoveJournal& operator=(const MoveJournal&) = delete;
+
+		/// <summary>
+		///    :   
+		/// </summary>
+		/// <param name="flags">    (    )</param>
+		void begin(uint16_t flags);
+
+		/// <summary>
+		///    [       ]
+		/// </summary>
+		/// <param name="move"> </param>
+		void append(FullMove move);
+
+		/// <summary>
+		///   :  ,  
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		///  .        (   )
+		/// </summary>
+		/// <param name="path">   </param>
+		/// <returns> [ nullopt -       ]</returns>
+		static std::optional<SavedGame> load(const std::string& path);
+
+		/// <summary>
+		///    16  :  ( 6  ),  ( 6  ),  ( 3  )
+		/// </summary>
+		static uint16_t pack(FullMove move);
+		static FullMove unpack(uint16_t packed);
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="previous">   [    -   ]</param>
+		/// <param name="packed"> </param>
+		static uint16_t checksum(uint16_t previous, uint16_t packed);
+
+	private:
+		/// <summary>
+		///    :     
+		/// </summary>
+		struct Command
+		{
+			enum class Kind : uint16_t { Move, Begin, Clear };
+			Kind kind;
+			uint16_t value;
+		};
+
+		static constexpr size_t QueueSize = 4096;
+
+		std::string path;
+
+		/// <summary>
+		///      (   )    (   )
+		/// </summary>
+		std::array<Command, QueueSize> queue;
+		std::atomic<size_t> head = 0;
+		std::atomic<size_t> tail = 0;
+
+		std::mutex wakeLock;
+		std::condition_variable wake;
+		std::atomic<bool> stopping = false;
+		std::thread writer;
+
+		void push(Command command);
+		void writerLoop();
+	};
+}
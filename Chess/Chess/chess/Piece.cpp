@@ -190,7 +190,7 @@ namespace chess
 			if (!pos.isValid())
 				continue;
 			auto* ptr = validMovesH.b.at(pos);
-			if (ptr == nullptr || ptr->getSide() == getSide())
+			if (ptr != nullptr && ptr->getSide() != getSide())
 				if (validMovesH.b.getPassingTarget() == pos)
 				{
 					validMovesH.add(myPos + Pos(i, sgn), Move::Type::Passing); //        
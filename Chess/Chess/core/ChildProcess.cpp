@@ -0,0 +1,254 @@
+#include "ChildProcess.h"
+
+#ifdef _WIN32
+#include "Utils.h"
+
+#include <vector>
+#else
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace core
+{
+#ifdef _WIN32
+	ChildProcess::ChildProcess(const std::string& commandLine)
+	{
+		SECURITY_ATTRIBUTES sa = { sizeof(sa), nullptr, TRUE };
+		HANDLE childInput = nullptr, childOutput = nullptr;
+
+		//    ,  
+		if (!::CreatePipe(&childInput, &toChild, &sa, 0))
+			throw WinapiError("CreatePipe");
+		if (!::CreatePipe(&fromChild, &childOutput, &sa, 0))
+		{
+			::CloseHandle(childInput);
+			::CloseHandle(toChild);
+			throw WinapiError("CreatePipe");
+		}
+		::SetHandleInformation(toChild, HANDLE_FLAG_INHERIT, 0);
+		::SetHandleInformation(fromChild, HANDLE_FLAG_INHERIT, 0);
+
+		STARTUPINFOA si = {};
+		si.cb = sizeof(si);
+		si.dwFlags = STARTF_USESTDHANDLES;
+		si.hStdInput = childInput;
+		si.hStdOutput = childOutput;
+		si.hStdError = childOutput;
+
+		// CreateProcess    
+		std::vector<char> cmd(commandLine.begin(), commandLine.end());
+		cmd.push_back('\0');
+
+		PROCESS_INFORMATION pi = {};
+		BOOL ok = ::CreateProcessA(nullptr, cmd.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+			                       nullptr, nullptr, &si, &pi);
+		::CloseHandle(childInput);
+		::CloseHandle(childOutput);
+		if (!ok)
+		{
+			::CloseHandle(toChild);
+			::CloseHandle(fromChild);
+			throw WinapiError(concat("CreateProcess ", commandLine));
+		}
+		::CloseHandle(pi.hThread);
+		process = pi.hProcess;
+	}
+
+	bool ChildProcess::write(std::string_view data)
+	{
+		std::lock_guard lock(writeMutex);
+		while (!data.empty() && toChild != nullptr)
+		{
+			DWORD written = 0;
+			if (!::WriteFile(toChild, data.data(), DWORD(data.size()), &written, nullptr))
+				return false;
+			data.remove_prefix(written);
+		}
+		return data.empty();
+	}
+
+	bool ChildProcess::readLine(std::string& line)
+	{
+		for (;;)
+		{
+			if (auto end = buffer.find('\n'); end != std::string::npos)
+			{
+				line.assign(buffer, 0, end);
+				buffer.erase(0, end + 1);
+				if (!line.empty() && line.back() == '\r')
+					line.pop_back();
+				return true;
+			}
+
+			char chunk[4096];
+			DWORD n = 0;
+			if (!::ReadFile(fromChild, chunk, sizeof(chunk), &n, nullptr) || n == 0)
+				return false;
+			buffer.append(chunk, n);
+		}
+	}
+
+	void ChildProcess::closeInput() noexcept
+	{
+		std::lock_guard lock(writeMutex);
+		if (toChild != nullptr)
+		{
+			::CloseHandle(toChild);
+			toChild = nullptr;
+		}
+	}
+
+	bool ChildProcess::wait(int timeoutMs) noexcept
+	{
+		return ::WaitForSingleObject(process, DWORD(timeoutMs)) == WAIT_OBJECT_0;
+	}
+
+	void ChildProcess::kill() noexcept
+	{
+		::TerminateProcess(process, 1);
+		::WaitForSingleObject(process, INFINITE);
+	}
+
+	ChildProcess::~ChildProcess() noexcept
+	{
+		closeInput();
+		if (!wait(2000))
+			kill();
+		::CloseHandle(fromChild);
+		::CloseHandle(process);
+	}
+#else
+	ChildProcess::ChildProcess(const std::string& commandLine)
+	{
+		//        ,    
+		std::signal(SIGPIPE, SIG_IGN);
+
+		int in[2], out[2];
+		if (::pipe(in) != 0)
+			throw std::runtime_error(std::string("pipe: ") + std::strerror(errno));
+		if (::pipe(out) != 0)
+		{
+			::close(in[0]);
+			::close(in[1]);
+			throw std::runtime_error(std::string("pipe: ") + std::strerror(errno));
+		}
+
+		// exec -     ,    (  kill()     ).
+		//    fork :        
+		auto cmd = "exec " + commandLine;
+
+		pid = ::fork();
+		if (pid < 0)
+		{
+			for (int fd : { in[0], in[1], out[0], out[1] })
+				::close(fd);
+			throw std::runtime_error(std::string("fork: ") + std::strerror(errno));
+		}
+		if (pid == 0)
+		{
+			::dup2(in[0], STDIN_FILENO);
+			::dup2(out[1], STDOUT_FILENO);
+			for (int fd : { in[0], in[1], out[0], out[1] })
+				::close(fd);
+			::execl("/bin/sh", "sh", "-c", cmd.c_str(), (char*)nullptr);
+			::_exit(127);
+		}
+
+		::close(in[0]);
+		::close(out[1]);
+		toChild = in[1];
+		fromChild = out[0];
+		::fcntl(toChild, F_SETFD, FD_CLOEXEC);
+		::fcntl(fromChild, F_SETFD, FD_CLOEXEC);
+	}
+
+	bool ChildProcess::write(std::string_view data)
+	{
+		std::lock_guard lock(writeMutex);
+		while (!data.empty() && toChild >= 0)
+		{
+			auto n = ::write(toChild, data.data(), data.size());
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			data.remove_prefix(size_t(n));
+		}
+		return data.empty();
+	}
+
+	bool ChildProcess::readLine(std::string& line)
+	{
+		for (;;)
+		{
+			if (auto end = buffer.find('\n'); end != std::string::npos)
+			{
+				line.assign(buffer, 0, end);
+				buffer.erase(0, end + 1);
+				if (!line.empty() && line.back() == '\r')
+					line.pop_back();
+				return true;
+			}
+
+			char chunk[4096];
+			auto n = ::read(fromChild, chunk, sizeof(chunk));
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			buffer.append(chunk, size_t(n));
+		}
+	}
+
+	void ChildProcess::closeInput() noexcept
+	{
+		std::lock_guard lock(writeMutex);
+		if (toChild >= 0)
+		{
+			::close(toChild);
+			toChild = -1;
+		}
+	}
+
+	bool ChildProcess::wait(int timeoutMs) noexcept
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+		while (!exited)
+		{
+			if (::waitpid(pid, nullptr, WNOHANG) == pid)
+				exited = true;
+			else if (std::chrono::steady_clock::now() >= deadline)
+				return false;
+			else
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return true;
+	}
+
+	void ChildProcess::kill() noexcept
+	{
+		if (exited)
+			return;
+		::kill(pid, SIGKILL);
+		::waitpid(pid, nullptr, 0);
+		exited = true;
+	}
+
+	ChildProcess::~ChildProcess() noexcept
+	{
+		closeInput();
+		if (!wait(2000))
+			kill();
+		::close(fromChild);
+	}
+#endif
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace core
+{
+	/// <summary>
+	///         
+	/// [ Windows - CreateProcess,   - fork  exec  /bin/sh ]
+	/// </summary>
+	class ChildProcess
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="commandLine">    </param>
+		explicit ChildProcess(const std::string& commandLine);
+
+		ChildProcess(const ChildProcess&)            = delete;
+		ChildProcess& operator=(const ChildProcess&) = delete;
+
+		/// <summary>
+		///       ,   
+		/// </summary>
+		~ChildProcess() noexcept;
+
+		/// <summary>
+		///     (      )
+		/// </summary>
+		/// <param name="data"></param>
+		/// <returns>false -      </returns>
+		bool write(std::string_view data);
+
+		/// <summary>
+		///     .    ,
+		///       (    )
+		/// </summary>
+		/// <param name="line">   </param>
+		/// <returns>false -   </returns>
+		bool readLine(std::string& line);
+
+		/// <summary>
+		///    (     )
+		/// </summary>
+		void closeInput() noexcept;
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="timeoutMs">  </param>
+		/// <returns>true -   </returns>
+		bool wait(int timeoutMs) noexcept;
+
+		/// <summary>
+		///   
+		/// </summary>
+		void kill() noexcept;
+
+	private:
+#ifdef _WIN32
+		void* process   = nullptr;
+		void* toChild   = nullptr;
+		void* fromChild = nullptr;
+#else
+		int pid       = -1;
+		int toChild   = -1;
+		int fromChild = -1;
+		bool exited   = false;
+#endif
+		std::mutex writeMutex;
+
+		/// <summary>
+		/// ,      
+		/// </summary>
+		std::string buffer;
+	};
+}
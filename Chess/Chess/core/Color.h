@@ -27,7 +27,9 @@ namespace core
 			if (alpha == 0) alpha = 0xFF;
 		}
 
+#ifdef _WIN32
 		explicit operator COLORREF() { return RGB(r(), g(), b()); }
+#endif
 
 		constexpr Color withAlpha(uint8_t a) const
 		{
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include "Utils.h"
+#else
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core
+{
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& path)
+	{
+		HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw WinapiError(concat("CreateFile ", path));
+
+		LARGE_INTEGER fileSize;
+		if (!::GetFileSizeEx(file, &fileSize))
+		{
+			::CloseHandle(file);
+			throw WinapiError(concat("GetFileSizeEx ", path));
+		}
+		length = size_t(fileSize.QuadPart);
+		if (length == 0)
+		{
+			::CloseHandle(file);
+			return;
+		}
+
+		//     ,     
+		mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		::CloseHandle(file);
+		if (mapping == nullptr)
+			throw WinapiError(concat("CreateFileMapping ", path));
+
+		ptr = static_cast<const std::byte*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (ptr == nullptr)
+		{
+			::CloseHandle(mapping);
+			mapping = nullptr;
+			throw WinapiError(concat("MapViewOfFile ", path));
+		}
+	}
+
+	void MappedFile::close() noexcept
+	{
+		if (ptr != nullptr)
+			::UnmapViewOfFile(ptr);
+		if (mapping != nullptr)
+			::CloseHandle(mapping);
+	}
+#else
+	MappedFile::MappedFile(const std::string& path)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error("open " + path + ": " + std::strerror(errno));
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0)
+		{
+			::close(fd);
+			throw std::runtime_error("fstat " + path + ": " + std::strerror(errno));
+		}
+		length = size_t(st.st_size);
+		if (length == 0)
+		{
+			::close(fd);
+			return;
+		}
+
+		void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (p == MAP_FAILED)
+			throw std::runtime_error("mmap " + path + ": " + std::strerror(errno));
+		ptr = static_cast<const std::byte*>(p);
+	}
+
+	void MappedFile::close() noexcept
+	{
+		if (ptr != nullptr)
+			::munmap(const_cast<std::byte*>(ptr), length);
+	}
+#endif
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: ptr(other.ptr), length(other.length), mapping(other.mapping)
+	{
+		other.ptr = nullptr;
+		other.length = 0;
+		other.mapping = nullptr;
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			ptr = other.ptr;
+			length = other.length;
+			mapping = other.mapping;
+			other.ptr = nullptr;
+			other.length = 0;
+			other.mapping = nullptr;
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		close();
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace core
+{
+	/// <summary>
+	/// ,      
+	/// [ Windows - CreateFileMapping,   - mmap ]
+	/// </summary>
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="path">  </param>
+		explicit MappedFile(const std::string& path);
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		MappedFile(const MappedFile&)            = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile() noexcept;
+
+		const std::byte* data() const { return ptr; }
+		size_t           size() const { return length; }
+		bool             isOpen() const { return ptr != nullptr; }
+
+		/// <summary>
+		///     (   )
+		/// </summary>
+		/// <returns> </returns>
+		std::string_view view() const { return { reinterpret_cast<const char*>(ptr), length }; }
+
+	private:
+		const std::byte* ptr = nullptr;
+		size_t length = 0;
+
+		/// <summary>
+		///   [   Windows ]
+		/// </summary>
+		void* mapping = nullptr;
+
+		void close() noexcept;
+	};
+}
@@ -1,5 +1,6 @@
 #include "Paint.h"
 
+#include <cmath>
 #include <cstring>
 
 namespace core
@@ -263,6 +264,45 @@ namespace core
 		}
 	}
 
+	void Paint::drawArrow(Point from, Point to, int thickness, Color col)
+	{
+		double dx = to.x - from.x, dy = to.y - from.y;
+		double length = std::sqrt(dx * dx + dy * dy);
+		if (length < 1)
+			return;
+		dx /= length;
+		dy /= length;
+
+		double half = thickness / 2.0;
+		double headLength = std::min(thickness * 3.0, length);
+		double headHalf = thickness * 1.5;
+
+		int margin = int(headHalf) + 1;
+		int xMin = std::max(0, std::min(from.x, to.x) - margin);
+		int yMin = std::max(0, std::min(from.y, to.y) - margin);
+		int xMax = std::min(width() - 1, std::max(from.x, to.x) + margin);
+		int yMax = std::min(height() - 1, std::max(from.y, to.y) + margin);
+
+		//     ( along )   ( across )
+		for (int y = yMin; y <= yMax; ++y)
+		{
+			for (int x = xMin; x <= xMax; ++x)
+			{
+				double px = x + 0.5 - from.x, py = y + 0.5 - from.y;
+				double along = px * dx + py * dy;
+				double across = std::abs(px * dy - py * dx);
+				if (along < 0 || along > length)
+					continue;
+
+				double headStart = length - headLength;
+				bool inside = along < headStart ? across <= half
+					                            : across <= headHalf * (length - along) / headLength;
+				if (inside)
+					setPixelUnchecked(x, y, col);
+			}
+		}
+	}
+
 	void Paint::fillRect(int x0, int y0, int x1, int y1, Color col)
 	{
 		fillRect({ x0, y0, x1, y1 }, col);
@@ -119,6 +119,10 @@ namespace core
 		void fillPixelatedCircle(Point center, int radius, Color col,
 			int pixelSize);
 
+		// Arrow from one point to another: a shaft of the given thickness and a head
+		// three times as wide; every pixel is blended once, so translucent colors work
+		void drawArrow(Point from, Point to, int thickness, Color col);
+
 		void drawSprite(int x, int y,
 			const PaletteSprite& sprite,
 			const Palette& palette);
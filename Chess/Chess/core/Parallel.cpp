@@ -0,0 +1,129 @@
+#include "Parallel.h"
+
+#ifdef _WIN32
+#include "Utils.h"
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+	namespace
+	{
+		/// <summary>
+		///    [ begin, end ).     :     
+		/// </summary>
+		struct alignas(64) Range
+		{
+			std::mutex lock;
+			size_t begin = 0;
+			size_t end = 0;
+
+			size_t size()
+			{
+				std::lock_guard guard(lock);
+				return end - begin;
+			}
+		};
+	}
+
+	void parallelFor(size_t count, int threads, const std::function<void(size_t index, int thread)>& body)
+	{
+		threads = int(std::clamp<size_t>(size_t(std::max(threads, 1)), 1, std::max<size_t>(count, 1)));
+
+		auto ranges = std::make_unique<Range[]>(threads);
+		for (int t = 0; t < threads; ++t)
+		{
+			ranges[t].begin = count * t / threads;
+			ranges[t].end = count * (t + 1) / threads;
+		}
+
+		std::exception_ptr error;
+		std::mutex errorLock;
+
+		auto work = [&](int t)
+		{
+			auto& own = ranges[t];
+			while (true)
+			{
+				size_t index;
+				{
+					std::lock_guard guard(own.lock);
+					index = own.begin < own.end ? own.begin++ : count;
+				}
+
+				if (index == count)
+				{
+					//    :    
+					int victim = -1;
+					size_t longest = 0;
+					for (int v = 0; v < threads; ++v)
+					{
+						if (v == t)
+							continue;
+						if (size_t n = ranges[v].size(); n > longest)
+						{
+							longest = n;
+							victim = v;
+						}
+					}
+					if (victim < 0)
+						return;
+
+					size_t begin, end;
+					{
+						std::lock_guard guard(ranges[victim].lock);
+						auto& r = ranges[victim];
+						if (r.end - r.begin == 0)
+							continue;
+						end = r.end;
+						begin = r.end - (r.end - r.begin + 1) / 2;
+						r.end = begin;
+					}
+					std::lock_guard guard(own.lock);
+					own.begin = begin;
+					own.end = end;
+					continue;
+				}
+
+				try
+				{
+					body(index, t);
+				}
+				catch (...)
+				{
+					std::lock_guard guard(errorLock);
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> pool;
+		for (int t = 1; t < threads; ++t)
+			pool.emplace_back(work, t);
+		work(0);
+		for (auto& th : pool)
+			th.join();
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void lowerThreadPriority()
+	{
+#ifdef _WIN32
+		::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_IDLE);
+#else
+		//  Linux  nice     
+		::setpriority(PRIO_PROCESS, 0, 19);
+#endif
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace core
+{
+	/// <summary>
+	///   0 .. count - 1       :   
+	///         ,    
+	///      .      
+	/// </summary>
+	/// <param name="count"> </param>
+	/// <param name="threads"> </param>
+	/// <param name="body">      (     0 )</param>
+	void parallelFor(size_t count, int threads, const std::function<void(size_t index, int thread)>& body);
+
+	/// <summary>
+	///        :   ,
+	///     (  ) 
+	/// </summary>
+	void lowerThreadPriority();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace core
+{
+	/// <summary>
+	///     -  -   (   ) :
+	///       ,  - .      ,
+	///   ,     .      ,
+	///   ,        
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class TripleBuffer
+	{
+	public:
+		/// <summary>
+		///   :     publish() [  - ]
+		/// </summary>
+		/// <returns></returns>
+		T& back() { return buffers[backIndex]; }
+
+		/// <summary>
+		///     ;     
+		/// [  - ]
+		/// </summary>
+		void publish()
+		{
+			uint8_t old = shared.exchange(uint8_t(backIndex | Fresh), std::memory_order_acq_rel);
+			backIndex = old & IndexMask;
+		}
+
+		/// <summary>
+		///    [  - ]
+		/// </summary>
+		/// <returns>,     [ nullptr -     ]</returns>
+		const T* read()
+		{
+			if (shared.load(std::memory_order_relaxed) & Fresh)
+			{
+				uint8_t old = shared.exchange(frontIndex, std::memory_order_acq_rel);
+				frontIndex = old & IndexMask;
+				hasFront = true;
+			}
+			return hasFront ? &buffers[frontIndex] : nullptr;
+		}
+
+	private:
+		static constexpr uint8_t IndexMask = 3;
+		static constexpr uint8_t Fresh     = 4;
+
+		std::array<T, 3> buffers;
+
+		/// <summary>
+		///       .    :   
+		///      
+		/// </summary>
+		alignas(64) std::atomic<uint8_t> shared = 1;
+
+		alignas(64) uint8_t backIndex = 0;
+		alignas(64) uint8_t frontIndex = 2;
+		bool hasFront = false;
+	};
+}
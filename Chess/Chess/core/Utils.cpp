@@ -3,6 +3,7 @@
 #include <iostream>
 #include <sstream>
 
+#ifdef _WIN32
 namespace core
 {
 	std::string WinapiError::makeMessage(std::string_view str, DWORD& code,
@@ -29,3 +30,4 @@ namespace core
 		return ss.str();
 	}
 }
+#endif
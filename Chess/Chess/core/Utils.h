@@ -5,7 +5,9 @@
 #endif
 
 #include <stdint.h>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 #include <iostream>
 
@@ -47,6 +49,7 @@ namespace core
 		return val;
 	}
 
+#ifdef _WIN32
 	class WinapiError : public std::runtime_error
 	{
 		DWORD code_;
@@ -69,6 +72,7 @@ namespace core
 		::MessageBoxA(nullptr, msg, "Warning", MB_OK);
 	}
 	inline void warning(const std::string& msg) { warning(msg.c_str()); }
+#endif
 
 	constexpr void constexpr_assert(bool val, const char* msg)
 	{
@@ -173,7 +177,9 @@ namespace core
 		constexpr Rect(Point topLeft, Point botRight)
 			: Rect(topLeft.x, topLeft.y, botRight.x, botRight.y)
 		{}
+#ifdef _WIN32
 		constexpr Rect(RECT val) : Rect(val.left, val.top, val.right, val.bottom) {}
+#endif
 
 		static constexpr Rect fromMiddleAndSize(Point middle, Point size)
 		{
@@ -181,7 +187,9 @@ namespace core
 			return Rect(middle - halfSize, middle + halfSize);
 		}
 
+#ifdef _WIN32
 		constexpr operator RECT() const { return { left, top, right, bottom }; }
+#endif
 
 		constexpr int width() const { return right - left; }
 		constexpr int height() const { return bottom - top; }
@@ -233,6 +241,7 @@ namespace core
 		{
 			return p.x >= x0() && p.x <= x1() && p.y >= y0() && p.y <= y1();
 		}
+#ifdef _WIN32
 		static Rect getClientRect(HWND hWnd)
 		{
 			RECT r;
@@ -250,6 +259,7 @@ namespace core
 			}
 			new (this) Rect(val);
 		}
+#endif
 
 		friend std::ostream& operator<<(std::ostream& s, const Rect& r)
 		{
@@ -260,6 +270,7 @@ namespace core
 
 	constexpr Rect Point::asRect() const { return { {0, 0}, *this }; }
 
+#ifdef _WIN32
 	class WindowDC
 	{
 		HDC val;
@@ -278,4 +289,5 @@ namespace core
 		operator HDC() const { return val; }
 		~WindowDC() noexcept { ::ReleaseDC(hwnd, val); }
 	};
+#endif
 }
@@ -136,6 +136,28 @@ namespace core
 		::InvalidateRect(hwnd, nullptr, false /*erase*/);
 	}
 
+	void WindowHandler::post(std::function<void()> task)
+	{
+		{
+			std::lock_guard lock(postedMutex);
+			posted.push_back(std::move(task));
+		}
+		::PostMessageA(hwnd, WM_APP, 0, 0);
+	}
+
+	void WindowHandler::runPosted()
+	{
+		std::deque<std::function<void()>> tasks;
+		{
+			std::lock_guard lock(postedMutex);
+			tasks.swap(posted);
+		}
+		// WM_PAINT  ,    ,   
+		::UpdateWindow(hwnd);
+		for (auto& task : tasks)
+			task();
+	}
+
 	void WindowHandler::redrawBackground()
 	{
 		currentScene->onDrawBackground(background);
@@ -205,6 +227,9 @@ namespace core
 			case WM_RBUTTONUP:
 				scene().onRightMouseUp(instance().getMousePos(lParam));
 				return 0;
+			case WM_APP:
+				instance().runPosted();
+				return 0;
 			case WM_CLOSE:
 				instance().hasQuit = true;
 				::PostQuitMessage(0);
@@ -3,7 +3,10 @@
 #include "Color.h"
 #include "Paint.h"
 
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
 
 namespace core
 {
@@ -76,6 +79,13 @@ namespace core
 		/// </summary>
 		void quit();
 
+		/// <summary>
+		///         
+		/// [      ;     ]
+		/// </summary>
+		/// <param name="task"></param>
+		void post(std::function<void()> task);
+
 		/// <summary>
 		///  
 		/// </summary>
@@ -130,6 +140,14 @@ namespace core
 
 		bool hasQuit = false;
 
+		std::mutex postedMutex;
+		std::deque<std::function<void()>> posted;
+
+		/// <summary>
+		///    post() 
+		/// </summary>
+		void runPosted();
+
 		WindowHandler(const char* title, Scene& scene, Point size, HWND hwnd, const WindowDC& hdc);
 
 		static Scene& scene() { return *instance().currentScene; }
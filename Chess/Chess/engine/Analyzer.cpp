@@ -0,0 +1,84 @@
+#include "Analyzer.h"
+
+#include "../core/Parallel.h"
+
+namespace engine
+{
+	Analyzer::Analyzer(int multiPv, size_t hashMegabytes) : multiPv(std::max(multiPv, 1))
+	{
+		searcher.options.table = std::make_shared<TranspositionTable>(hashMegabytes);
+		thread = std::thread(&Analyzer::worker, this);
+	}
+
+	Analyzer::~Analyzer()
+	{
+		{
+			std::lock_guard guard(lock);
+			quitting = true;
+			stopFlag = true;
+		}
+		wake.notify_one();
+		thread.join();
+	}
+
+	void Analyzer::setPosition(const Position& pos)
+	{
+		if (hasPosition && positionKey == pos.getKey())
+			return;
+		hasPosition = true;
+		positionKey = pos.getKey();
+		{
+			std::lock_guard guard(lock);
+			pending = pos;
+			stopFlag = true;
+		}
+		wake.notify_one();
+	}
+
+	void Analyzer::worker()
+	{
+		core::lowerThreadPriority();
+		using Clock = std::chrono::steady_clock;
+		for (;;)
+		{
+			std::optional<Position> next;
+			{
+				std::unique_lock guard(lock);
+				wake.wait(guard, [this]() { return quitting || pending; });
+				if (quitting)
+					return;
+				next.swap(pending);
+				stopFlag = false;
+			}
+			auto& pos = *next;
+
+			//     :      
+			searcher.options.table->newSearch();
+			SearchLimits limits;
+			limits.multiPv = multiPv;
+			limits.stop = &stopFlag;
+
+			auto start = Clock::now();
+			auto publish = [&](const SearchResult& r, bool finished)
+			{
+				auto& s = snapshots.back();
+				s.key = pos.getKey();
+				s.side = pos.getSide();
+				s.depth = r.depth;
+				s.nodes = searcher.getStats().nodes;
+				s.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+				s.lines = r.lines;
+				s.finished = finished;
+				snapshots.publish();
+				if (onUpdate && !notified.exchange(true, std::memory_order_acq_rel))
+					onUpdate();
+			};
+
+			searcher.onIteration = [&](const SearchResult& r) { publish(r, false); };
+			auto result = searcher.search(pos, limits);
+			searcher.onIteration = nullptr;
+			if (!stopFlag && result.depth > 0)
+				publish(result, true);
+		}
+	}
+}
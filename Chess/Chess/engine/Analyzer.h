@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Search.h"
+#include "../core/TripleBuffer.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace engine
+{
+	/// <summary>
+	///   
+	/// </summary>
+	struct AnalysisSnapshot
+	{
+		/// <summary>
+		///    :     
+		/// </summary>
+		uint64_t key = 0;
+
+		chess::Side side = chess::Side::White;
+		int depth = 0;
+		uint64_t nodes = 0;
+		int64_t elapsedMs = 0;
+
+		/// <summary>
+		///      (       )
+		/// </summary>
+		std::vector<PvLine> lines;
+
+		/// <summary>
+		///   (       ) :    
+		/// </summary>
+		bool finished = false;
+	};
+
+	/// <summary>
+	///            :
+	///     ,    .
+	///      ( core::TripleBuffer ),  
+	///     
+	/// </summary>
+	class Analyzer
+	{
+	public:
+		/// <summary>
+		///       ,      
+		///  read() :    ,    [    ]
+		/// </summary>
+		std::function<void()> onUpdate;
+
+		/// <summary>
+		///    (     )
+		/// </summary>
+		/// <param name="multiPv"> </param>
+		/// <param name="hashMegabytes">  , </param>
+		explicit Analyzer(int multiPv = 3, size_t hashMegabytes = 16);
+
+		/// <summary>
+		///     
+		/// </summary>
+		~Analyzer();
+
+		Analyzer(const Analyzer&) = delete;
+		Analyzer& operator=(const Analyzer&) = delete;
+
+		/// <summary>
+		///   :    .      
+		/// [   ;     ,     ]
+		/// </summary>
+		/// <param name="pos"></param>
+		void setPosition(const Position& pos);
+
+		/// <summary>
+		///   [   ;   ]
+		/// </summary>
+		/// <returns>,     [ nullptr -    ]</returns>
+		const AnalysisSnapshot* read()
+		{
+			notified.store(false, std::memory_order_release);
+			return snapshots.read();
+		}
+
+	private:
+		Searcher searcher;
+		int multiPv;
+		core::TripleBuffer<AnalysisSnapshot> snapshots;
+
+		std::mutex lock;
+		std::condition_variable wake;
+		std::optional<Position> pending;
+		bool quitting = false;
+		std::atomic<bool> stopFlag = false;
+		std::atomic<bool> notified = false;
+
+		/// <summary>
+		///   setPosition() [   ]
+		/// </summary>
+		uint64_t positionKey = 0;
+		bool hasPosition = false;
+
+		std::thread thread;
+
+		void worker();
+	};
+}
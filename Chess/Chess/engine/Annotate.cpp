@@ -0,0 +1,289 @@
+#include "Annotate.h"
+
+#include "Archive.h"
+#include "Pgn.h"
+#include "San.h"
+#include "Search.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace engine::annotate
+{
+	namespace
+	{
+		/// <summary>
+		///     ,    :      
+		/// </summary>
+		constexpr int LossClamp = 1500;
+
+		/// <summary>
+		///     
+		/// </summary>
+		constexpr size_t LineWidth = 80;
+
+		/// <summary>
+		///   :      ,     
+		/// </summary>
+		struct Worker
+		{
+			Searcher searcher;
+			pgn::Game game;
+			std::vector<chess::FullMove> moves;
+			std::vector<pgn::Tag> tags;
+			std::vector<Move> played;
+			std::vector<int> scores;
+			Stats stats;
+		};
+
+		/// <summary>
+		///    [%eval] :    ,    "#N"  
+		/// </summary>
+		void writeEval(std::string& out, int whiteScore)
+		{
+			char buffer[16];
+			if (std::abs(whiteScore) >= MateBound)
+			{
+				int moves = (MateScore - std::abs(whiteScore) + 1) / 2;
+				std::snprintf(buffer, sizeof(buffer), "#%s%d", whiteScore < 0 ? "-" : "", moves);
+			}
+			else
+			{
+				std::snprintf(buffer, sizeof(buffer), "%.2f", whiteScore / 100.0);
+			}
+			out += buffer;
+		}
+
+		/// <summary>
+		///        
+		/// </summary>
+		void writeToken(std::string& out, size_t& lineStart, std::string_view token)
+		{
+			if (out.size() > lineStart)
+			{
+				if (out.size() - lineStart + 1 + token.size() > LineWidth)
+				{
+					out += '\n';
+					lineStart = out.size();
+				}
+				else
+				{
+					out += ' ';
+				}
+			}
+			out += token;
+		}
+
+		/// <summary>
+		///         PGN
+		/// </summary>
+		void annotateGame(Worker& w, const Options& options, const Position& start, std::string_view result,
+			              std::string& out)
+		{
+			//      :        
+			w.searcher.newGame();
+			w.searcher.options.table->clear();
+
+			SearchLimits limits;
+			limits.nodes = options.nodes;
+			limits.movetimeMs = options.movetimeMs;
+			if (options.depth > 0)
+				limits.depth = options.depth;
+
+			//  1 :    (    ,   )
+			w.played.clear();
+			w.scores.clear();
+			auto pos = start;
+			bool error = false;
+			for (size_t i = 0;; ++i)
+			{
+				MoveList legal;
+				pos.generateLegalMoves(legal);
+				if (legal.count == 0)
+				{
+					w.scores.push_back(pos.inCheck() ? -MateScore : 0);
+					break;
+				}
+
+				w.scores.push_back(w.searcher.search(pos, limits).score);
+				++w.stats.positions;
+				w.stats.nodes += w.searcher.getStats().nodes;
+
+				if (i == w.moves.size())
+					break;
+				auto m = pos.findMove(w.moves[i]);
+				Undo undo;
+				if (m.isNone() || !pos.makeMove(m, undo))
+				{
+					error = true;
+					break;
+				}
+				w.played.push_back(m);
+			}
+			w.stats.errors += error;
+
+			//  2 : 
+			for (auto& tag : w.tags)
+			{
+				out.append("[").append(tag.name).append(" \"").append(tag.value).append("\"]\n");
+			}
+			if (std::none_of(w.tags.begin(), w.tags.end(), [](const pgn::Tag& t) { return t.name == "Annotator"; }))
+				out += "[Annotator \"Chess\"]\n";
+			out += '\n';
+
+			pos = start;
+			size_t lineStart = out.size();
+			char san[san::BufferSize + 4];
+			std::string comment;
+			for (size_t i = 0; i < w.played.size(); ++i)
+			{
+				auto m = w.played[i];
+				bool white = pos.getSide() == chess::Side::White;
+				if (white || i == 0)
+				{
+					std::snprintf(san, sizeof(san), white ? "%d." : "%d...", pos.getMoveCounter());
+					writeToken(out, lineStart, san);
+				}
+				san::write(pos, m, san);
+				writeToken(out, lineStart, san);
+
+				//   :       ,     
+				int before = std::clamp(w.scores[i], -LossClamp, LossClamp);
+				int after = std::clamp(-w.scores[i + 1], -LossClamp, LossClamp);
+				if (before - after >= options.blunder)
+				{
+					writeToken(out, lineStart, "$4");
+					++w.stats.blunders;
+				}
+				else if (before - after >= options.mistake)
+				{
+					writeToken(out, lineStart, "$2");
+					++w.stats.mistakes;
+				}
+
+				Undo undo;
+				pos.makeMove(m, undo);
+
+				//      :    '#'
+				int score = w.scores[i + 1];
+				if (score != -MateScore)
+				{
+					comment = "{ [%eval ";
+					writeEval(comment, pos.getSide() == chess::Side::White ? score : -score);
+					comment += "] }";
+					writeToken(out, lineStart, comment);
+				}
+			}
+			writeToken(out, lineStart, result.empty() ? "*" : result);
+			out += "\n\n";
+			++w.stats.games;
+		}
+	}
+
+	Stats run(const std::string& inputPath, std::ostream& out, const Options& options)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		int threads = std::max(options.threads, 1);
+
+		//    :   
+		bool isArchive;
+		{
+			core::MappedFile probe(inputPath);
+			isArchive = probe.size() >= 4 && std::memcmp(probe.data(), archive::HeaderMagic, 4) == 0;
+		}
+
+		std::unique_ptr<archive::Reader> archiveReader;
+		std::unique_ptr<pgn::Reader> pgnReader;
+		std::vector<std::string_view> parts;
+		size_t jobs;
+		if (isArchive)
+		{
+			archiveReader = std::make_unique<archive::Reader>(inputPath);
+			jobs = archiveReader->size();
+		}
+		else
+		{
+			//        :        
+			constexpr size_t PartBytes = 16 << 10;
+			pgnReader = std::make_unique<pgn::Reader>(inputPath);
+			auto text = pgnReader->text();
+			parts = pgn::Reader::split(text, int(std::max<size_t>(size_t(threads) * 8, text.size() / PartBytes + 1)));
+			jobs = parts.size();
+		}
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.push_back(std::make_unique<Worker>());
+			workers.back()->searcher.options.table = std::make_shared<TranspositionTable>(options.hashMegabytes);
+		}
+
+		//       : ,     ,      
+		std::mutex outputLock;
+		std::vector<std::string> ready(jobs);
+		std::vector<char> done(jobs, 0);
+		size_t nextToWrite = 0;
+
+		auto start = Position::startPosition();
+		core::parallelFor(jobs, threads, [&](size_t job, int t)
+		{
+			auto& w = *workers[t];
+			std::string text;
+			if (archiveReader)
+			{
+				w.tags.clear();
+				for (auto name : archiveReader->headerNames())
+				{
+					if (auto value = archiveReader->header(job, name); !value.empty())
+						w.tags.push_back({ name, value });
+				}
+				auto fen = archiveReader->header(job, "FEN");
+				auto result = archiveReader->header(job, "Result");
+				archiveReader->readMoves(job, w.moves);
+				annotateGame(w, options, fen.empty() ? start : Position::fromFEN(fen), result, text);
+			}
+			else
+			{
+				pgn::Parser parser(parts[job], size_t(parts[job].data() - pgnReader->text().data()));
+				while (parser.next(w.game))
+				{
+					w.tags = w.game.tags;
+					w.moves = w.game.moves;
+					auto fen = w.game.tag("FEN");
+					auto result = w.game.result.empty() ? w.game.tag("Result") : w.game.result;
+					annotateGame(w, options, fen.empty() ? start : Position::fromFEN(fen), result, text);
+				}
+			}
+
+			std::lock_guard guard(outputLock);
+			ready[job] = std::move(text);
+			done[job] = 1;
+			for (; nextToWrite < jobs && done[nextToWrite]; ++nextToWrite)
+			{
+				out << ready[nextToWrite];
+				std::string().swap(ready[nextToWrite]);
+			}
+			out.flush();
+		});
+
+		Stats total;
+		for (auto& w : workers)
+		{
+			total.games += w->stats.games;
+			total.positions += w->stats.positions;
+			total.errors += w->stats.errors;
+			total.mistakes += w->stats.mistakes;
+			total.blunders += w->stats.blunders;
+			total.nodes += w->stats.nodes;
+		}
+		total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return total;
+	}
+}
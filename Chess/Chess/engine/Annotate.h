@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace engine::annotate
+{
+	/// <summary>
+	///   
+	/// </summary>
+	struct Options
+	{
+		/// <summary>
+		///   :       
+		/// </summary>
+		int threads = 1;
+
+		/// <summary>
+		///     [ 0 -   ].    -  
+		/// </summary>
+		uint64_t nodes = 50000;
+		int depth = 0;
+		int64_t movetimeMs = 0;
+
+		/// <summary>
+		///    , .           
+		/// </summary>
+		size_t hashMegabytes = 16;
+
+		/// <summary>
+		///    (    )   "?" ( $2 )  "??" ( $4 )
+		/// </summary>
+		int mistake = 100;
+		int blunder = 300;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Stats
+	{
+		uint64_t games = 0;
+		uint64_t positions = 0;
+		uint64_t errors = 0;
+		uint64_t mistakes = 0;
+		uint64_t blunders = 0;
+		uint64_t nodes = 0;
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///   :     ,   
+	///   { [%eval 0.35] } (    , "#3" -  ),  ,
+	///   ,      .
+	///        
+	/// </summary>
+	/// <param name="inputPath"> PGN    ( engine::archive,     )</param>
+	/// <param name="out">     PGN</param>
+	/// <param name="options"></param>
+	/// <returns> </returns>
+	Stats run(const std::string& inputPath, std::ostream& out, const Options& options);
+}
@@ -0,0 +1,438 @@
+#include "Archive.h"
+
+#include "../chess/Board.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace engine::archive
+{
+	static_assert(sizeof(FileHeader) == 16 && sizeof(IndexEntry) == 16 && sizeof(Footer) == 40);
+
+	namespace
+	{
+		template <typename T>
+		T read(const std::byte* p)
+		{
+			T res;
+			std::memcpy(&res, p, sizeof(T));
+			return res;
+		}
+
+		/// <summary>
+		///        (   )
+		/// </summary>
+		int gain(const Position& pos, Move m)
+		{
+			auto piece = pos.at(m.from());
+			auto moved = m.isPromotion() ? makePiece(sideOf(piece), m.promotionType()) : piece;
+			int res = Psqt[moved][m.to()].mg - Psqt[piece][m.from()].mg;
+
+			Square captured = m.flag() == MoveFlag::Passing ? toSquare(fileOf(m.to()), rankOf(m.from())) : m.to();
+			if (auto victim = pos.at(captured); victim != NoPiece)
+				res -= Psqt[victim][captured].mg;
+			return sideOf(piece) == chess::Side::White ? res : -res;
+		}
+
+		bool isLegal(Position& pos, Move m)
+		{
+			Undo undo;
+			bool legal = pos.makeMove(m, undo);
+			pos.unmakeMove(m, undo);
+			return legal;
+		}
+
+		/// <summary>
+		///    Encoding::Ranked :   ,  -   
+		/// </summary>
+		void rankMoves(const Position& pos, MoveList& list)
+		{
+			//  : ,       -   
+			std::array<int, MaxMoves> keys;
+			for (int i = 0; i < list.count; ++i)
+				keys[i] = gain(pos, list.moves[i]) * MaxMoves + (MaxMoves - 1 - i);
+			std::sort(keys.begin(), keys.begin() + list.count, std::greater<int>());
+
+			auto moves = list.moves;
+			for (int i = 0; i < list.count; ++i)
+				list.moves[i] = moves[MaxMoves - 1 - (keys[i] & (MaxMoves - 1))];
+		}
+
+		/// <summary>
+		///     :      + 4,    + 4
+		/// </summary>
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+			void put(uint32_t value, int count)
+			{
+				for (int i = count - 1; i >= 0; --i)
+				{
+					acc = uint8_t(acc << 1 | ((value >> i) & 1));
+					if (++bits == 8)
+					{
+						out.push_back(acc);
+						acc = 0;
+						bits = 0;
+					}
+				}
+			}
+
+			void putRank(uint32_t rank)
+			{
+				uint32_t v = rank + 4;
+				int length = 0;
+				while ((v >> length) > 1)
+					++length;
+				put(0, length - 2);
+				put(v, length + 1);
+			}
+
+			void flush()
+			{
+				if (bits > 0)
+					out.push_back(uint8_t(acc << (8 - bits)));
+				acc = 0;
+				bits = 0;
+			}
+
+		private:
+			std::vector<uint8_t>& out;
+			uint8_t acc = 0;
+			int bits = 0;
+		};
+
+		class BitReader
+		{
+		public:
+			BitReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+			bool get(int count, uint32_t& value)
+			{
+				value = 0;
+				for (int i = 0; i < count; ++i)
+				{
+					if (pos >= size * 8)
+						return false;
+					value = value << 1 | ((data[pos / 8] >> (7 - pos % 8)) & 1);
+					++pos;
+				}
+				return true;
+			}
+
+			bool getRank(uint32_t& rank)
+			{
+				int zeros = 0;
+				uint32_t bit = 0;
+				while (get(1, bit) && bit == 0)
+				{
+					if (++zeros > 24)
+						return false;
+				}
+				if (bit != 1 || !get(zeros + 2, rank))
+					return false;
+				rank = ((1u << (zeros + 2)) | rank) - 4;
+				return true;
+			}
+
+		private:
+			const uint8_t* data;
+			size_t size;
+			size_t pos = 0;
+		};
+	}
+
+	Writer::Writer(const std::string& path, Encoding encoding, bool append)
+		: path(path), encoding(encoding), start(Position::startPosition())
+	{
+		if (append && std::filesystem::exists(path) && std::filesystem::file_size(path) > 0)
+		{
+			//      ,     
+			{
+				Reader old(path);
+				this->encoding = old.encoding;
+				dataEnd = old.columnsOffset;
+				for (size_t i = 0; i < old.size(); ++i)
+					index.push_back(old.entry(i));
+				for (auto name : old.headerNames())
+				{
+					auto& c = column(name);
+					for (size_t i = 0; i < old.size(); ++i)
+					{
+						c.values += old.header(i, name);
+						c.offsets[i + 1] = uint32_t(c.values.size());
+					}
+				}
+			}
+			std::filesystem::resize_file(path, dataEnd);
+			file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(std::streamoff(dataEnd));
+		}
+		else
+		{
+			file.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+			FileHeader header = {};
+			std::memcpy(header.magic, HeaderMagic, 4);
+			header.version = FormatVersion;
+			header.encoding = this->encoding;
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+		if (!file)
+			throw std::runtime_error("archive: cannot open " + path);
+	}
+
+	Writer::~Writer()
+	{
+		try
+		{
+			if (file.is_open())
+				close();
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+
+	Writer::Column& Writer::column(std::string_view name)
+	{
+		for (auto& c : columns)
+		{
+			if (c.name == name)
+				return c;
+		}
+		//      -  
+		return columns.emplace_back(Column{ std::string(name), std::vector<uint32_t>(index.size() + 1, 0), {} });
+	}
+
+	void Writer::add(const std::vector<chess::FullMove>& moves, Result result, const std::vector<pgn::Tag>& tags)
+	{
+		Position pos = start;
+		for (auto& t : tags)
+		{
+			if (t.name == "FEN" && !t.value.empty())
+				pos = Position::fromFEN(t.value);
+		}
+		if (moves.size() > UINT16_MAX)
+			throw std::invalid_argument("archive: game is too long");
+
+		buffer.clear();
+		BitWriter bits(buffer);
+		for (auto& fm : moves)
+		{
+			MoveList list;
+			pos.generateMoves(list);
+			if (encoding == Encoding::Ranked)
+				rankMoves(pos, list);
+
+			//    :     
+			int found = -1, legalBefore = 0;
+			for (int i = 0; i < list.count && found < 0; ++i)
+			{
+				auto m = list.moves[i].toFullMove();
+				bool legal = isLegal(pos, list.moves[i]);
+				if (legal && m.from == fm.from && m.to == fm.to && m.promotionResult == fm.promotionResult)
+					found = i;
+				else
+					legalBefore += legal;
+			}
+			if (found < 0)
+				throw std::invalid_argument("archive: illegal move in game " + std::to_string(index.size()));
+
+			if (encoding == Encoding::Ranked)
+				bits.putRank(uint32_t(legalBefore));
+			else
+				buffer.push_back(uint8_t(legalBefore));
+
+			Undo undo;
+			pos.makeMove(list.moves[found], undo);
+		}
+		bits.flush();
+
+		file.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+		if (!file)
+			throw std::runtime_error("archive: cannot write " + path);
+
+		for (auto& t : tags)
+		{
+			auto& c = column(t.name);
+			if (c.values.size() == c.offsets.back())
+				c.values += t.value; //      
+		}
+		index.push_back({ dataEnd, uint32_t(buffer.size()), uint16_t(moves.size()), result, 0 });
+		dataEnd += buffer.size();
+		for (auto& c : columns)
+		{
+			if (c.offsets.size() == index.size())
+				c.offsets.push_back(uint32_t(c.values.size()));
+		}
+	}
+
+	void Writer::add(const chess::Board& board, Result result, const std::vector<pgn::Tag>& tags)
+	{
+		add(board.getMoveHistory(), result, tags);
+	}
+
+	void Writer::close()
+	{
+		Footer footer = {};
+		footer.gameCount = index.size();
+		footer.columnsOffset = dataEnd;
+		footer.columnCount = uint32_t(columns.size());
+		for (auto& c : columns)
+		{
+			auto length = uint16_t(c.name.size());
+			file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+			file.write(c.name.data(), length);
+			file.write(reinterpret_cast<const char*>(c.offsets.data()), std::streamsize(c.offsets.size() * sizeof(uint32_t)));
+			file.write(c.values.data(), std::streamsize(c.values.size()));
+			dataEnd += sizeof(length) + length + c.offsets.size() * sizeof(uint32_t) + c.values.size();
+		}
+		footer.indexOffset = dataEnd;
+		file.write(reinterpret_cast<const char*>(index.data()), std::streamsize(index.size() * sizeof(IndexEntry)));
+		std::memcpy(footer.magic, FooterMagic, 4);
+		footer.version = FormatVersion;
+		file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+
+		file.close();
+		if (!file)
+			throw std::runtime_error("archive: cannot write " + path);
+	}
+
+	Reader::Reader(const std::string& path) : file(path), start(Position::startPosition())
+	{
+		auto invalid = [&]() { return std::runtime_error("archive: invalid file " + path); };
+		if (file.size() < sizeof(FileHeader) + sizeof(Footer))
+			throw invalid();
+
+		auto header = read<FileHeader>(file.data());
+		auto footer = read<Footer>(file.data() + file.size() - sizeof(Footer));
+		if (std::memcmp(header.magic, HeaderMagic, 4) != 0 || std::memcmp(footer.magic, FooterMagic, 4) != 0 ||
+			header.version != FormatVersion || footer.version != FormatVersion || header.encoding > Encoding::Ranked)
+			throw invalid();
+		if (footer.indexOffset + footer.gameCount * sizeof(IndexEntry) + sizeof(Footer) != file.size() ||
+			footer.columnsOffset < sizeof(FileHeader) || footer.columnsOffset > footer.indexOffset)
+			throw invalid();
+
+		encoding = header.encoding;
+		gameCount = size_t(footer.gameCount);
+		indexOffset = footer.indexOffset;
+		columnsOffset = footer.columnsOffset;
+
+		uint64_t p = columnsOffset;
+		for (uint32_t i = 0; i < footer.columnCount; ++i)
+		{
+			if (p + sizeof(uint16_t) > indexOffset)
+				throw invalid();
+			auto length = read<uint16_t>(file.data() + p);
+			p += sizeof(uint16_t);
+			uint64_t offsetsSize = (gameCount + 1) * sizeof(uint32_t);
+			if (p + length + offsetsSize > indexOffset)
+				throw invalid();
+
+			Column c;
+			c.name = { reinterpret_cast<const char*>(file.data() + p), length };
+			c.offsets = file.data() + p + length;
+			c.values = reinterpret_cast<const char*>(c.offsets + offsetsSize);
+			p += length + offsetsSize;
+			p += read<uint32_t>(c.offsets + gameCount * sizeof(uint32_t));
+			if (p > indexOffset)
+				throw invalid();
+			columns.push_back(c);
+		}
+	}
+
+	IndexEntry Reader::entry(size_t game) const
+	{
+		return read<IndexEntry>(file.data() + indexOffset + game * sizeof(IndexEntry));
+	}
+
+	std::string_view Reader::header(size_t game, std::string_view name) const
+	{
+		for (auto& c : columns)
+		{
+			if (c.name != name)
+				continue;
+			auto begin = read<uint32_t>(c.offsets + game * sizeof(uint32_t));
+			auto end = read<uint32_t>(c.offsets + (game + 1) * sizeof(uint32_t));
+			return end > begin ? std::string_view(c.values + begin, end - begin) : std::string_view();
+		}
+		return {};
+	}
+
+	std::vector<std::string_view> Reader::headerNames() const
+	{
+		std::vector<std::string_view> res;
+		for (auto& c : columns)
+			res.push_back(c.name);
+		return res;
+	}
+
+	bool Reader::replay(size_t game, const std::function<void(const Position&, Move)>& onMove) const
+	{
+		if (game >= gameCount)
+			return false;
+		auto e = entry(game);
+		if (e.offset < sizeof(FileHeader) || e.offset + e.size > columnsOffset)
+			return false;
+
+		Position pos = start;
+		if (auto fen = header(game, "FEN"); !fen.empty())
+		{
+			try
+			{
+				pos = Position::fromFEN(fen);
+			}
+			catch (const std::exception&)
+			{
+				return false;
+			}
+		}
+
+		auto data = reinterpret_cast<const uint8_t*>(file.data() + e.offset);
+		BitReader bits(data, e.size);
+		for (int ply = 0; ply < e.plies; ++ply)
+		{
+			MoveList list;
+			pos.generateMoves(list);
+
+			uint32_t i = 0;
+			if (encoding == Encoding::Ranked)
+			{
+				rankMoves(pos, list);
+				if (!bits.getRank(i))
+					return false;
+			}
+			else
+			{
+				if (ply >= int(e.size))
+					return false;
+				i = data[ply];
+			}
+
+			// i-   :     
+			Move m;
+			for (int j = 0; j < list.count && m.isNone(); ++j)
+			{
+				if (isLegal(pos, list.moves[j]) && i-- == 0)
+					m = list.moves[j];
+			}
+			if (m.isNone())
+				return false;
+
+			onMove(pos, m);
+			Undo undo;
+			pos.makeMove(m, undo);
+		}
+		return true;
+	}
+
+	bool Reader::readMoves(size_t game, std::vector<chess::FullMove>& moves) const
+	{
+		moves.clear();
+		return replay(game, [&](const Position&, Move m) { moves.push_back(m.toFullMove()); });
+	}
+}
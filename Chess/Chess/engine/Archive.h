@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Pgn.h"
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chess
+{
+	class Board;
+}
+
+namespace engine::archive
+{
+	/// <summary>
+	///  
+	/// </summary>
+	enum class Result : uint8_t
+	{
+		Unknown, WhiteWins, BlackWins, Draw,
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	enum class Encoding : uint32_t
+	{
+		/// <summary>
+		///    :       (   )
+		/// </summary>
+		Raw,
+
+		/// <summary>
+		///       ,     
+		///    ( 3       , 5 -    ... ).
+		///  4 - 5   
+		/// </summary>
+		Ranked,
+	};
+
+	/// <summary>
+	///   ( little-endian )
+	/// </summary>
+	struct FileHeader
+	{
+		char     magic[4];
+		uint32_t version;
+		Encoding encoding;
+		uint32_t reserved;
+	};
+
+	/// <summary>
+	///    :       
+	/// </summary>
+	struct IndexEntry
+	{
+		uint64_t offset;
+		uint32_t size;
+		uint16_t plies;
+		Result   result;
+		uint8_t  reserved;
+	};
+
+	/// <summary>
+	///  .   : FileHeader,   ,  ,  , Footer.
+	///   :   ( uint16_t ), ,   ( uint32_t x ( gameCount + 1 ) ),  
+	/// </summary>
+	struct Footer
+	{
+		uint64_t gameCount;
+		uint64_t columnsOffset;
+		uint64_t indexOffset;
+		uint32_t columnCount;
+		uint32_t reserved;
+		char     magic[4];
+		uint32_t version;
+	};
+
+	constexpr char     HeaderMagic[4] = { 'C', 'G', 'A', 'R' };
+	constexpr char     FooterMagic[4] = { 'C', 'G', 'A', 'X' };
+	constexpr uint32_t FormatVersion  = 1;
+
+	/// <summary>
+	///    .     ,     -  
+	/// </summary>
+	class Writer
+	{
+	public:
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="path">  </param>
+		/// <param name="encoding">    </param>
+		/// <param name="append">true -     (     )</param>
+		Writer(const std::string& path, Encoding encoding = Encoding::Ranked, bool append = false);
+
+		/// <summary>
+		///  ,  close()   [    ]
+		/// </summary>
+		~Writer();
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="moves">    (     FEN )</param>
+		/// <param name="result"> </param>
+		/// <param name="tags"> </param>
+		void add(const std::vector<chess::FullMove>& moves, Result result, const std::vector<pgn::Tag>& tags = {});
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="board">    </param>
+		/// <param name="result"> </param>
+		/// <param name="tags"> </param>
+		void add(const chess::Board& board, Result result, const std::vector<pgn::Tag>& tags = {});
+
+		/// <summary>
+		///        
+		/// </summary>
+		void close();
+
+		size_t size() const { return index.size(); }
+
+	private:
+		/// <summary>
+		///   :    
+		/// </summary>
+		struct Column
+		{
+			std::string name;
+			std::vector<uint32_t> offsets;
+			std::string values;
+		};
+
+		std::string path;
+		std::fstream file;
+		Encoding encoding;
+		uint64_t dataEnd = sizeof(FileHeader);
+
+		std::vector<IndexEntry> index;
+		std::vector<Column> columns;
+		std::vector<uint8_t> buffer;
+
+		Position start;
+
+		Column& column(std::string_view name);
+	};
+
+	/// <summary>
+	///  ,   .        
+	/// </summary>
+	class Reader
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="path">  </param>
+		explicit Reader(const std::string& path);
+
+		size_t   size()        const { return gameCount; }
+		Encoding getEncoding() const { return encoding; }
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="game"> </param>
+		/// <returns> </returns>
+		IndexEntry entry(size_t game) const;
+
+		/// <summary>
+		///    (   )
+		/// </summary>
+		/// <param name="game"> </param>
+		/// <param name="name"> </param>
+		/// <returns> [  -    ]</returns>
+		std::string_view header(size_t game, std::string_view name) const;
+
+		/// <summary>
+		///    
+		/// </summary>
+		std::vector<std::string_view> headerNames() const;
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="game"> </param>
+		/// <param name="onMove">       </param>
+		/// <returns>false -    </returns>
+		bool replay(size_t game, const std::function<void(const Position&, Move)>& onMove) const;
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="game"> </param>
+		/// <param name="moves">   (  )</param>
+		/// <returns>false -    </returns>
+		bool readMoves(size_t game, std::vector<chess::FullMove>& moves) const;
+
+	private:
+		struct Column
+		{
+			std::string_view name;
+			const std::byte* offsets;
+			const char* values;
+		};
+
+		core::MappedFile file;
+		Encoding encoding = Encoding::Raw;
+		size_t gameCount = 0;
+		uint64_t indexOffset = 0;
+		std::vector<Column> columns;
+
+		/// <summary>
+		///    =   
+		/// </summary>
+		uint64_t columnsOffset = 0;
+
+		Position start;
+
+		friend class Writer;
+	};
+}
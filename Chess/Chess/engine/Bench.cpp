@@ -0,0 +1,353 @@
+#include "Bench.h"
+
+#include "MateSolver.h"
+#include "Nnue.h"
+#include "Search.h"
+
+#include <chrono>
+#include <iomanip>
+
+namespace engine
+{
+	namespace
+	{
+		/// <summary>
+		///    :         
+		/// </summary>
+		constexpr std::array<std::string_view, 10> MatePositions = {
+			"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1",
+			"r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 1",
+			"2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1",
+			"5k2/6pp/p1qN4/1p1p4/3P4/2PKP2Q/PP3r2/3R4 b - - 0 1",
+			"r1bq2r1/b4pk1/p1pp1p2/1p2pP2/1P2P1PB/3P4/1PPQ2P1/R3K2R w - - 0 1",
+			"8/8/8/3k4/8/8/8/RR4K1 w - - 0 1",
+			"1k6/8/8/8/8/8/6Q1/7K w - - 0 1",
+			"8/8/8/8/3k4/8/8/K6Q w - - 0 1",
+			"8/8/3k4/8/8/8/8/4K2Q w - - 0 1",
+			"8/8/8/4k3/8/8/8/KQ6 w - - 0 1",
+		};
+
+		/// <summary>
+		///      
+		/// </summary>
+		SearchStats benchPosition(std::string_view fen, int depth, const SearchOptions& options)
+		{
+			auto pos = Position::fromFEN(fen);
+			Searcher searcher;
+			searcher.options = options;
+
+			SearchLimits limits;
+			limits.depth = depth;
+			searcher.search(pos, limits);
+			return searcher.getStats();
+		}
+	}
+
+	int runBench(std::ostream& out, int depth)
+	{
+		SearchOptions unordered;
+		unordered.moveOrdering = false;
+		SearchOptions ordered;
+
+		out << "depth " << depth << "\n"
+			<< std::setw(3)  << "#"
+			<< std::setw(14) << "nodes (scan)"
+			<< std::setw(14) << "nodes (ord)"
+			<< std::setw(10) << "reduce "
+			<< std::setw(14) << "first (scan)"
+			<< std::setw(14) << "first (ord)" << "\n";
+
+		SearchStats totalUnordered, totalOrdered;
+		auto addTo = [](SearchStats& total, const SearchStats& s)
+		{
+			total.nodes += s.nodes;
+			total.cutoffs += s.cutoffs;
+			total.firstMoveCutoffs += s.firstMoveCutoffs;
+		};
+		auto printRow = [&](std::string_view name, const SearchStats& a, const SearchStats& b)
+		{
+			double reduction = a.nodes == 0 ? 0.0 : 100.0 * (1.0 - double(b.nodes) / a.nodes);
+			out << std::setw(3)  << name
+				<< std::setw(14) << a.nodes
+				<< std::setw(14) << b.nodes
+				<< std::setw(9)  << std::fixed << std::setprecision(1) << reduction << "%"
+				<< std::setw(13) << a.firstMoveCutoffRate() * 100 << "%"
+				<< std::setw(13) << b.firstMoveCutoffRate() * 100 << "%" << std::endl;
+		};
+
+		for (size_t i = 0; i < BenchPositions.size(); ++i)
+		{
+			auto a = benchPosition(BenchPositions[i], depth, unordered);
+			auto b = benchPosition(BenchPositions[i], depth, ordered);
+			addTo(totalUnordered, a);
+			addTo(totalOrdered, b);
+			printRow(std::to_string(i + 1), a, b);
+		}
+		printRow("all", totalUnordered, totalOrdered);
+		return 0;
+	}
+
+	int runSelectiveBench(std::ostream& out, int depth)
+	{
+		SearchOptions baseline;
+		baseline.nullMove = baseline.lateMoveReductions = baseline.futility =
+			baseline.reverseFutility = baseline.checkExtensions = false;
+
+		struct Config
+		{
+			std::string_view name;
+			SearchOptions options;
+		};
+		std::array<Config, 7> configs = {};
+		for (auto& c : configs)
+			c.options = baseline;
+		configs[0].name = "ordering only";
+		configs[1].name = "+ null move";        configs[1].options.nullMove = true;
+		configs[2].name = "+ LMR";              configs[2].options.lateMoveReductions = true;
+		configs[3].name = "+ futility";         configs[3].options.futility = true;
+		configs[4].name = "+ reverse futility"; configs[4].options.reverseFutility = true;
+		configs[5].name = "+ check extensions"; configs[5].options.checkExtensions = true;
+		configs[6].name = "all";                configs[6].options = SearchOptions();
+
+		out << "depth " << depth << "\n"
+			<< std::left << std::setw(20) << "config" << std::right
+			<< std::setw(14) << "nodes"
+			<< std::setw(10) << "vs base "
+			<< std::setw(9)  << "ms"
+			<< std::setw(12) << "triggered"
+			<< std::setw(12) << "pawn hits " << "\n";
+
+		uint64_t baseNodes = 0;
+		for (size_t c = 0; c < configs.size(); ++c)
+		{
+			SearchStats total;
+			auto start = std::chrono::steady_clock::now();
+			for (auto fen : BenchPositions)
+			{
+				auto s = benchPosition(fen, depth, configs[c].options);
+				total.nodes += s.nodes;
+				total.nullMoveCutoffs += s.nullMoveCutoffs;
+				total.reductions += s.reductions;
+				total.futilityPrunes += s.futilityPrunes;
+				total.reverseFutilityPrunes += s.reverseFutilityPrunes;
+				total.checkExtensions += s.checkExtensions;
+				total.pawnProbes += s.pawnProbes;
+				total.pawnHits += s.pawnHits;
+			}
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+			if (c == 0)
+				baseNodes = total.nodes;
+
+			//      
+			uint64_t triggered = 0;
+			const auto& o = configs[c].options;
+			if (o.nullMove)           triggered += total.nullMoveCutoffs;
+			if (o.lateMoveReductions) triggered += total.reductions;
+			if (o.futility)           triggered += total.futilityPrunes;
+			if (o.reverseFutility)    triggered += total.reverseFutilityPrunes;
+			if (o.checkExtensions)    triggered += total.checkExtensions;
+
+			double ratio = baseNodes == 0 ? 0.0 : 100.0 * double(total.nodes) / baseNodes;
+			out << std::left << std::setw(20) << configs[c].name << std::right
+				<< std::setw(14) << total.nodes
+				<< std::setw(9)  << std::fixed << std::setprecision(1) << ratio << "%"
+				<< std::setw(9)  << ms
+				<< std::setw(12) << triggered
+				<< std::setw(11) << total.pawnHitRate() * 100 << "%" << std::endl;
+		}
+		return 0;
+	}
+
+	int runNnueBench(std::ostream& out, const std::string& networkPath)
+	{
+		auto net = nnue::Network::load(networkPath);
+		out << "nnue " << networkPath << " (" << nnue::Network::simdName() << ")" << std::endl;
+
+		using Clock = std::chrono::steady_clock;
+		auto nsPer = [](Clock::duration d, uint64_t n)
+		{
+			return n == 0 ? 0.0 : double(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) / n;
+		};
+
+		//     : make + unmake, make +  + unmake,     
+		constexpr int Rounds = 2000;
+		Clock::duration makeTime{}, moveEvalTime{}, layersTime{};
+		uint64_t moves = 0;
+		volatile int sink = 0;
+
+		for (auto fen : BenchPositions)
+		{
+			auto pos = Position::fromFEN(fen);
+			pos.setNetwork(net.get());
+			sink = sink + net->evaluate(pos);
+
+			MoveList list;
+			pos.generateLegalMoves(list);
+			for (int round = 0; round < Rounds; ++round)
+			{
+				for (auto m : list)
+				{
+					Undo undo;
+					auto t0 = Clock::now();
+					pos.makeMove(m, undo);
+					pos.unmakeMove(m, undo);
+					auto t1 = Clock::now();
+					pos.makeMove(m, undo);
+					sink = sink + net->evaluate(pos);
+					pos.unmakeMove(m, undo);
+					auto t2 = Clock::now();
+
+					makeTime += t1 - t0;
+					moveEvalTime += t2 - t1;
+					++moves;
+				}
+				auto t0 = Clock::now();
+				sink = sink + net->evaluate(pos);
+				layersTime += Clock::now() - t0;
+			}
+		}
+
+		//   :     
+		constexpr int Refreshes = 20000;
+		auto pos = Position::fromFEN(BenchPositions[1]);
+		auto t0 = Clock::now();
+		for (int i = 0; i < Refreshes; ++i)
+		{
+			pos.setNetwork(net.get());
+			sink = sink + net->evaluate(pos);
+		}
+		auto refreshTime = Clock::now() - t0;
+
+		double layers = nsPer(layersTime, uint64_t(Rounds) * BenchPositions.size());
+		double update = nsPer(moveEvalTime, moves) - nsPer(makeTime, moves) - layers;
+		out << std::fixed << std::setprecision(1)
+			<< "make + unmake        " << std::setw(8) << nsPer(makeTime, moves) << " ns\n"
+			<< "accumulator update   " << std::setw(8) << update << " ns per move\n"
+			<< "hidden layers        " << std::setw(8) << layers << " ns\n"
+			<< "full refresh + eval  " << std::setw(8) << nsPer(refreshTime, Refreshes) << " ns" << std::endl;
+		return 0;
+	}
+
+	int runReuseBench(std::ostream& out, int plies, uint64_t nodes)
+	{
+		//        :     ,     
+		Searcher fresh, reusing[2];
+		fresh.options.table = std::make_shared<TranspositionTable>();
+		for (auto& s : reusing)
+			s.options.table = std::make_shared<TranspositionTable>();
+
+		SearchLimits limits;
+		limits.nodes = nodes;
+
+		int freshDepth = 0;
+		uint64_t nodesToDepth = 0;
+		for (auto& s : reusing)
+		{
+			s.onIteration = [&](const SearchResult& r)
+			{
+				if (r.depth == freshDepth)
+					nodesToDepth = s.getStats().nodes;
+			};
+		}
+
+		uint64_t moves = 0, hits = 0, freshDepthSum = 0, reuseDepthSum = 0, freshNodes = 0, reuseNodes = 0;
+		for (auto fen : BenchPositions)
+		{
+			auto pos = Position::fromFEN(fen);
+			for (auto& s : reusing)
+			{
+				s.newGame();
+				s.options.table->clear();
+			}
+			for (int ply = 0; ply < plies; ++ply)
+			{
+				MoveList legal;
+				pos.generateLegalMoves(legal);
+				if (legal.empty() || pos.isRepetition() || pos.getHalfMoveClock() >= 100)
+					break;
+
+				//   -     
+				fresh.newGame();
+				fresh.options.table->clear();
+				auto a = fresh.search(pos, limits);
+				freshDepth = a.depth;
+				freshNodes += fresh.getStats().nodes;
+
+				auto& reuse = reusing[(int)pos.getSide()];
+				nodesToDepth = 0;
+				reuse.options.table->newSearch();
+				auto b = reuse.search(pos, limits);
+				if (nodesToDepth == 0)
+					nodesToDepth = reuse.getStats().nodes;
+				reuseNodes += nodesToDepth;
+
+				++moves;
+				hits += reuse.getStats().reusedPv != 0;
+				freshDepthSum += a.depth;
+				reuseDepthSum += b.depth;
+				if (b.best.isNone())
+					break;
+				Undo undo;
+				pos.makeMove(b.best, undo);
+			}
+		}
+
+		double n = double(std::max<uint64_t>(moves, 1));
+		out << std::fixed << std::setprecision(2)
+			<< "moves             " << std::setw(12) << moves << " ( " << nodes << " nodes each )\n"
+			<< "predicted replies " << std::setw(12) << 100.0 * hits / n << " %\n"
+			<< "depth, cleared    " << std::setw(12) << freshDepthSum / n << "\n"
+			<< "depth, reused     " << std::setw(12) << reuseDepthSum / n << "\n"
+			<< "depth gained      " << std::setw(12) << (double(reuseDepthSum) - double(freshDepthSum)) / n << "\n"
+			<< "nodes to same depth " << std::setw(10) << (freshNodes ? 100.0 * reuseNodes / freshNodes : 0.0) << " %" << std::endl;
+		return 0;
+	}
+
+	int runMateBench(std::ostream& out, uint64_t nodes)
+	{
+		using Clock = std::chrono::steady_clock;
+		constexpr int MaxMoves = 20;
+
+		out << std::setw(4) << "#" << std::setw(12) << "df-pn" << std::setw(12) << "nodes" << std::setw(12) << "ms"
+			<< std::setw(12) << "alpha-beta" << std::setw(12) << "depth" << std::setw(12) << "ms" << "\n";
+
+		//  "#N" : N -  , "#N?" -   , "-" -   
+		auto mateText = [](int moves, bool shortest)
+		{
+			return moves == 0 ? std::string("-") : "#" + std::to_string(moves) + (shortest ? "" : "?");
+		};
+
+		mate::Solver solver;
+		int solved = 0, searched = 0;
+		for (size_t i = 0; i < MatePositions.size(); ++i)
+		{
+			auto pos = Position::fromFEN(MatePositions[i]);
+
+			auto start = Clock::now();
+			auto mate = solver.solve(pos, MaxMoves, nodes);
+			auto solverMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+			Searcher searcher;
+			searcher.options.table = std::make_shared<TranspositionTable>();
+			SearchLimits limits;
+			limits.nodes = nodes;
+			start = Clock::now();
+			auto result = searcher.search(pos, limits);
+			auto searchMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+			int searchMate = result.score >= MateBound ? (MateScore - result.score + 1) / 2 : 0;
+
+			solved += mate.verdict == mate::Verdict::Mate;
+			searched += searchMate != 0;
+			out << std::setw(4) << i + 1
+				<< std::setw(12) << mateText(mate.verdict == mate::Verdict::Mate ? mate.mateIn : 0, mate.shortest)
+				<< std::setw(12) << mate.nodes << std::setw(12) << solverMs
+				<< std::setw(12) << mateText(searchMate, true)
+				<< std::setw(12) << result.depth << std::setw(12) << searchMs << "\n";
+		}
+
+		out << "mates found: df-pn " << solved << ", alpha-beta " << searched << " of " << MatePositions.size()
+			<< " ( " << nodes << " nodes each )" << std::endl;
+		return 0;
+	}
+}
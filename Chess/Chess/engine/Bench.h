@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace engine
+{
+	/// <summary>
+	///       
+	/// </summary>
+	constexpr std::array<std::string_view, 8> BenchPositions = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+		"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+		"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+		"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+	};
+
+	/// <summary>
+	///    :       
+	///   (    )   .
+	///        
+	/// </summary>
+	/// <param name="out">    </param>
+	/// <param name="depth"> </param>
+	/// <returns>0 -    main()</returns>
+	int runBench(std::ostream& out, int depth = 5);
+
+	/// <summary>
+	///    :        ,
+	///          .
+	///   , ,        
+	/// </summary>
+	/// <param name="out">    </param>
+	/// <param name="depth"> </param>
+	/// <returns>0 -    main()</returns>
+	int runSelectiveBench(std::ostream& out, int depth = 6);
+
+	/// <summary>
+	///    :     ,
+	///       
+	/// </summary>
+	/// <param name="out">   </param>
+	/// <param name="networkPath">   </param>
+	/// <returns>0 -    main()</returns>
+	int runNnueBench(std::ostream& out, const std::string& networkPath);
+
+	/// <summary>
+	///       :        ,
+	///             (  ,
+	///  ,    ).       ,
+	///      ,         
+	/// </summary>
+	/// <param name="out">   </param>
+	/// <param name="plies">   </param>
+	/// <param name="nodes">  </param>
+	/// <returns>0 -    main()</returns>
+	int runReuseBench(std::ostream& out, int plies, uint64_t nodes);
+
+	/// <summary>
+	///               :
+	///         .   ,     
+	/// </summary>
+	/// <param name="out">    </param>
+	/// <param name="nodes">   </param>
+	/// <returns>0 -    main()</returns>
+	int runMateBench(std::ostream& out, uint64_t nodes);
+}
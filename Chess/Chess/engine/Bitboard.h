@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Types.h"
+
+#include <bit>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace engine
+{
+	/// <summary>
+	///    :  s -  s
+	/// </summary>
+	using Bitboard = uint64_t;
+
+	constexpr Bitboard bit(Square s) { return Bitboard(1) << s; }
+
+	/// <summary>
+	///     
+	/// </summary>
+	inline Square lsb(Bitboard b)
+	{
+#ifdef _MSC_VER
+		unsigned long idx;
+		_BitScanForward64(&idx, b);
+		return Square(idx);
+#else
+		return Square(__builtin_ctzll(b));
+#endif
+	}
+
+	/// <summary>
+	///     
+	/// </summary>
+	inline Square msb(Bitboard b)
+	{
+#ifdef _MSC_VER
+		unsigned long idx;
+		_BitScanReverse64(&idx, b);
+		return Square(idx);
+#else
+		return Square(63 - __builtin_clzll(b));
+#endif
+	}
+
+	/// <summary>
+	///     
+	/// </summary>
+	inline Square popLsb(Bitboard& b)
+	{
+		auto s = lsb(b);
+		b &= b - 1;
+		return s;
+	}
+
+	constexpr int popCount(Bitboard b)
+	{
+		return std::popcount(b);
+	}
+
+	/// <summary>
+	///   { , -, , -, , -, , - } :
+	///  -  ,  -   ;      ,  -  
+	/// </summary>
+	constexpr int RayDx[8] = { 0, 1, 1, -1,  0, -1, -1,  1 };
+	constexpr int RayDy[8] = { 1, 1, 0,  1, -1, -1,  0, -1 };
+
+	/// <summary>
+	///  ,   ,      
+	/// </summary>
+	struct Masks
+	{
+		Bitboard files[8] = {};
+		Bitboard adjacentFiles[8] = {};
+
+		/// <summary>
+		///       [  ][  ]
+		/// </summary>
+		Bitboard forwardFile[2][64] = {};
+
+		/// <summary>
+		///      (        )
+		/// </summary>
+		Bitboard pawnAttackSpan[2][64] = {};
+
+		/// <summary>
+		///   :         
+		/// </summary>
+		Bitboard passedSpan[2][64] = {};
+
+		Bitboard knightAttacks[64] = {};
+
+		/// <summary>
+		///      [  ][  ]
+		/// </summary>
+		Bitboard rays[8][64] = {};
+
+		constexpr Masks()
+		{
+			for (int x = 0; x < 8; ++x)
+				for (int y = 0; y < 8; ++y)
+					files[x] |= bit(toSquare(x, y));
+			for (int x = 0; x < 8; ++x)
+				adjacentFiles[x] = (x > 0 ? files[x - 1] : 0) | (x < 7 ? files[x + 1] : 0);
+
+			for (Square s = 0; s < 64; ++s)
+			{
+				for (int side = 0; side < 2; ++side)
+				{
+					int dir = side == 0 ? 1 : -1;
+					for (int y = rankOf(s) + dir; y >= 0 && y < 8; y += dir)
+					{
+						forwardFile[side][s] |= bit(toSquare(fileOf(s), y));
+						if (fileOf(s) > 0) pawnAttackSpan[side][s] |= bit(toSquare(fileOf(s) - 1, y));
+						if (fileOf(s) < 7) pawnAttackSpan[side][s] |= bit(toSquare(fileOf(s) + 1, y));
+					}
+					passedSpan[side][s] = forwardFile[side][s] | pawnAttackSpan[side][s];
+				}
+
+				constexpr int jumps[8][2] = { { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 }, { -1, -2 }, { -2, -1 }, { -2, 1 }, { -1, 2 } };
+				for (auto& j : jumps)
+				{
+					int x = fileOf(s) + j[0], y = rankOf(s) + j[1];
+					if (x >= 0 && x < 8 && y >= 0 && y < 8)
+						knightAttacks[s] |= bit(toSquare(x, y));
+				}
+
+				for (int d = 0; d < 8; ++d)
+				{
+					for (int x = fileOf(s) + RayDx[d], y = rankOf(s) + RayDy[d]; x >= 0 && x < 8 && y >= 0 && y < 8; x += RayDx[d], y += RayDy[d])
+						rays[d][s] |= bit(toSquare(x, y));
+				}
+			}
+		}
+	};
+
+	inline constexpr Masks masks{};
+
+	/// <summary>
+	/// ,     :       
+	/// (      )
+	/// </summary>
+	/// <param name="s"> </param>
+	/// <param name="first">  ( 0 -   , 1 -  )</param>
+	/// <param name="step">   ( 1 - , 2 -    )</param>
+	/// <param name="occupied">  </param>
+	inline Bitboard slidingAttacks(Square s, int first, int step, Bitboard occupied)
+	{
+		Bitboard res = 0;
+		for (int d = first; d < 8; d += step)
+		{
+			Bitboard ray = masks.rays[d][s];
+			if (Bitboard blockers = ray & occupied)
+			{
+				Square b = d < 4 ? lsb(blockers) : msb(blockers);
+				ray ^= masks.rays[d][b];
+			}
+			res |= ray;
+		}
+		return res;
+	}
+}
@@ -0,0 +1,181 @@
+#include "Book.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace engine
+{
+	namespace
+	{
+		constexpr size_t EntrySize = 16;
+
+		constexpr int CastlingOffset = 768;
+		constexpr int PassingOffset  = 772;
+		constexpr int TurnOffset     = 780;
+
+		/// <summary>
+		///       Random64 (    Polyglot )
+		/// </summary>
+		constexpr uint64_t StartKey = 0x463B96181691FC9C;
+
+		uint64_t readBigEndian(const std::byte* p, int bytes)
+		{
+			uint64_t v = 0;
+			for (int i = 0; i < bytes; ++i)
+				v = (v << 8) | uint64_t(p[i]);
+			return v;
+		}
+
+		/// <summary>
+		///     :      
+		/// </summary>
+		std::mutex openedMutex;
+		std::map<std::string, std::weak_ptr<const PolyglotBook>> opened;
+	}
+
+	std::shared_ptr<const PolyglotBook> PolyglotBook::open(const std::string& path, const std::string& randomPath)
+	{
+		std::lock_guard lock(openedMutex);
+		if (auto book = opened[path].lock())
+			return book;
+
+		std::shared_ptr<PolyglotBook> book(new PolyglotBook());
+		book->file = core::MappedFile(path);
+		if (book->file.size() % EntrySize != 0)
+			throw std::runtime_error("book: " + path + " is not a Polyglot book");
+		book->entryCount = book->file.size() / EntrySize;
+
+		auto keysPath = randomPath;
+		if (keysPath.empty())
+		{
+			auto slash = path.find_last_of("/\\");
+			keysPath = (slash == std::string::npos ? "" : path.substr(0, slash + 1)) + "polyglot-random.bin";
+		}
+		book->randomFile = core::MappedFile(keysPath);
+		if (book->randomFile.size() != RandomCount * sizeof(uint64_t))
+			throw std::runtime_error("book: " + keysPath + " is not a Polyglot Random64 table");
+
+		//     ,       :    
+		if (book->key(Position::fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")) != StartKey)
+			throw std::runtime_error("book: " + keysPath + " is not the standard Polyglot Random64 table");
+
+		opened[path] = book;
+		return book;
+	}
+
+	uint64_t PolyglotBook::random(int index) const
+	{
+		return readBigEndian(randomFile.data() + index * sizeof(uint64_t), 8);
+	}
+
+	uint64_t PolyglotBook::key(const Position& pos) const
+	{
+		uint64_t k = 0;
+		for (Square s = 0; s < 64; ++s)
+		{
+			auto p = pos.at(s);
+			if (p == NoPiece)
+				continue;
+			//   Polyglot :  ,  ,  , ...
+			int kind = (typeOf(p) - Pawn) * 2 + (sideOf(p) == chess::Side::White);
+			k ^= random(64 * kind + s);
+		}
+
+		constexpr uint8_t castlingOrder[] = { WhiteKingside, WhiteQueenside, BlackKingside, BlackQueenside };
+		for (int i = 0; i < 4; ++i)
+		{
+			if (pos.getCastling() & castlingOrder[i])
+				k ^= random(CastlingOffset + i);
+		}
+
+		//    ,     ,   
+		if (pos.getPassing() != NoSquare)
+		{
+			Square target = pos.getPassing();
+			int pawnRank = rankOf(target) + (pos.getSide() == chess::Side::White ? -1 : 1);
+			auto pawn = makePiece(pos.getSide(), Pawn);
+			bool capturable = false;
+			for (int dx : { -1, 1 })
+			{
+				int x = fileOf(target) + dx;
+				if (x >= 0 && x < 8 && pos.at(toSquare(x, pawnRank)) == pawn)
+					capturable = true;
+			}
+			if (capturable)
+				k ^= random(PassingOffset + fileOf(target));
+		}
+
+		if (pos.getSide() == chess::Side::White)
+			k ^= random(TurnOffset);
+		return k;
+	}
+
+	std::vector<BookMove> PolyglotBook::lookup(Position& pos) const
+	{
+		std::vector<BookMove> res;
+		uint64_t k = key(pos);
+
+		//       -     
+		size_t lo = 0, hi = entryCount;
+		while (lo < hi)
+		{
+			size_t mid = (lo + hi) / 2;
+			if (readBigEndian(file.data() + mid * EntrySize, 8) < k)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		MoveList legal;
+		pos.generateLegalMoves(legal);
+
+		for (size_t i = lo; i < entryCount; ++i)
+		{
+			auto entry = file.data() + i * EntrySize;
+			if (readBigEndian(entry, 8) != k)
+				break;
+
+			auto raw = int(readBigEndian(entry + 8, 2));
+			int weight = int(readBigEndian(entry + 10, 2));
+			Square to = toSquare(raw & 7, (raw >> 3) & 7);
+			Square from = toSquare((raw >> 6) & 7, (raw >> 9) & 7);
+			int promotion = (raw >> 12) & 7;
+
+			//   Polyglot   "   "
+			if (typeOf(pos.at(from)) == King && sideOf(pos.at(to)) == pos.getSide() && pos.at(to) != NoPiece)
+				to = fileOf(to) > fileOf(from) ? from + 2 : from - 2;
+
+			auto it = std::find_if(legal.begin(), legal.end(), [&](Move m)
+			{
+				return m.from() == from && m.to() == to &&
+					   m.promotionType() == (promotion == 0 ? NoType : PieceType(Pawn + promotion));
+			});
+			if (it != legal.end())
+				res.push_back({ *it, weight });
+		}
+		return res;
+	}
+
+	Move PolyglotBook::pick(Position& pos, uint32_t random) const
+	{
+		auto moves = lookup(pos);
+		int total = 0;
+		for (auto& m : moves)
+			total += m.weight;
+		if (moves.empty())
+			return {};
+		if (total == 0)
+			return moves[random % moves.size()].move;
+
+		int r = int(random % uint32_t(total));
+		for (auto& m : moves)
+		{
+			if (r < m.weight)
+				return m.move;
+			r -= m.weight;
+		}
+		return moves.back().move;
+	}
+}
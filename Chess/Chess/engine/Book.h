@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine
+{
+	/// <summary>
+	///       
+	/// </summary>
+	struct BookMove
+	{
+		Move move;
+		int weight;
+	};
+
+	/// <summary>
+	///     Polyglot ( .bin ),   .
+	///     :  -     { , , , learn }.
+	///     ,   ,   
+	/// </summary>
+	class PolyglotBook
+	{
+	public:
+		/// <summary>
+		///   Polyglot : 12  x 64 , 4 , 8    ,  
+		/// </summary>
+		static constexpr int RandomCount = 781;
+
+		/// <summary>
+		///   (     )
+		/// </summary>
+		/// <param name="path">  .bin </param>
+		/// <param name="randomPath">    Polyglot Random64
+		/// ( 781 , 8  big-endian ) [  - polyglot-random.bin    ]</param>
+		/// <returns> [  -      :      ]</returns>
+		static std::shared_ptr<const PolyglotBook> open(const std::string& path, const std::string& randomPath = "");
+
+		/// <summary>
+		///     Polyglot
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <returns></returns>
+		uint64_t key(const Position& pos) const;
+
+		/// <summary>
+		///      (   )
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <returns>  </returns>
+		std::vector<BookMove> lookup(Position& pos) const;
+
+		/// <summary>
+		///   ,  
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="random"> </param>
+		/// <returns> [   -      ]</returns>
+		Move pick(Position& pos, uint32_t random) const;
+
+		size_t size() const { return entryCount; }
+
+	private:
+		PolyglotBook() = default;
+
+		core::MappedFile file;
+		core::MappedFile randomFile;
+		size_t entryCount = 0;
+
+		uint64_t random(int index) const;
+	};
+}
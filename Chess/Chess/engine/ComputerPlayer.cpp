@@ -0,0 +1,183 @@
+#include "ComputerPlayer.h"
+
+#include "../chess/BoardState.h"
+#include "../chess/Piece.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+
+namespace engine
+{
+	namespace
+	{
+		constexpr size_t HashMb = 16;
+	}
+
+	ComputerPlayer::ComputerPlayer() : rng(std::random_device{}())
+	{
+		limits.movetimeMs = 1000;
+		searcher.options.table = std::make_shared<TranspositionTable>(HashMb);
+	}
+
+	ComputerPlayer::~ComputerPlayer()
+	{
+		cancelMove();
+		stopPondering();
+	}
+
+	chess::FullMove ComputerPlayer::findMove(const chess::BoardState& state)
+	{
+		cancelMove();
+		auto pos = Position::fromState(state);
+		auto ponder = endPondering(pos);
+		return chooseMove(pos, state, ponder);
+	}
+
+	void ComputerPlayer::findMoveAsync(const chess::BoardState& state, std::function<void(chess::FullMove)> onFound)
+	{
+		cancelMove();
+		auto pos = Position::fromState(state);
+		auto ponder = endPondering(pos);
+
+		searchStop = false;
+		searchThread = std::thread([this, pos, state, ponder, onFound = std::move(onFound)]() mutable
+		{
+			auto m = chooseMove(pos, state, ponder);
+			if (!searchStop)
+				onFound(m);
+		});
+	}
+
+	void ComputerPlayer::cancelMove()
+	{
+		if (!searchThread.joinable())
+			return;
+		searchStop = true;
+		searchThread.join();
+	}
+
+	ComputerPlayer::PonderOutcome ComputerPlayer::endPondering(const Position& pos)
+	{
+		//      :      
+		PonderOutcome res;
+		if (isPondering())
+		{
+			res.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - ponderStart).count();
+			stopPondering();
+			res.hit = pos.getKey() == ponderKey;
+			++(res.hit ? ponderStats.hits : ponderStats.misses);
+		}
+		expectedReply = {};
+		return res;
+	}
+
+	chess::FullMove ComputerPlayer::chooseMove(Position& pos, const chess::BoardState& state, PonderOutcome ponder)
+	{
+
+		auto accepted = acceptedMoves(pos, state);
+		if (accepted.empty())
+			return { chess::Pos::Invalid, chess::Pos::Invalid };
+
+		if (book)
+		{
+			auto m = book->pick(pos, rng());
+			if (!m.isNone() && std::find(accepted.begin(), accepted.end(), m) != accepted.end())
+				return m.toFullMove();
+		}
+
+		if (tablebase)
+		{
+			auto m = tablebase->bestMove(pos);
+			if (!m.isNone() && std::find(accepted.begin(), accepted.end(), m) != accepted.end())
+				return m.toFullMove();
+		}
+
+		auto searchLimits = limits;
+		searchLimits.searchMoves = accepted;
+		searchLimits.stop = &searchStop;
+		if (ponder.hit)
+		{
+			//         :    -  ,
+			//        
+			auto& pondered = ponderResult;
+			bool enough = (limits.movetimeMs != 0 && ponder.elapsedMs >= limits.movetimeMs) || pondered.depth >= limits.depth;
+			if (enough && std::find(accepted.begin(), accepted.end(), pondered.best) != accepted.end())
+			{
+				++ponderStats.instant;
+				if (pondered.pv.size() > 1)
+					expectedReply = pondered.pv[1];
+				return pondered.best.toFullMove();
+			}
+			if (limits.movetimeMs != 0)
+				searchLimits.movetimeMs = std::max(limits.movetimeMs - ponder.elapsedMs, limits.movetimeMs / 4);
+		}
+		else
+		{
+			searcher.options.table->newSearch();
+		}
+
+		auto result = searcher.search(pos, searchLimits);
+		if (result.pv.size() > 1)
+			expectedReply = result.pv[1];
+		return (result.best.isNone() ? accepted.front() : result.best).toFullMove();
+	}
+
+	bool ComputerPlayer::startPondering(const chess::BoardState& state)
+	{
+		cancelMove();
+		stopPondering();
+		if (expectedReply.isNone())
+			return false;
+
+		auto pos = Position::fromState(state);
+		auto accepted = acceptedMoves(pos, state);
+		if (std::find(accepted.begin(), accepted.end(), expectedReply) == accepted.end())
+			return false;
+
+		Undo undo;
+		pos.makeMove(expectedReply, undo);
+		MoveList legal;
+		pos.generateLegalMoves(legal);
+		if (legal.empty())
+			return false;
+
+		ponderKey = pos.getKey();
+		ponderResult = {};
+		ponderStop = false;
+		searcher.options.table->newSearch();
+		ponderStart = std::chrono::steady_clock::now();
+		ponderThread = std::thread([this, pos]() mutable
+		{
+			core::lowerThreadPriority();
+			SearchLimits ponderLimits;
+			ponderLimits.stop = &ponderStop;
+			ponderResult = searcher.search(pos, ponderLimits);
+		});
+		return true;
+	}
+
+	void ComputerPlayer::stopPondering()
+	{
+		if (!ponderThread.joinable())
+			return;
+		ponderStop = true;
+		ponderThread.join();
+	}
+
+	std::vector<Move> ComputerPlayer::acceptedMoves(Position& pos, const chess::BoardState& state)
+	{
+		MoveList legal;
+		pos.generateLegalMoves(legal);
+		std::vector<Move> accepted;
+		std::vector<chess::Move> valid;
+		for (auto m : legal)
+		{
+			auto from = toPos(m.from()), to = toPos(m.to());
+			valid.clear();
+			state.at(from)->getValidMoves(from, state, valid);
+			if (std::any_of(valid.begin(), valid.end(), [to](chess::Move v) { return v.pos == to; }))
+				accepted.push_back(m);
+		}
+		return accepted;
+	}
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Book.h"
+#include "Search.h"
+#include "Tablebase.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace chess
+{
+	class BoardState;
+}
+
+namespace engine
+{
+	/// <summary>
+	/// -    :       ,  
+	/// </summary>
+	class ComputerPlayer
+	{
+	public:
+		SearchLimits limits;
+
+		/// <summary>
+		///     
+		/// </summary>
+		struct PonderStats
+		{
+			/// <summary>
+			///    
+			/// </summary>
+			uint64_t hits = 0;
+
+			/// <summary>
+			///   :  ,   
+			/// </summary>
+			uint64_t instant = 0;
+
+			/// <summary>
+			///     :  
+			/// </summary>
+			uint64_t misses = 0;
+		};
+
+		ComputerPlayer();
+
+		/// <summary>
+		///     
+		/// </summary>
+		~ComputerPlayer();
+
+		ComputerPlayer(const ComputerPlayer&) = delete;
+		ComputerPlayer& operator=(const ComputerPlayer&) = delete;
+
+		/// <summary>
+		///    [ nullptr -   ]
+		/// </summary>
+		/// <param name="val"></param>
+		void setBook(std::shared_ptr<const PolyglotBook> val) { book = std::move(val); }
+
+		/// <summary>
+		///    [ nullptr -   ]
+		/// </summary>
+		/// <param name="val"></param>
+		void setTablebase(std::shared_ptr<const tb::Tablebase> val) { tablebase = std::move(val); }
+
+		/// <summary>
+		///      .
+		///       :      
+		/// </summary>
+		void newGame()
+		{
+			cancelMove();
+			stopPondering();
+			expectedReply = {};
+			searcher.newGame();
+			searcher.options.table->clear();
+		}
+
+		/// <summary>
+		///     .
+		///   ,     ( Piece::getValidMoves )
+		/// </summary>
+		/// <param name="state"> </param>
+		/// <returns> [ from == Pos::Invalid -    ]</returns>
+		chess::FullMove findMove(const chess::BoardState& state);
+
+		/// <summary>
+		///     ,  findMove().   ,   .
+		///   ,         ,   
+		/// </summary>
+		/// <param name="state">  [  ]</param>
+		/// <param name="onFound">      
+		/// [  ,      ]</param>
+		void findMoveAsync(const chess::BoardState& state, std::function<void(chess::FullMove)> onFound);
+
+		/// <summary>
+		///       
+		/// </summary>
+		void cancelMove();
+
+		/// <summary>
+		///      :     (   
+		///    )        ,
+		///     .  findMove()   
+		///   
+		/// </summary>
+		/// <param name="state">    </param>
+		/// <returns>true -    [    -       ]</returns>
+		bool startPondering(const chess::BoardState& state);
+
+		/// <summary>
+		///      (      )
+		/// </summary>
+		void stopPondering();
+
+		bool isPondering() const { return ponderThread.joinable(); }
+
+		const PonderStats& getPonderStats() const { return ponderStats; }
+
+		/// <summary>
+		///  ,     ( Piece::getValidMoves ) :
+		///      ( ,    )
+		/// </summary>
+		/// <param name="pos"> </param>
+		/// <param name="state">   </param>
+		/// <returns> </returns>
+		static std::vector<Move> acceptedMoves(Position& pos, const chess::BoardState& state);
+
+	private:
+		/// <summary>
+		///     
+		/// </summary>
+		struct PonderOutcome
+		{
+			bool hit = false;
+			int64_t elapsedMs = 0;
+		};
+		std::shared_ptr<const PolyglotBook> book;
+		std::shared_ptr<const tb::Tablebase> tablebase;
+		Searcher searcher;
+		std::mt19937 rng;
+
+		/// <summary>
+		///        [  -  ]
+		/// </summary>
+		Move expectedReply;
+
+		/// <summary>
+		///   :   ,   
+		/// </summary>
+		std::thread ponderThread;
+		std::atomic<bool> ponderStop = false;
+		uint64_t ponderKey = 0;
+		SearchResult ponderResult;
+		std::chrono::steady_clock::time_point ponderStart;
+		PonderStats ponderStats;
+
+		/// <summary>
+		///     :   ,   
+		/// </summary>
+		std::thread searchThread;
+		std::atomic<bool> searchStop = false;
+
+		/// <summary>
+		///      ,    
+		/// </summary>
+		/// <param name="pos">,    </param>
+		/// <returns> </returns>
+		PonderOutcome endPondering(const Position& pos);
+
+		/// <summary>
+		///   : , ,    
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="state">   </param>
+		/// <param name="ponder"> </param>
+		/// <returns> [ from == Pos::Invalid -    ]</returns>
+		chess::FullMove chooseMove(Position& pos, const chess::BoardState& state, PonderOutcome ponder);
+	};
+}
@@ -0,0 +1,364 @@
+#include "Datagen.h"
+
+#include "Search.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace engine::datagen
+{
+	namespace
+	{
+		/// <summary>
+		///          ,    
+		/// </summary>
+		constexpr size_t FlushBytes = 1 << 20;
+
+		/// <summary>
+		///       :    ,  7   
+		/// </summary>
+		void putVarint(std::vector<uint8_t>& out, int value)
+		{
+			uint32_t v = value < 0 ? (uint32_t(-int64_t(value)) << 1) - 1 : uint32_t(value) << 1;
+			while (v >= 0x80)
+			{
+				out.push_back(uint8_t(v | 0x80));
+				v >>= 7;
+			}
+			out.push_back(uint8_t(v));
+		}
+
+		bool getVarint(const uint8_t*& p, const uint8_t* end, int& value)
+		{
+			uint32_t v = 0;
+			for (int shift = 0; p < end && shift < 35; shift += 7)
+			{
+				uint8_t b = *p++;
+				v |= uint32_t(b & 0x7F) << shift;
+				if (!(b & 0x80))
+				{
+					value = (v & 1) ? -int(v >> 1) - 1 : int(v >> 1);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// <summary>
+		///   :       
+		/// </summary>
+		struct Worker
+		{
+			Searcher searcher;
+			std::vector<uint8_t> moves;
+			std::vector<int> scores;
+			std::vector<uint8_t> buffer;
+			Stats stats;
+		};
+
+		/// <summary>
+		///          
+		/// </summary>
+		/// <returns>false -      (    )</returns>
+		bool playGame(Worker& w, const Options& options, std::mt19937_64& rng)
+		{
+			w.moves.clear();
+			w.scores.clear();
+			w.searcher.newGame();
+			w.searcher.options.table->clear();
+
+			SearchLimits limits;
+			limits.nodes = options.nodes;
+
+			auto pos = Position::startPosition();
+			MoveList legal;
+			Undo undo;
+			int randomPlies = std::clamp(options.randomPlies, 0, 255);
+			for (int i = 0; i < randomPlies; ++i)
+			{
+				pos.generateLegalMoves(legal);
+				if (legal.count == 0)
+					return false;
+				int index = int(rng() % uint64_t(legal.count));
+				w.moves.push_back(uint8_t(index));
+				pos.makeMove(legal[index], undo);
+			}
+
+			auto result = archive::Result::Draw;
+			int streak = 0;
+			int maxPlies = std::clamp(options.maxPlies, randomPlies + 1, 0xFFFF);
+			while (int(w.moves.size()) < maxPlies)
+			{
+				pos.generateLegalMoves(legal);
+				if (legal.count == 0)
+				{
+					if (pos.inCheck())
+						result = pos.getSide() == chess::Side::White ? archive::Result::BlackWins : archive::Result::WhiteWins;
+					break;
+				}
+				if (pos.getHalfMoveClock() >= 100 || pos.isRepetition())
+					break;
+
+				auto res = w.searcher.search(pos, limits);
+				w.stats.nodes += w.searcher.getStats().nodes;
+				if (res.best.isNone())
+				{
+					//       :     
+					SearchLimits first;
+					first.depth = 1;
+					res = w.searcher.search(pos, first);
+				}
+				int index = int(std::find(legal.begin(), legal.begin() + legal.count, res.best) - legal.begin());
+				if (index == legal.count)
+					return false;
+
+				int whiteScore = pos.getSide() == chess::Side::White ? res.score : -res.score;
+				w.scores.push_back(whiteScore);
+				w.moves.push_back(uint8_t(index));
+				pos.makeMove(res.best, undo);
+
+				//   :     
+				if (std::abs(whiteScore) >= options.resignScore)
+				{
+					if (++streak >= options.resignPlies)
+					{
+						result = whiteScore > 0 ? archive::Result::WhiteWins : archive::Result::BlackWins;
+						break;
+					}
+				}
+				else
+				{
+					streak = 0;
+				}
+			}
+			if (w.scores.empty())
+				return false;
+
+			GameHeader header{ uint16_t(w.moves.size()), uint8_t(randomPlies), result };
+			auto* bytes = reinterpret_cast<const uint8_t*>(&header);
+			w.buffer.insert(w.buffer.end(), bytes, bytes + sizeof(header));
+			w.buffer.insert(w.buffer.end(), w.moves.begin(), w.moves.end());
+			int previous = 0;
+			for (int s : w.scores)
+			{
+				putVarint(w.buffer, s - previous);
+				previous = s;
+			}
+			++w.stats.games;
+			w.stats.positions += w.scores.size();
+			return true;
+		}
+
+		/// <summary>
+		///     ,      
+		/// </summary>
+		bool readHeader(const uint8_t*& p, const uint8_t* end, GameHeader& header)
+		{
+			if (size_t(end - p) < sizeof(GameHeader))
+				return false;
+			std::memcpy(&header, p, sizeof(header));
+			p += sizeof(header);
+			return header.openingPlies < header.plies && size_t(end - p) >= header.plies &&
+				   header.result != archive::Result::Unknown && header.result <= archive::Result::Draw;
+		}
+
+		bool skipGame(const uint8_t*& p, const uint8_t* end)
+		{
+			GameHeader header;
+			if (!readHeader(p, end, header))
+				return false;
+			p += header.plies;
+			for (int i = header.openingPlies; i < header.plies; ++i)
+			{
+				int delta;
+				if (!getVarint(p, end, delta))
+					return false;
+			}
+			return true;
+		}
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <returns>false -      </returns>
+		bool readGame(const uint8_t*& p, const uint8_t* end, const Position& start,
+			          const std::function<void(const Record&)>& onRecord, uint64_t& count)
+		{
+			GameHeader header;
+			if (!readHeader(p, end, header))
+				return false;
+			const uint8_t* moves = p;
+			p += header.plies;
+
+			auto pos = start;
+			MoveList legal;
+			Undo undo;
+			int score = 0;
+			for (int i = 0; i < header.plies; ++i)
+			{
+				pos.generateLegalMoves(legal);
+				if (moves[i] >= legal.count)
+					return false;
+				auto m = legal[moves[i]];
+				if (i >= header.openingPlies)
+				{
+					int delta;
+					if (!getVarint(p, end, delta))
+						return false;
+					score += delta;
+					onRecord({ pos, m, score, header.result });
+					++count;
+				}
+				pos.makeMove(m, undo);
+			}
+			return true;
+		}
+
+		bool checkHeader(const std::byte* data, size_t size)
+		{
+			FileHeader header;
+			if (size < sizeof(header))
+				return false;
+			std::memcpy(&header, data, sizeof(header));
+			return std::memcmp(header.magic, Magic, 4) == 0 && header.version == FormatVersion;
+		}
+	}
+
+	Stats generate(const std::string& path, const Options& options)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+
+		//    :     
+		bool exists = false;
+		{
+			std::ifstream probe(path, std::ios::binary | std::ios::ate);
+			if (probe && probe.tellg() > 0)
+			{
+				FileHeader header{};
+				probe.seekg(0);
+				probe.read(reinterpret_cast<char*>(&header), sizeof(header));
+				if (!checkHeader(reinterpret_cast<const std::byte*>(&header), size_t(probe.gcount())))
+					throw std::runtime_error("datagen: " + path + " is not a training data file");
+				exists = true;
+			}
+		}
+		std::ofstream file(path, std::ios::binary | std::ios::app);
+		if (!file)
+			throw std::runtime_error("datagen: cannot write " + path);
+		if (!exists)
+		{
+			FileHeader header{};
+			std::memcpy(header.magic, Magic, 4);
+			header.version = FormatVersion;
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+
+		int threads = int(std::clamp<uint64_t>(uint64_t(std::max(options.threads, 1)), 1, std::max<uint64_t>(options.games, 1)));
+		std::vector<std::unique_ptr<Worker>> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.push_back(std::make_unique<Worker>());
+			workers.back()->searcher.options.table = std::make_shared<TranspositionTable>(options.hashMegabytes);
+		}
+
+		std::mutex fileLock;
+		std::atomic<uint64_t> nextGame = 0;
+		auto flush = [&](Worker& w)
+		{
+			std::lock_guard guard(fileLock);
+			file.write(reinterpret_cast<const char*>(w.buffer.data()), std::streamsize(w.buffer.size()));
+			w.stats.bytes += w.buffer.size();
+			w.buffer.clear();
+		};
+
+		auto work = [&](int t)
+		{
+			auto& w = *workers[t];
+			while (!(options.stop && options.stop->load(std::memory_order_relaxed)))
+			{
+				uint64_t game = nextGame.fetch_add(1, std::memory_order_relaxed);
+				if (game >= options.games)
+					break;
+
+				//    ,    :     seed    
+				std::mt19937_64 rng(options.seed * 0x9E3779B97F4A7C15ull + game);
+				while (!playGame(w, options, rng))
+					;
+				if (w.buffer.size() >= FlushBytes)
+					flush(w);
+			}
+			flush(w);
+		};
+
+		std::vector<std::thread> pool;
+		for (int t = 1; t < threads; ++t)
+			pool.emplace_back(work, t);
+		work(0);
+		for (auto& th : pool)
+			th.join();
+
+		file.flush();
+		if (!file)
+			throw std::runtime_error("datagen: write failed " + path);
+
+		Stats total;
+		for (auto& w : workers)
+		{
+			total.games += w->stats.games;
+			total.positions += w->stats.positions;
+			total.bytes += w->stats.bytes;
+			total.nodes += w->stats.nodes;
+		}
+		total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return total;
+	}
+
+	Reader::Reader(const std::string& path) : file(path)
+	{
+		if (!checkHeader(file.data(), file.size()))
+			throw std::runtime_error("datagen: " + path + " is not a training data file");
+	}
+
+	uint64_t Reader::forEach(const std::function<void(const Record&)>& onRecord) const
+	{
+		auto* p = reinterpret_cast<const uint8_t*>(file.data()) + sizeof(FileHeader);
+		auto* end = reinterpret_cast<const uint8_t*>(file.data()) + file.size();
+		uint64_t count = 0;
+		auto start = Position::startPosition();
+		while (readGame(p, end, start, onRecord, count))
+			;
+		return count;
+	}
+
+	uint64_t Reader::forEach(int threads, const std::function<void(const Record&, int thread)>& onRecord) const
+	{
+		//   :  ,  -     
+		auto* p = reinterpret_cast<const uint8_t*>(file.data()) + sizeof(FileHeader);
+		auto* end = reinterpret_cast<const uint8_t*>(file.data()) + file.size();
+		std::vector<const uint8_t*> games;
+		for (auto* game = p; skipGame(p, end); game = p)
+			games.push_back(game);
+
+		std::vector<uint64_t> counts(size_t(std::max(threads, 1)), 0);
+		auto start = Position::startPosition();
+		core::parallelFor(games.size(), threads, [&](size_t index, int t)
+		{
+			auto* g = games[index];
+			readGame(g, end, start, [&](const Record& r) { onRecord(r, t); }, counts[t]);
+		});
+
+		uint64_t total = 0;
+		for (auto c : counts)
+			total += c;
+		return total;
+	}
+}
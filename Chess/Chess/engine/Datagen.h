@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Archive.h"
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace engine::datagen
+{
+	/// <summary>
+	///     ( little-endian )
+	/// </summary>
+	struct FileHeader
+	{
+		char     magic[4];
+		uint32_t version;
+	};
+
+	constexpr char     Magic[4]      = { 'C', 'B', 'P', 'K' };
+	constexpr uint32_t FormatVersion = 1;
+
+	/// <summary>
+	///     :   ( uint16_t ),      ( uint8_t ),
+	///  ( archive::Result ),     -       (   ),
+	///       :     (     )
+	///    ( 7   ,     ).
+	///      ,     2 - 3 
+	/// </summary>
+	struct GameHeader
+	{
+		uint16_t plies;
+		uint8_t  openingPlies;
+		archive::Result result;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Record
+	{
+		const Position& pos;
+
+		/// <summary>
+		/// ,  
+		/// </summary>
+		Move played;
+
+		/// <summary>
+		///      
+		/// </summary>
+		int score;
+
+		archive::Result result;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Options
+	{
+		/// <summary>
+		///   :     
+		/// </summary>
+		int threads = 1;
+
+		/// <summary>
+		///  
+		/// </summary>
+		uint64_t games = 1000;
+
+		/// <summary>
+		///     :         
+		/// </summary>
+		uint64_t nodes = 5000;
+
+		/// <summary>
+		///      (   ),    
+		/// </summary>
+		int randomPlies = 8;
+
+		/// <summary>
+		///       
+		/// </summary>
+		int maxPlies = 400;
+
+		/// <summary>
+		///  :    resignScore     resignPlies  
+		/// </summary>
+		int resignScore = 2500;
+		int resignPlies = 4;
+
+		/// <summary>
+		///    , 
+		/// </summary>
+		size_t hashMegabytes = 8;
+
+		/// <summary>
+		///     :         
+		/// </summary>
+		uint64_t seed = 1;
+
+		/// <summary>
+		///    [ nullptr -  ] :     
+		/// </summary>
+		const std::atomic<bool>* stop = nullptr;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Stats
+	{
+		uint64_t games = 0;
+		uint64_t positions = 0;
+		uint64_t bytes = 0;
+		uint64_t nodes = 0;
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///          :     
+	///       .  ,   
+	/// </summary>
+	/// <param name="path">  </param>
+	/// <param name="options"></param>
+	/// <returns> </returns>
+	/// <exception cref="std::runtime_error">      </exception>
+	Stats generate(const std::string& path, const Options& options);
+
+	/// <summary>
+	///   ,   
+	/// </summary>
+	class Reader
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="path">  </param>
+		/// <exception cref="std::runtime_error">  </exception>
+		explicit Reader(const std::string& path);
+
+		/// <summary>
+		///      
+		/// </summary>
+		/// <param name="onRecord">   </param>
+		/// <returns>  [      ]</returns>
+		uint64_t forEach(const std::function<void(const Record&)>& onRecord) const;
+
+		/// <summary>
+		///       :    ,
+		///         
+		/// </summary>
+		/// <param name="threads"> </param>
+		/// <param name="onRecord">    (    )</param>
+		/// <returns> </returns>
+		uint64_t forEach(int threads, const std::function<void(const Record&, int thread)>& onRecord) const;
+
+	private:
+		core::MappedFile file;
+	};
+}
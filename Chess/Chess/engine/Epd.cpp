@@ -0,0 +1,317 @@
+#include "Epd.h"
+
+#include "San.h"
+#include "Search.h"
+#include "../core/MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+
+namespace engine::epd
+{
+	namespace
+	{
+		std::string_view trim(std::string_view s)
+		{
+			while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+				s.remove_prefix(1);
+			while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r'))
+				s.remove_suffix(1);
+			return s;
+		}
+
+		/// <summary>
+		///    (    )
+		/// </summary>
+		std::string_view nextWord(std::string_view& s)
+		{
+			s = trim(s);
+			auto end = std::min(s.find_first_of(" \t"), s.size());
+			auto word = s.substr(0, end);
+			s.remove_prefix(end);
+			return word;
+		}
+
+		/// <summary>
+		///   SAN  
+		/// </summary>
+		Move parseMove(Position& pos, std::string_view text)
+		{
+			if (auto m = san::parse(pos, text); !m.isNone())
+				return m;
+			auto full = chess::FullMove::fromString(text);
+			return full.from.isValid() ? pos.findMove(full) : Move();
+		}
+
+		std::string toSan(const std::string& fen, Move m)
+		{
+			if (m.isNone())
+				return "-";
+			auto pos = Position::fromFEN(fen);
+			char buffer[san::BufferSize];
+			san::write(pos, m, buffer);
+			return buffer;
+		}
+
+		void writeJsonString(std::ostream& out, std::string_view s)
+		{
+			out << '"';
+			for (char c : s)
+			{
+				if (c == '"' || c == '\\')
+					out << '\\' << c;
+				else if (static_cast<unsigned char>(c) < 0x20)
+					out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+				else
+					out << c;
+			}
+			out << '"';
+		}
+	}
+
+	bool Record::isSolution(Move m) const
+	{
+		if (m.isNone())
+			return false;
+		if (std::find(avoidMoves.begin(), avoidMoves.end(), m) != avoidMoves.end())
+			return false;
+		return bestMoves.empty() || std::find(bestMoves.begin(), bestMoves.end(), m) != bestMoves.end();
+	}
+
+	std::vector<Record> parse(std::string_view text)
+	{
+		std::vector<Record> records;
+		size_t lineNumber = 0;
+		while (!text.empty())
+		{
+			auto end = std::min(text.find('\n'), text.size());
+			auto line = trim(text.substr(0, end));
+			text.remove_prefix(std::min(end + 1, text.size()));
+			++lineNumber;
+			if (line.empty() || line.front() == '#')
+				continue;
+
+			auto error = [&](std::string_view what)
+			{
+				return std::invalid_argument("epd: line " + std::to_string(lineNumber) + ": " + std::string(what));
+			};
+
+			Record r;
+			r.line = lineNumber;
+			for (int i = 0; i < 4; ++i)
+			{
+				auto field = nextWord(line);
+				if (field.empty())
+					throw error("incomplete FEN");
+				r.fen += i == 0 ? "" : " ";
+				r.fen += field;
+			}
+			auto pos = Position::fromFEN(r.fen);
+
+			//  : "  ... ;" [        ';' ]
+			while (!(line = trim(line)).empty())
+			{
+				auto opcode = nextWord(line);
+				std::vector<std::string_view> operands;
+				for (line = trim(line); !line.empty() && line.front() != ';'; line = trim(line))
+				{
+					if (line.front() == '"')
+					{
+						auto close = line.find('"', 1);
+						if (close == std::string_view::npos)
+							throw error("unterminated string");
+						operands.push_back(line.substr(1, close - 1));
+						line.remove_prefix(close + 1);
+					}
+					else
+					{
+						auto stop = std::min(line.find_first_of(" \t;"), line.size());
+						operands.push_back(line.substr(0, stop));
+						line.remove_prefix(stop);
+					}
+				}
+				if (!line.empty())
+					line.remove_prefix(1);
+
+				if (opcode == "bm" || opcode == "am")
+				{
+					auto& list = opcode == "bm" ? r.bestMoves : r.avoidMoves;
+					r.expected += r.expected.empty() ? "" : " ";
+					r.expected += opcode;
+					for (auto text : operands)
+					{
+						auto m = parseMove(pos, text);
+						if (m.isNone())
+							throw error("invalid move " + std::string(text));
+						list.push_back(m);
+						r.expected += " ";
+						r.expected += text;
+					}
+				}
+				else if (opcode == "id" && !operands.empty())
+				{
+					r.id = operands.front();
+				}
+			}
+
+			if (r.bestMoves.empty() && r.avoidMoves.empty())
+				throw error("no bm or am operation");
+			if (r.id.empty())
+				r.id = std::to_string(records.size() + 1);
+			records.push_back(std::move(r));
+		}
+		return records;
+	}
+
+	std::vector<Record> load(const std::string& path)
+	{
+		core::MappedFile file(path);
+		return parse(file.view());
+	}
+
+	Report run(const std::vector<Record>& records, const RunOptions& options)
+	{
+		using Clock = std::chrono::steady_clock;
+		auto start = Clock::now();
+		int threads = std::clamp(options.threads, 1, std::max(1, int(records.size())));
+
+		Report report;
+		report.options = options;
+		report.results.resize(records.size());
+
+		//     :     
+		std::atomic<size_t> next = 0;
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t)
+		{
+			pool.emplace_back([&]()
+			{
+				Searcher searcher;
+				searcher.options.table = std::make_shared<TranspositionTable>(options.hashMegabytes);
+
+				SearchLimits limits;
+				limits.movetimeMs = options.movetimeMs;
+				limits.nodes = options.nodes;
+
+				for (size_t i; (i = next.fetch_add(1)) < records.size();)
+				{
+					auto& record = records[i];
+					auto& res = report.results[i];
+
+					//       :      
+					searcher.newGame();
+					searcher.options.table->clear();
+
+					auto positionStart = Clock::now();
+					searcher.onIteration = [&](const SearchResult& r)
+					{
+						if (!record.isSolution(r.best))
+						{
+							res.solveMs = -1;
+							res.solveNodes = 0;
+						}
+						else if (res.solveMs < 0)
+						{
+							res.solveMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - positionStart).count();
+							res.solveNodes = searcher.getStats().nodes;
+						}
+					};
+
+					auto pos = Position::fromFEN(record.fen);
+					auto result = searcher.search(pos, limits);
+					res.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - positionStart).count();
+					res.nodes = searcher.getStats().nodes;
+					res.best = result.best;
+					res.score = result.score;
+					res.depth = result.depth;
+					res.solved = record.isSolution(result.best);
+					if (!res.solved)
+					{
+						res.solveMs = -1;
+						res.solveNodes = 0;
+					}
+				}
+			});
+		}
+		for (auto& th : pool)
+			th.join();
+
+		for (auto& r : report.results)
+		{
+			report.solved += r.solved;
+			report.nodes += r.nodes;
+		}
+		report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		return report;
+	}
+
+	void writeTable(std::ostream& out, const std::vector<Record>& records, const Report& report)
+	{
+		out << std::left << std::setw(20) << "id" << std::right
+			<< std::setw(22) << "expected"
+			<< std::setw(9)  << "found"
+			<< std::setw(4)  << "ok"
+			<< std::setw(7)  << "score"
+			<< std::setw(6)  << "depth"
+			<< std::setw(10) << "solve ms"
+			<< std::setw(12) << "nodes"
+			<< std::setw(10) << "knps" << "\n";
+
+		for (size_t i = 0; i < records.size(); ++i)
+		{
+			auto& rec = records[i];
+			auto& res = report.results[i];
+			out << std::left << std::setw(20) << rec.id.substr(0, 19) << std::right
+				<< std::setw(22) << rec.expected.substr(0, 21)
+				<< std::setw(9)  << toSan(rec.fen, res.best)
+				<< std::setw(4)  << (res.solved ? "+" : "-")
+				<< std::setw(7)  << res.score
+				<< std::setw(6)  << res.depth
+				<< std::setw(10) << (res.solved ? std::to_string(res.solveMs) : "-")
+				<< std::setw(12) << res.nodes
+				<< std::setw(10) << (res.elapsedMs > 0 ? res.nodes / uint64_t(res.elapsedMs) : 0) << "\n";
+		}
+
+		out << "solved " << report.solved << " / " << records.size()
+			<< ", " << report.nodes << " nodes in " << std::fixed << std::setprecision(2) << report.seconds << " s"
+			<< " ( " << report.options.threads << " threads, " << report.nps() / 1000 << " knps )" << std::endl;
+	}
+
+	void writeJson(std::ostream& out, const std::vector<Record>& records, const Report& report)
+	{
+		out << "{\n"
+			<< "  \"threads\": " << report.options.threads << ",\n"
+			<< "  \"movetimeMs\": " << report.options.movetimeMs << ",\n"
+			<< "  \"nodesLimit\": " << report.options.nodes << ",\n"
+			<< "  \"total\": " << records.size() << ",\n"
+			<< "  \"solved\": " << report.solved << ",\n"
+			<< "  \"nodes\": " << report.nodes << ",\n"
+			<< "  \"seconds\": " << std::fixed << std::setprecision(3) << report.seconds << ",\n"
+			<< "  \"nps\": " << report.nps() << ",\n"
+			<< "  \"positions\": [";
+
+		for (size_t i = 0; i < records.size(); ++i)
+		{
+			auto& rec = records[i];
+			auto& res = report.results[i];
+			out << (i == 0 ? "\n" : ",\n") << "    { \"id\": ";
+			writeJsonString(out, rec.id);
+			out << ", \"expected\": ";
+			writeJsonString(out, rec.expected);
+			out << ", \"found\": ";
+			writeJsonString(out, toSan(rec.fen, res.best));
+			out << ", \"solved\": " << (res.solved ? "true" : "false")
+				<< ", \"score\": " << res.score
+				<< ", \"depth\": " << res.depth
+				<< ", \"solveMs\": " << res.solveMs
+				<< ", \"solveNodes\": " << res.solveNodes
+				<< ", \"elapsedMs\": " << res.elapsedMs
+				<< ", \"nodes\": " << res.nodes << " }";
+		}
+		out << "\n  ]\n}" << std::endl;
+	}
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Position.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::epd
+{
+	/// <summary>
+	///    : FEN ( 4  )   "bm", "am", "id"
+	/// </summary>
+	struct Record
+	{
+		std::string fen;
+		std::string id;
+
+		/// <summary>
+		///   (  "bm" ) :  -   
+		/// </summary>
+		std::vector<Move> bestMoves;
+
+		/// <summary>
+		/// ,    (  "am" )
+		/// </summary>
+		std::vector<Move> avoidMoves;
+
+		/// <summary>
+		///  "bm"  "am"    (   )
+		/// </summary>
+		std::string expected;
+
+		/// <summary>
+		///     (  1 )
+		/// </summary>
+		size_t line = 0;
+
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="m"> </param>
+		/// <returns>true -    </returns>
+		bool isSolution(Move m) const;
+	};
+
+	/// <summary>
+	///   .    SAN ( "Nxe5+" )   ( "g1f3" ),
+	///      '#'   
+	/// </summary>
+	/// <param name="text">  EPD</param>
+	/// <returns> </returns>
+	/// <exception cref="std::invalid_argument">  FEN,  "bm" / "am"    </exception>
+	std::vector<Record> parse(std::string_view text);
+
+	/// <summary>
+	///     EPD
+	/// </summary>
+	/// <param name="path">  </param>
+	/// <returns> </returns>
+	std::vector<Record> load(const std::string& path);
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct RunOptions
+	{
+		/// <summary>
+		///   :    ,         
+		/// </summary>
+		int threads = 1;
+
+		/// <summary>
+		///   ,  [ 0 -   ]
+		/// </summary>
+		int64_t movetimeMs = 1000;
+
+		/// <summary>
+		///    [ 0 -   ].       
+		/// </summary>
+		uint64_t nodes = 0;
+
+		/// <summary>
+		///    , 
+		/// </summary>
+		size_t hashMegabytes = 16;
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct PositionResult
+	{
+		Move best;
+		int score = 0;
+		int depth = 0;
+		bool solved = false;
+
+		/// <summary>
+		///     ,          [ -1 / 0 -   ]
+		/// </summary>
+		int64_t solveMs = -1;
+		uint64_t solveNodes = 0;
+
+		int64_t elapsedMs = 0;
+		uint64_t nodes = 0;
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct Report
+	{
+		RunOptions options;
+		std::vector<PositionResult> results;
+		size_t solved = 0;
+		uint64_t nodes = 0;
+
+		/// <summary>
+		///    (    ), 
+		/// </summary>
+		double seconds = 0;
+
+		/// <summary>
+		///      
+		/// </summary>
+		uint64_t nps() const { return seconds > 0 ? uint64_t(nodes / seconds) : 0; }
+	};
+
+	/// <summary>
+	///    
+	/// </summary>
+	/// <param name="records"> </param>
+	/// <param name="options"> </param>
+	/// <returns>  (     )</returns>
+	Report run(const std::vector<Record>& records, const RunOptions& options);
+
+	/// <summary>
+	///    :      
+	/// </summary>
+	void writeTable(std::ostream& out, const std::vector<Record>& records, const Report& report);
+
+	/// <summary>
+	///    JSON    
+	/// </summary>
+	void writeJson(std::ostream& out, const std::vector<Record>& records, const Report& report);
+}
@@ -0,0 +1,77 @@
+#include "Evaluate.h"
+
+namespace engine
+{
+	namespace
+	{
+		constexpr int distance(Square a, Square b)
+		{
+			int dx = fileOf(a) - fileOf(b), dy = rankOf(a) - rankOf(b);
+			dx = dx < 0 ? -dx : dx;
+			dy = dy < 0 ? -dy : dy;
+			return dx > dy ? dx : dy;
+		}
+
+		/// <summary>
+		///    :    ,  -   
+		/// </summary>
+		int passedKingProximity(const Position& pos, const PawnEntry& entry, chess::Side us)
+		{
+			auto them = chess::getOtherSide(us);
+			int push = us == chess::Side::White ? 8 : -8;
+			int bonus = 0;
+			for (Bitboard b = entry.passed[(int)us]; b; )
+			{
+				Square stop = popLsb(b) + push;
+				bonus += 5 * distance(pos.getKingSquare(them), stop) - 2 * distance(pos.getKingSquare(us), stop);
+			}
+			return bonus;
+		}
+	}
+
+	std::array<int, 7> mobility(const Position& pos)
+	{
+		//    ,    
+		std::array<int, 7> res = {};
+		for (Bitboard b = pos.getOfficers(); b; )
+		{
+			Square s = popLsb(b);
+			auto p = pos.at(s);
+			auto type = typeOf(p);
+			int n = pos.mobility(s) - MobilityCenter[type];
+			res[type] += sideOf(p) == chess::Side::White ? n : -n;
+		}
+		return res;
+	}
+
+	int evaluate(const Position& pos, PawnTable* pawns)
+	{
+		if (auto net = pos.getNetwork())
+			return net->evaluate(pos);
+
+		//      ,    
+		PawnEntry local;
+		const PawnEntry* entry = &local;
+		if (pawns)
+			entry = &pawns->probe(pos);
+		else
+			PawnTable::compute(pos, local);
+
+		auto psq = pos.getPsq() + entry->score;
+		psq.mg += entry->shelter[0][fileOf(pos.getKingSquare(chess::Side::White))]
+			    - entry->shelter[1][fileOf(pos.getKingSquare(chess::Side::Black))];
+		psq.eg += passedKingProximity(pos, *entry, chess::Side::White)
+			    - passedKingProximity(pos, *entry, chess::Side::Black);
+
+		auto mob = mobility(pos);
+		for (int type = Knight; type <= Queen; ++type)
+		{
+			psq.mg += MobilityMg[type] * mob[type];
+			psq.eg += MobilityEg[type] * mob[type];
+		}
+
+		int phase = pos.getPhase();
+		int score = (psq.mg * phase + psq.eg * (MaxPhase - phase)) / MaxPhase;
+		return pos.getSide() == chess::Side::White ? score : -score;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Pawns.h"
+#include "Position.h"
+
+namespace engine
+{
+	/// <summary>
+	///    :    , ,  ,
+	///    ,  ,     
+	/// </summary>
+	/// <param name="pos"></param>
+	/// <param name="pawns">   [ nullptr -    ]</param>
+	/// <returns>        </returns>
+	int evaluate(const Position& pos, PawnTable* pawns = nullptr);
+
+	/// <summary>
+	///     :  (    - MobilityCenter )     
+	/// </summary>
+	/// <param name="pos"></param>
+	/// <returns> [   ] ( , , ,  )</returns>
+	std::array<int, 7> mobility(const Position& pos);
+}
@@ -0,0 +1,244 @@
+#include "Explorer.h"
+
+#include "Archive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace engine::explorer
+{
+	static_assert(sizeof(FileHeader) == 32 && sizeof(Entry) == 32 && sizeof(MoveStats) == 16);
+
+	namespace
+	{
+		template <typename T>
+		T read(const std::byte* p)
+		{
+			T res;
+			std::memcpy(&res, p, sizeof(T));
+			return res;
+		}
+
+		void addResult(Results& r, archive::Result result)
+		{
+			switch (result)
+			{
+				case archive::Result::WhiteWins: ++r.white; break;
+				case archive::Result::BlackWins: ++r.black; break;
+				default:                         ++r.draws; break;
+			}
+		}
+
+		/// <summary>
+		///   
+		/// </summary>
+		struct Node
+		{
+			Results results;
+			std::vector<MoveStats> moves;
+		};
+
+		using NodeMap = std::unordered_map<uint64_t, Node>;
+
+		/// <summary>
+		///  ,     
+		/// </summary>
+		size_t partOf(uint64_t key, size_t parts) { return size_t(key >> 40) % parts; }
+	}
+
+	Explorer::Explorer(const std::string& path) : file(path)
+	{
+		auto invalid = [&]() { return std::runtime_error("explorer: invalid file " + path); };
+		if (file.size() < sizeof(FileHeader))
+			throw invalid();
+
+		auto header = read<FileHeader>(file.data());
+		if (std::memcmp(header.magic, Magic, 4) != 0 || header.version != FormatVersion ||
+			header.slotCount == 0 || (header.slotCount & (header.slotCount - 1)) != 0 ||
+			sizeof(FileHeader) + header.slotCount * sizeof(Entry) + header.moveCount * sizeof(MoveStats) != file.size())
+			throw invalid();
+
+		slotCount = header.slotCount;
+		moveCount = header.moveCount;
+		maxPly = int(header.maxPly);
+	}
+
+	std::optional<PositionStats> Explorer::lookup(uint64_t key) const
+	{
+		auto slots = file.data() + sizeof(FileHeader);
+		for (uint64_t i = key & (slotCount - 1);; i = (i + 1) & (slotCount - 1))
+		{
+			auto e = read<Entry>(slots + i * sizeof(Entry));
+			if (e.results.games() == 0)
+				return std::nullopt;
+			if (e.key != key)
+				continue;
+			if (uint64_t(e.firstMove) + e.moveCount > moveCount)
+				return std::nullopt;
+
+			PositionStats res;
+			res.results = e.results;
+			res.moves.resize(e.moveCount);
+			std::memcpy(res.moves.data(), slots + slotCount * sizeof(Entry) + e.firstMove * sizeof(MoveStats),
+				        e.moveCount * sizeof(MoveStats));
+			return res;
+		}
+	}
+
+	BuildStats Explorer::build(const std::vector<std::string>& archives, const std::string& path,
+		                       const BuildOptions& options)
+	{
+		auto start = std::chrono::steady_clock::now();
+		int threads = std::max(options.threads, 1);
+
+		std::vector<std::unique_ptr<archive::Reader>> readers;
+		std::vector<size_t> firstGame = { 0 };
+		for (auto& a : archives)
+		{
+			readers.push_back(std::make_unique<archive::Reader>(a));
+			firstGame.push_back(firstGame.back() + readers.back()->size());
+		}
+		size_t totalGames = firstGame.back();
+
+		//         :  p    p
+		constexpr size_t Chunk = 256;
+		std::atomic<size_t> nextGame = 0;
+		std::atomic<uint64_t> games = 0, skipped = 0;
+		std::vector<std::vector<NodeMap>> local(threads, std::vector<NodeMap>(threads));
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t)
+		{
+			pool.emplace_back([&, t]()
+			{
+				auto& parts = local[t];
+				for (size_t begin; (begin = nextGame.fetch_add(Chunk)) < totalGames;)
+				{
+					for (size_t g = begin; g < std::min(begin + Chunk, totalGames); ++g)
+					{
+						size_t a = std::upper_bound(firstGame.begin(), firstGame.end(), g) - firstGame.begin() - 1;
+						auto& reader = *readers[a];
+						size_t game = g - firstGame[a];
+						auto result = reader.entry(game).result;
+						if (result == archive::Result::Unknown)
+						{
+							++skipped;
+							continue;
+						}
+
+						int ply = 0;
+						bool ok = reader.replay(game, [&](const Position& pos, Move m)
+						{
+							if (ply++ >= options.maxPly)
+								return;
+							auto& node = parts[partOf(pos.getKey(), threads)][pos.getKey()];
+							addResult(node.results, result);
+							auto it = std::find_if(node.moves.begin(), node.moves.end(),
+								[m](const MoveStats& s) { return s.move == m.raw(); });
+							if (it == node.moves.end())
+								it = node.moves.insert(node.moves.end(), { m.raw(), 0, {} });
+							addResult(it->results, result);
+						});
+						++(ok ? games : skipped);
+					}
+				}
+			});
+		}
+		for (auto& th : pool)
+			th.join();
+		pool.clear();
+
+		//  :  p   p   
+		std::vector<NodeMap> merged(threads);
+		for (int p = 0; p < threads; ++p)
+		{
+			pool.emplace_back([&, p]()
+			{
+				auto& out = merged[p];
+				out = std::move(local[0][p]);
+				for (int t = 1; t < threads; ++t)
+				{
+					for (auto& [key, node] : local[t][p])
+					{
+						auto& dst = out[key];
+						dst.results.white += node.results.white;
+						dst.results.draws += node.results.draws;
+						dst.results.black += node.results.black;
+						for (auto& s : node.moves)
+						{
+							auto it = std::find_if(dst.moves.begin(), dst.moves.end(),
+								[&s](const MoveStats& d) { return d.move == s.move; });
+							if (it == dst.moves.end())
+								dst.moves.push_back(s);
+							else
+							{
+								it->results.white += s.results.white;
+								it->results.draws += s.results.draws;
+								it->results.black += s.results.black;
+							}
+						}
+					}
+					NodeMap().swap(local[t][p]);
+				}
+				for (auto it = out.begin(); it != out.end();)
+					it = it->second.results.games() < options.minGames ? out.erase(it) : std::next(it);
+			});
+		}
+		for (auto& th : pool)
+			th.join();
+
+		size_t positions = 0;
+		for (auto& m : merged)
+			positions += m.size();
+
+		//     :     
+		uint64_t slots = 1024;
+		while (slots < positions * 2)
+			slots *= 2;
+		std::vector<Entry> table(slots, Entry{});
+		std::vector<MoveStats> moves;
+		for (auto& m : merged)
+		{
+			for (auto& [key, node] : m)
+			{
+				uint64_t i = key & (slots - 1);
+				while (table[i].results.games() != 0)
+					i = (i + 1) & (slots - 1);
+
+				std::sort(node.moves.begin(), node.moves.end(), [](const MoveStats& a, const MoveStats& b)
+				{
+					return a.results.games() > b.results.games();
+				});
+				table[i] = { key, node.results, uint32_t(moves.size()), uint16_t(node.moves.size()), 0, 0 };
+				moves.insert(moves.end(), node.moves.begin(), node.moves.end());
+			}
+			NodeMap().swap(m);
+		}
+
+		FileHeader header = {};
+		std::memcpy(header.magic, Magic, 4);
+		header.version = FormatVersion;
+		header.slotCount = slots;
+		header.moveCount = moves.size();
+		header.maxPly = uint32_t(options.maxPly);
+
+		std::ofstream out(path, std::ios::binary);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(table.data()), std::streamsize(table.size() * sizeof(Entry)));
+		out.write(reinterpret_cast<const char*>(moves.data()), std::streamsize(moves.size() * sizeof(MoveStats)));
+		if (!out)
+			throw std::runtime_error("explorer: cannot write " + path);
+
+		BuildStats stats;
+		stats.games = games;
+		stats.skipped = skipped;
+		stats.positions = positions;
+		stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+}
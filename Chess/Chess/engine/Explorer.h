@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine::explorer
+{
+	/// <summary>
+	///   (     )
+	/// </summary>
+	struct Results
+	{
+		uint32_t white = 0;
+		uint32_t draws = 0;
+		uint32_t black = 0;
+
+		constexpr uint32_t games() const { return white + draws + black; }
+
+		/// <summary>
+		///     [  - 1,  - 1/2 ]
+		/// </summary>
+		constexpr int whiteScore() const { return games() == 0 ? 0 : int((white * 2 + draws) * 50ull / games()); }
+	};
+
+	/// <summary>
+	///      ,     
+	/// </summary>
+	struct MoveStats
+	{
+		uint16_t move;
+		uint16_t reserved;
+		Results  results;
+	};
+
+	/// <summary>
+	///   .   -  
+	/// </summary>
+	struct Entry
+	{
+		uint64_t key;
+		Results  results;
+		uint32_t firstMove;
+		uint16_t moveCount;
+		uint16_t reserved;
+		uint32_t reserved2;
+	};
+
+	/// <summary>
+	///   ( little-endian ).   - slotCount   ( Entry ),  moveCount  ( MoveStats ).
+	///    ,   
+	/// </summary>
+	struct FileHeader
+	{
+		char     magic[4];
+		uint32_t version;
+		uint64_t slotCount;
+		uint64_t moveCount;
+		uint32_t maxPly;
+		uint32_t reserved;
+	};
+
+	constexpr char     Magic[4]      = { 'C', 'E', 'X', 'P' };
+	constexpr uint32_t FormatVersion = 1;
+
+	/// <summary>
+	///   :      
+	/// </summary>
+	struct PositionStats
+	{
+		Results results;
+
+		/// <summary>
+		///    
+		/// </summary>
+		std::vector<MoveStats> moves;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct BuildOptions
+	{
+		int threads = 1;
+
+		/// <summary>
+		///     
+		/// </summary>
+		int maxPly = 40;
+
+		/// <summary>
+		///       
+		/// </summary>
+		uint32_t minGames = 1;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct BuildStats
+	{
+		uint64_t games = 0;
+		uint64_t skipped = 0;
+		uint64_t positions = 0;
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///   :       ,   .
+	///   -      key mod slotCount (       )
+	/// </summary>
+	class Explorer
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="path">  </param>
+		explicit Explorer(const std::string& path);
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="key">   ( Position::getKey() )</param>
+		/// <returns> [ nullopt -      ]</returns>
+		std::optional<PositionStats> lookup(uint64_t key) const;
+
+		std::optional<PositionStats> lookup(const Position& pos) const { return lookup(pos.getKey()); }
+
+		size_t getSlotCount() const { return slotCount; }
+		int    getMaxPly()    const { return maxPly; }
+
+		/// <summary>
+		///      ( engine::archive ) :    ,
+		///        ,    .
+		///    
+		/// </summary>
+		/// <param name="archives">  </param>
+		/// <param name="path">   </param>
+		/// <param name="options"> </param>
+		/// <returns> </returns>
+		static BuildStats build(const std::vector<std::string>& archives, const std::string& path,
+			                    const BuildOptions& options = {});
+
+	private:
+		core::MappedFile file;
+		uint64_t slotCount = 0;
+		uint64_t moveCount = 0;
+		int maxPly = 0;
+	};
+}
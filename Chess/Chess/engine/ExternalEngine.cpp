@@ -0,0 +1,183 @@
+#include "ExternalEngine.h"
+
+#include "ComputerPlayer.h"
+#include "../chess/BoardState.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace engine
+{
+	ExternalEngine::ExternalEngine(const std::string& commandLine, const std::vector<std::string>& setup)
+		: process(std::make_unique<core::ChildProcess>(commandLine))
+	{
+		reader = std::thread(&ExternalEngine::readLoop, this);
+
+		//       :     ,
+		//   go     
+		send("uci");
+		for (auto& command : setup)
+			send(command);
+		send("isready");
+	}
+
+	ExternalEngine::~ExternalEngine()
+	{
+		cancel();
+		send("quit");
+		process->closeInput();
+		if (!process->wait(1000))
+			process->kill();
+		reader.join();
+	}
+
+	std::unique_ptr<ExternalEngine> ExternalEngine::fromConfig(const std::string& path)
+	{
+		std::ifstream file(path);
+		std::string commandLine, line;
+		if (!file || !std::getline(file, commandLine) || commandLine.empty())
+			return nullptr;
+
+		std::vector<std::string> setup;
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (!line.empty())
+				setup.push_back(line);
+		}
+		return std::make_unique<ExternalEngine>(commandLine, setup);
+	}
+
+	void ExternalEngine::send(const std::string& command)
+	{
+		if (!process->write(command + "\n"))
+			alive = false;
+	}
+
+	std::string ExternalEngine::getName() const
+	{
+		std::lock_guard lock(mutex);
+		return name;
+	}
+
+	void ExternalEngine::newGame()
+	{
+		cancel();
+		send("ucinewgame");
+		send("isready");
+	}
+
+	void ExternalEngine::cancel()
+	{
+		bool searching = false;
+		{
+			std::lock_guard lock(mutex);
+			for (auto& r : requests)
+			{
+				searching |= r.callback != nullptr;
+				r.callback = nullptr;
+			}
+		}
+		if (searching)
+			send("stop");
+	}
+
+	void ExternalEngine::requestMove(const chess::BoardState& state, const std::vector<chess::FullMove>& history,
+		                             int64_t movetimeMs, MoveCallback callback)
+	{
+		auto pos = Position::fromState(state);
+		MoveList legal;
+		pos.generateLegalMoves(legal);
+		auto accepted = ComputerPlayer::acceptedMoves(pos, state);
+		if (accepted.empty() || !alive)
+		{
+			callback({});
+			return;
+		}
+
+		//   -     
+		std::ostringstream position;
+		position << "position startpos";
+		if (!history.empty())
+		{
+			position << " moves";
+			for (auto& m : history)
+				position << " " << m;
+		}
+
+		// ,    ,    
+		std::ostringstream go;
+		go << "go movetime " << std::max<int64_t>(movetimeMs, 1);
+		if ((int)accepted.size() < legal.size())
+		{
+			go << " searchmoves";
+			for (auto m : accepted)
+				go << " " << m;
+		}
+
+		Request request{ std::move(callback), {} };
+		for (auto m : accepted)
+			request.accepted.push_back(m.toFullMove());
+		{
+			std::lock_guard lock(mutex);
+			requests.push_back(std::move(request));
+		}
+		send(position.str());
+		send(go.str());
+	}
+
+	void ExternalEngine::readLoop()
+	{
+		std::string line;
+		while (process->readLine(line))
+		{
+			//        : bestmove    
+			std::istringstream ss(line);
+			std::string token;
+			if (!(ss >> token))
+				continue;
+			if (token == "id" && ss >> token && token == "name")
+			{
+				std::lock_guard lock(mutex);
+				std::getline(ss >> std::ws, name);
+			}
+			else if (token == "bestmove")
+			{
+				Request request;
+				{
+					std::lock_guard lock(mutex);
+					if (requests.empty())
+						continue;
+					request = std::move(requests.front());
+					requests.pop_front();
+				}
+				if (!request.callback)
+					continue;
+
+				token.clear();
+				ss >> token;
+				auto m = chess::FullMove::fromString(token);
+				bool ok = std::any_of(request.accepted.begin(), request.accepted.end(), [m](const chess::FullMove& a)
+				{
+					return a.from == m.from && a.to == m.to && a.promotionResult == m.promotionResult;
+				});
+				request.callback(ok ? m : chess::FullMove());
+			}
+		}
+
+		//   :      
+		alive = false;
+		std::deque<Request> rest;
+		{
+			std::lock_guard lock(mutex);
+			rest.swap(requests);
+		}
+		for (auto& r : rest)
+		{
+			if (r.callback)
+				r.callback({});
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Types.h"
+#include "../core/ChildProcess.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chess
+{
+	class BoardState;
+}
+
+namespace engine
+{
+	/// <summary>
+	///  -     UCI   .
+	///        (   - ucinewgame ),
+	///    ,      
+	/// </summary>
+	class ExternalEngine
+	{
+	public:
+		/// <summary>
+		///      (    ).
+		/// from == Pos::Invalid -    ,    ,  
+		/// </summary>
+		using MoveCallback = std::function<void(chess::FullMove)>;
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="commandLine">     </param>
+		/// <param name="setup">  "uci" ( , "setoption name Threads value 2" )</param>
+		ExternalEngine(const std::string& commandLine, const std::vector<std::string>& setup = {});
+
+		/// <summary>
+		///   quit    
+		/// </summary>
+		~ExternalEngine();
+
+		ExternalEngine(const ExternalEngine&) = delete;
+		ExternalEngine& operator=(const ExternalEngine&) = delete;
+
+		/// <summary>
+		///      :   -  ,  -   "uci"
+		/// </summary>
+		/// <param name="path">  </param>
+		/// <returns> [ nullptr -       ]</returns>
+		static std::unique_ptr<ExternalEngine> fromConfig(const std::string& path);
+
+		/// <summary>
+		///   :   ,   ucinewgame
+		/// </summary>
+		void newGame();
+
+		/// <summary>
+		///     (    )
+		/// </summary>
+		/// <param name="state"> </param>
+		/// <param name="history">    </param>
+		/// <param name="movetimeMs">  </param>
+		/// <param name="callback">   </param>
+		void requestMove(const chess::BoardState& state, const std::vector<chess::FullMove>& history,
+			             int64_t movetimeMs, MoveCallback callback);
+
+		/// <summary>
+		///    :     ,   
+		/// </summary>
+		void cancel();
+
+		/// <summary>
+		/// ,    
+		/// </summary>
+		/// <returns>false -    (   )</returns>
+		bool isAlive() const { return alive; }
+
+		/// <summary>
+		///      "uci"
+		/// </summary>
+		/// <returns> [  -     ]</returns>
+		std::string getName() const;
+
+	private:
+		/// <summary>
+		///   :       go.
+		///          -   bestmove   
+		/// </summary>
+		struct Request
+		{
+			MoveCallback callback;
+			std::vector<chess::FullMove> accepted;
+		};
+
+		std::unique_ptr<core::ChildProcess> process;
+		std::thread reader;
+		std::atomic<bool> alive = true;
+
+		mutable std::mutex mutex;
+		std::deque<Request> requests;
+		std::string name;
+
+		void send(const std::string& command);
+
+		/// <summary>
+		///    
+		/// </summary>
+		void readLoop();
+	};
+}
@@ -0,0 +1,432 @@
+#include "Match.h"
+
+#include "Nnue.h"
+#include "Pgn.h"
+#include "../chess/Board.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+
+namespace engine::match
+{
+	namespace
+	{
+		/// <summary>
+		///  ,      
+		/// </summary>
+		struct Outcome
+		{
+			const char* result = nullptr;
+			const char* reason = nullptr;
+
+			/// <summary>
+			///    :       
+			/// </summary>
+			bool adjudicated = false;
+
+			const chess::Board* board = nullptr;
+			const tb::Tablebase* tablebase = nullptr;
+
+			bool over() const { return result != nullptr; }
+
+			void finish(const char* res, const char* why)
+			{
+				//        :  
+				if (!over())
+				{
+					result = res;
+					reason = why;
+				}
+			}
+		};
+
+		/// <summary>
+		///     -    ,
+		///       
+		/// </summary>
+		thread_local Outcome* current = nullptr;
+
+		void onPromotion(chess::Side) {}
+
+		void onCheckmate(chess::FullMove, chess::Side whoWon)
+		{
+			current->finish(whoWon == chess::Side::White ? "1-0" : "0-1", current->adjudicated ? "tablebase" : "mate");
+		}
+
+		void onStalemate(chess::FullMove, chess::Side)
+		{
+			current->finish("1/2-1/2", "stalemate");
+		}
+
+		void onDraw(chess::FullMove, std::string_view)
+		{
+			//      :       
+			const char* why = "repetition";
+			if (current->adjudicated)
+				why = "tablebase";
+			else if (current->board->getState().getHalfMoveClock() >= 100)
+				why = "fifty";
+			current->finish("1/2-1/2", why);
+		}
+
+		chess::GameResult onAdjudicate(const chess::BoardState& state, chess::Side& whoWon)
+		{
+			auto res = current->tablebase->probe(state);
+			if (!res)
+				return chess::GameResult::Continue;
+			current->adjudicated = true;
+			if (res->wdl == tb::Wdl::Draw)
+				return chess::GameResult::Draw;
+			whoWon = res->wdl == tb::Wdl::Win ? state.getCurrentSide() : chess::getOtherSide(state.getCurrentSide());
+			return chess::GameResult::Win;
+		}
+
+		/// <summary>
+		///   :         
+		/// </summary>
+		struct Worker
+		{
+			std::unique_ptr<chess::Board> board;
+			Searcher searchers[2];
+			Position pos;
+			Outcome outcome;
+		};
+
+		/// <summary>
+		///   
+		/// </summary>
+		struct GameRecord
+		{
+			size_t index;
+			size_t opening;
+			int whitePlayer;
+			int plies = 0;
+			const char* result = nullptr;
+			const char* reason = nullptr;
+		};
+
+		/// <summary>
+		///        
+		/// </summary>
+		/// <returns>false -     </returns>
+		bool playMove(Worker& w, Move m)
+		{
+			auto full = m.toFullMove();
+			if (!w.board->tryMove(full.from, full.to, nullptr))
+				return false;
+			if (full.promotionResult != chess::PromotionResult::None)
+				w.board->onGetPromotionResult(w.board->getCurrentSide(), full.promotionResult);
+
+			Undo undo;
+			w.pos.makeMove(m, undo);
+			return true;
+		}
+
+		void playGame(Worker& w, const Player* players[2], const std::vector<chess::FullMove>& opening,
+			          const Adjudication& adjudication, GameRecord& game)
+		{
+			w.outcome = {};
+			w.outcome.board = w.board.get();
+			w.outcome.tablebase = adjudication.tablebase.get();
+			current = &w.outcome;
+
+			w.board->reset();
+			w.pos = Position::startPosition();
+			for (auto full : opening)
+			{
+				auto m = w.pos.findMove(full);
+				if (m.isNone() || !playMove(w, m))
+					return;
+				++game.plies;
+			}
+			for (auto& s : w.searchers)
+			{
+				s.newGame();
+				s.options.table->clear();
+			}
+
+			//    (     )      
+			int resignStreak = 0;
+			int drawStreak = 0;
+			int lastSign = 0;
+
+			while (!w.outcome.over())
+			{
+				if (game.plies >= adjudication.maxPlies)
+				{
+					w.outcome.finish("1/2-1/2", "maxplies");
+					break;
+				}
+
+				//       :      
+				MoveList legal;
+				w.pos.generateLegalMoves(legal);
+				if (legal.count == 0)
+				{
+					bool white = w.pos.getSide() == chess::Side::White;
+					w.outcome.finish(!w.pos.inCheck() ? "1/2-1/2" : white ? "0-1" : "1-0",
+						             w.pos.inCheck() ? "mate" : "stalemate");
+					break;
+				}
+
+				int player = w.pos.getSide() == chess::Side::White ? game.whitePlayer : 1 - game.whitePlayer;
+				auto res = w.searchers[player].search(w.pos, players[player]->limits);
+				if (res.best.isNone())
+				{
+					//       (   ) :     
+					SearchLimits first;
+					first.depth = 1;
+					res = w.searchers[player].search(w.pos, first);
+				}
+				int whiteScore = w.pos.getSide() == chess::Side::White ? res.score : -res.score;
+				int moveNumber = w.pos.getMoveCounter();
+				if (res.best.isNone() || !playMove(w, res.best))
+					return;
+				++game.plies;
+
+				if (adjudication.resignMoves > 0)
+				{
+					int sign = whiteScore >= adjudication.resignScore ? 1 : whiteScore <= -adjudication.resignScore ? -1 : 0;
+					resignStreak = sign == 0 ? 0 : sign == lastSign ? resignStreak + 1 : 1;
+					lastSign = sign;
+					if (resignStreak >= 2 * adjudication.resignMoves)
+						w.outcome.finish(sign > 0 ? "1-0" : "0-1", "resign");
+				}
+				if (adjudication.drawMoves > 0)
+				{
+					bool quiet = moveNumber >= adjudication.drawMoveNumber && std::abs(whiteScore) <= adjudication.drawScore;
+					drawStreak = quiet ? drawStreak + 1 : 0;
+					if (drawStreak >= 2 * adjudication.drawMoves)
+						w.outcome.finish("1/2-1/2", "adjudication");
+				}
+			}
+			game.result = w.outcome.result;
+			game.reason = w.outcome.reason;
+		}
+
+		double eloFromRatio(double r)
+		{
+			r = std::clamp(r, 1e-6, 1 - 1e-6);
+			return -400.0 * std::log10(1.0 / r - 1.0);
+		}
+
+		double ratioFromElo(double elo)
+		{
+			return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+		}
+
+		/// <summary>
+		///    
+		/// </summary>
+		double variance(const Score& s)
+		{
+			double n = s.games(), r = s.ratio();
+			return (s.wins * (1 - r) * (1 - r) + s.losses * r * r + s.draws * (0.5 - r) * (0.5 - r)) / n;
+		}
+
+		void writeScore(std::ostream& log, const Player& first, const Player& second, const Score& s, const Sprt& sprt)
+		{
+			char buffer[256];
+			int n = std::snprintf(buffer, sizeof(buffer), "# %s vs %s : %d - %d - %d [%.3f] %d  elo %+.1f +- %.1f  los %.1f%%",
+				first.name.c_str(), second.name.c_str(), s.wins, s.losses, s.draws, s.ratio(), s.games(),
+				s.elo(), s.eloError(), s.los() * 100);
+			if (sprt.enabled)
+			{
+				std::snprintf(buffer + n, sizeof(buffer) - n, "  llr %.2f (%.2f, %.2f)",
+					s.llr(sprt), sprt.lowerBound(), sprt.upperBound());
+			}
+			log << buffer << "\n";
+		}
+	}
+
+	Player Player::parse(std::string_view spec, std::string defaultName)
+	{
+		Player p;
+		p.name = std::move(defaultName);
+		p.limits.nodes = 20000;
+
+		while (!spec.empty())
+		{
+			auto end = std::min(spec.find(','), spec.size());
+			auto word = spec.substr(0, end);
+			spec.remove_prefix(std::min(end + 1, spec.size()));
+			if (word.empty())
+				continue;
+
+			auto eq = word.find('=');
+			auto key = word.substr(0, eq);
+			auto value = eq == std::string_view::npos ? std::string() : std::string(word.substr(eq + 1));
+
+			if (key == "name")                 p.name = value;
+			else if (key == "nnue")            p.options.network = nnue::Network::load(value);
+			else if (key == "nodes")           p.limits.nodes = std::stoull(value);
+			else if (key == "movetime")
+			{
+				p.limits.movetimeMs = std::stoll(value);
+				p.limits.nodes = 0;
+			}
+			else if (key == "depth")
+			{
+				p.limits.depth = std::clamp(std::stoi(value), 1, MaxPly - 1);
+				p.limits.nodes = 0;
+			}
+			else if (key == "hash")            p.hashMegabytes = std::max<size_t>(1, std::stoull(value));
+			else if (key == "no-ordering")     p.options.moveOrdering = false;
+			else if (key == "no-null")         p.options.nullMove = false;
+			else if (key == "no-lmr")          p.options.lateMoveReductions = false;
+			else if (key == "no-futility")     p.options.futility = false;
+			else if (key == "no-rfp")          p.options.reverseFutility = false;
+			else if (key == "no-checkext")     p.options.checkExtensions = false;
+			else
+				throw std::invalid_argument("match: unknown player option " + std::string(word));
+		}
+		return p;
+	}
+
+	double Sprt::lowerBound() const { return std::log(beta / (1 - alpha)); }
+	double Sprt::upperBound() const { return std::log((1 - beta) / alpha); }
+
+	double Score::ratio() const
+	{
+		return games() == 0 ? 0.5 : (wins + draws * 0.5) / games();
+	}
+
+	double Score::elo() const
+	{
+		return games() == 0 ? 0.0 : eloFromRatio(ratio());
+	}
+
+	double Score::eloError() const
+	{
+		if (games() == 0)
+			return 0;
+		double margin = 1.96 * std::sqrt(variance(*this) / games());
+		return (eloFromRatio(ratio() + margin) - eloFromRatio(ratio() - margin)) / 2;
+	}
+
+	double Score::los() const
+	{
+		if (wins + losses == 0)
+			return 0.5;
+		return 0.5 * (1 + std::erf((wins - losses) / std::sqrt(2.0 * (wins + losses))));
+	}
+
+	double Score::llr(const Sprt& sprt) const
+	{
+		//    SPRT :   -      
+		double var = games() == 0 ? 0 : variance(*this);
+		if (var <= 0)
+			return 0;
+		double s0 = ratioFromElo(sprt.elo0), s1 = ratioFromElo(sprt.elo1);
+		return games() * (s1 - s0) * (2 * ratio() - s0 - s1) / (2 * var);
+	}
+
+	std::vector<std::vector<chess::FullMove>> loadOpenings(const std::string& path, int plies)
+	{
+		std::vector<std::vector<chess::FullMove>> openings;
+		pgn::Reader reader(path);
+		auto parser = reader.parser();
+		pgn::Game game;
+		while (parser.next(game))
+		{
+			//       
+			if (!game.tag("FEN").empty())
+				continue;
+			size_t count = plies > 0 ? std::min(game.moves.size(), size_t(plies)) : game.moves.size();
+			openings.emplace_back(game.moves.begin(), game.moves.begin() + count);
+		}
+		return openings;
+	}
+
+	Report run(const Player& first, const Player& second, const Options& options, std::ostream& log)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		size_t games = size_t(std::max(options.games, 0));
+		int threads = int(std::clamp<size_t>(size_t(std::max(options.threads, 1)), 1, std::max<size_t>(games, 1)));
+		const Player* players[2] = { &first, &second };
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			auto w = std::make_unique<Worker>();
+			w->board = std::make_unique<chess::Board>(onPromotion, onCheckmate, onStalemate, onDraw);
+			if (options.adjudication.tablebase)
+				w->board->setAdjudicationCallback(onAdjudicate);
+			for (int p = 0; p < 2; ++p)
+			{
+				w->searchers[p].options = players[p]->options;
+				w->searchers[p].options.table = std::make_shared<TranspositionTable>(players[p]->hashMegabytes);
+			}
+			workers.push_back(std::move(w));
+		}
+
+		std::mutex logLock;
+		Report report;
+		std::atomic<bool> stopped = false;
+
+		core::parallelFor(games, threads, [&](size_t index, int t)
+		{
+			if (stopped.load(std::memory_order_relaxed))
+				return;
+
+			//     :     
+			GameRecord game;
+			game.index = index;
+			game.opening = options.openings.empty() ? 0 : (index / 2) % options.openings.size();
+			game.whitePlayer = int(index % 2);
+			static const std::vector<chess::FullMove> NoOpening;
+			playGame(*workers[t], players, options.openings.empty() ? NoOpening : options.openings[game.opening],
+				     options.adjudication, game);
+
+			std::lock_guard guard(logLock);
+			auto& s = report.score;
+			const auto& white = *players[game.whitePlayer];
+			const auto& black = *players[1 - game.whitePlayer];
+			if (!game.result)
+			{
+				++s.errors;
+				log << index + 1 << " " << white.name << " " << black.name << " * error " << game.plies
+					<< " " << game.opening + 1 << "\n";
+				log.flush();
+				return;
+			}
+
+			log << index + 1 << " " << white.name << " " << black.name << " " << game.result << " " << game.reason
+				<< " " << game.plies << " " << game.opening + 1 << "\n";
+			if (game.result[1] == '/')
+				++s.draws;
+			else if ((game.result[0] == '1') == (game.whitePlayer == 0))
+				++s.wins;
+			else
+				++s.losses;
+
+			if (s.games() % 2 == 0)
+				writeScore(log, first, second, s, options.sprt);
+			log.flush();
+
+			if (options.sprt.enabled && report.sprtResult == 0)
+			{
+				double llr = s.llr(options.sprt);
+				if (llr >= options.sprt.upperBound())
+					report.sprtResult = 1;
+				else if (llr <= options.sprt.lowerBound())
+					report.sprtResult = -1;
+				if (report.sprtResult != 0)
+					stopped = true;
+			}
+		});
+
+		//         
+		if (report.score.games() % 2 != 0)
+			writeScore(log, first, second, report.score, options.sprt);
+		log.flush();
+		report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return report;
+	}
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Search.h"
+#include "Tablebase.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::match
+{
+	/// <summary>
+	///   :      
+	/// </summary>
+	struct Player
+	{
+		std::string name;
+		SearchOptions options;
+		SearchLimits limits;
+
+		/// <summary>
+		///   , .         
+		/// </summary>
+		size_t hashMegabytes = 16;
+
+		/// <summary>
+		///    :    -
+		/// "name=X", "nnue=", "nodes=N", "movetime=", "depth=N", "hash="
+		///    "no-ordering", "no-null", "no-lmr", "no-futility", "no-rfp", "no-checkext"
+		/// </summary>
+		/// <param name="spec"> [  -     20000  ]</param>
+		/// <param name="defaultName">,    </param>
+		/// <returns></returns>
+		/// <exception cref="std::invalid_argument"> </exception>
+		static Player parse(std::string_view spec, std::string defaultName);
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct Adjudication
+	{
+		/// <summary>
+		///   [ nullptr -   ]
+		/// </summary>
+		std::shared_ptr<const tb::Tablebase> tablebase;
+
+		/// <summary>
+		///  :    resignMoves        resignScore
+		///     [ 0 -   ]
+		/// </summary>
+		int resignMoves = 3;
+		int resignScore = 1000;
+
+		/// <summary>
+		///  :    drawMoveNumber    drawMoves   
+		///     drawScore   [ 0 -     ]
+		/// </summary>
+		int drawMoveNumber = 40;
+		int drawMoves = 8;
+		int drawScore = 10;
+
+		/// <summary>
+		///       
+		/// </summary>
+		int maxPlies = 400;
+	};
+
+	/// <summary>
+	///     ( SPRT ) :  H0 -    elo0,
+	/// H1 - elo1.  ,         alpha  beta
+	/// </summary>
+	struct Sprt
+	{
+		bool enabled = false;
+		double elo0 = 0;
+		double elo1 = 5;
+		double alpha = 0.05;
+		double beta = 0.05;
+
+		double lowerBound() const;
+		double upperBound() const;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Options
+	{
+		/// <summary>
+		///   [     :    ]
+		/// </summary>
+		int games = 100;
+
+		/// <summary>
+		///    :     
+		/// </summary>
+		int threads = 1;
+
+		/// <summary>
+		///  :     [  -      ]
+		/// </summary>
+		std::vector<std::vector<chess::FullMove>> openings;
+
+		Adjudication adjudication;
+		Sprt sprt;
+	};
+
+	/// <summary>
+	///       
+	/// </summary>
+	struct Score
+	{
+		int wins = 0;
+		int losses = 0;
+		int draws = 0;
+
+		/// <summary>
+		/// ,  -  (     ),    
+		/// </summary>
+		int errors = 0;
+
+		int games() const { return wins + losses + draws; }
+
+		/// <summary>
+		///     0  1
+		/// </summary>
+		double ratio() const;
+
+		/// <summary>
+		///        95%  
+		/// </summary>
+		double elo() const;
+		double eloError() const;
+
+		/// <summary>
+		///  ,     (      )
+		/// </summary>
+		double los() const;
+
+		/// <summary>
+		///     SPRT
+		/// </summary>
+		double llr(const Sprt& sprt) const;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Report
+	{
+		Score score;
+
+		/// <summary>
+		///  SPRT : 1 -  H1, -1 -  H0, 0 -  
+		/// </summary>
+		int sprtResult = 0;
+
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///     PGN :      plies 
+	/// </summary>
+	/// <param name="path">  </param>
+	/// <param name="plies">    [ 0 -    ]</param>
+	/// <returns></returns>
+	std::vector<std::vector<chess::FullMove>> loadOpenings(const std::string& path, int plies);
+
+	/// <summary>
+	///    :       ( chess::Board ),
+	///      ( , ,  )   .
+	///    -     : , , , , ,
+	///  ,  ;     -   .
+	///   SPRT      
+	/// </summary>
+	/// <param name="first">  (  )</param>
+	/// <param name="second">  (  )</param>
+	/// <param name="options"></param>
+	/// <param name="log"> </param>
+	/// <returns> </returns>
+	Report run(const Player& first, const Player& second, const Options& options, std::ostream& log);
+}
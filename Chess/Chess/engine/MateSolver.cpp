@@ -0,0 +1,389 @@
+#include "MateSolver.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace engine::mate
+{
+	namespace
+	{
+		/// <summary>
+		/// ""  :  .    
+		/// </summary>
+		constexpr uint32_t Infinity = 1u << 30;
+
+		/// <summary>
+		///  ,      ( ,     )
+		/// </summary>
+		constexpr int AnyDepth = 0xFFFF;
+
+		/// <summary>
+		///        :   
+		/// </summary>
+		constexpr uint32_t QuietProof = 2;
+
+		constexpr uint32_t add(uint32_t a, uint32_t b) { return std::min(a + b, Infinity); }
+
+		constexpr ProofNumbers mated()                { return { 0, Infinity, 0 }; }
+		constexpr ProofNumbers refuted()              { return { Infinity, 0, AnyDepth }; }
+		constexpr ProofNumbers refutedAt(int depth)   { return { Infinity, 0, depth }; }
+
+		/// <summary>
+		///         (       )
+		/// </summary>
+		struct Child
+		{
+			Move move;
+			uint32_t phi;
+			uint32_t delta;
+			int dist;
+		};
+	}
+
+	ProofTable::ProofTable(size_t megabytes)
+	{
+		size_t wanted = std::max<size_t>(megabytes, 1) << 20;
+		size_t n = 1;
+		while (n * 2 * BucketSize * sizeof(Entry) <= wanted)
+			n *= 2;
+
+		entries = std::make_unique<Entry[]>(n * BucketSize);
+		count = n * BucketSize;
+		mask = n - 1;
+		clear();
+	}
+
+	void ProofTable::clear()
+	{
+		std::fill_n(entries.get(), count, Entry{});
+		used = 0;
+		collections = 0;
+	}
+
+	bool ProofTable::probe(uint64_t key, int depth, ProofNumbers& numbers) const
+	{
+		auto b = bucket(key);
+		for (size_t i = 0; i < BucketSize; ++i)
+		{
+			auto& e = b[i];
+			if (e.work == 0 || e.key != key)
+				continue;
+
+			if (e.pn == 0)
+			{
+				if (e.depth > depth)
+					return false;
+				numbers = { 0, Infinity, e.depth };
+			}
+			else if (e.dn == 0)
+			{
+				if (e.depth < depth)
+					return false;
+				numbers = { Infinity, 0, e.depth };
+			}
+			else
+			{
+				if (e.depth != depth)
+					return false;
+				numbers = { e.pn, e.dn, 0 };
+			}
+			return true;
+		}
+		return false;
+	}
+
+	void ProofTable::store(uint64_t key, int depth, const ProofNumbers& numbers, uint64_t work)
+	{
+		if (used >= count / 4 * 3)
+			collect();
+
+		auto b = bucket(key);
+		Entry* slot = nullptr;
+		for (size_t i = 0; i < BucketSize; ++i)
+		{
+			auto& e = b[i];
+			if (e.work != 0 && e.key == key)
+			{
+				//            :
+				//     ,       
+				bool solved = e.pn == 0 || e.dn == 0;
+				bool weaker = (numbers.pn != 0 && numbers.dn != 0)
+					       || (e.pn == 0 && numbers.pn == 0 && numbers.dist >= e.depth)
+					       || (e.dn == 0 && numbers.dn == 0 && numbers.dist <= e.depth);
+				if (solved && weaker)
+				{
+					e.work = uint32_t(std::min<uint64_t>(uint64_t(e.work) + work, UINT32_MAX));
+					return;
+				}
+				slot = &e;
+				break;
+			}
+			if (e.work == 0)
+			{
+				if (!slot || slot->work != 0)
+					slot = &e;
+			}
+			else if (!slot || (slot->work != 0 && e.work < slot->work))
+			{
+				slot = &e;
+			}
+		}
+
+		if (slot->work == 0)
+			++used;
+		else if (slot->key == key)
+			work += slot->work;
+
+		slot->key = key;
+		slot->pn = numbers.pn;
+		slot->dn = numbers.dn;
+		slot->depth = uint16_t(numbers.pn == 0 || numbers.dn == 0 ? numbers.dist : depth);
+		slot->work = uint32_t(std::clamp<uint64_t>(work, 1, UINT32_MAX));
+	}
+
+	void ProofTable::collect()
+	{
+		std::array<size_t, 33> histogram = {};
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (entries[i].work != 0)
+				++histogram[std::bit_width(entries[i].work)];
+		}
+
+		//   ,       (   -  )
+		size_t removed = 0;
+		int limit = 0;
+		while (limit < 32 && removed + histogram[limit] < used / 2)
+			removed += histogram[limit++];
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto& e = entries[i];
+			if (e.work != 0 && int(std::bit_width(e.work)) <= limit)
+			{
+				e.work = 0;
+				--used;
+			}
+		}
+		++collections;
+	}
+
+	Solver::Solver(size_t tableMegabytes) : table(tableMegabytes) {}
+
+	Result Solver::solve(Position& position, int maxMoves, uint64_t maxNodesBudget)
+	{
+		pos = &position;
+		attacker = position.getSide();
+		nodes = 0;
+		maxNodes = maxNodesBudget;
+		table.clear();
+
+		Result result;
+		auto root = searchRoot(2 * maxMoves - 1);
+		if (root.dn == 0)
+			result.verdict = Verdict::NoMate;
+		if (root.pn == 0)
+		{
+			result.verdict = Verdict::Mate;
+			int dist = extractPv(2 * maxMoves - 1, result.pv);
+			result.mateIn = (std::min(dist != 0 ? dist : root.dist, root.dist) + 1) / 2;
+
+			//      :     
+			for (;;)
+			{
+				if (result.mateIn == 1)
+				{
+					result.shortest = true;
+					break;
+				}
+				auto shorter = searchRoot(2 * result.mateIn - 3);
+				if (shorter.dn == 0)
+				{
+					result.shortest = true;
+					break;
+				}
+				if (shorter.pn != 0)
+					break;
+				result.pv.clear();
+				dist = extractPv(2 * result.mateIn - 3, result.pv);
+				result.mateIn = (std::min(dist != 0 ? dist : shorter.dist, shorter.dist) + 1) / 2;
+			}
+		}
+
+		result.nodes = nodes;
+		result.collections = table.getCollections();
+		return result;
+	}
+
+	ProofNumbers Solver::searchRoot(int depth)
+	{
+		ProofNumbers root;
+		do
+		{
+			root = mid(depth, Infinity, Infinity);
+		} while (root.pn != 0 && root.dn != 0 && nodes < maxNodes);
+		return root;
+	}
+
+	ProofNumbers Solver::mid(int depth, uint32_t thPhi, uint32_t thDelta)
+	{
+		++nodes;
+		uint64_t startNodes = nodes;
+		bool attacking = pos->getSide() == attacker;
+
+		//      
+		if (attacking && depth <= 0)
+		{
+			auto n = refutedAt(0);
+			table.store(pos->getKey(), depth, n, 1);
+			return n;
+		}
+
+		MoveList list;
+		pos->generateLegalMoves(list);
+		if (list.empty() || (!attacking && depth <= 0))
+		{
+			// ,       
+			auto n = list.empty() ? (!attacking && pos->inCheck() ? mated() : refuted()) : refutedAt(depth);
+			table.store(pos->getKey(), depth, n, 1);
+			return n;
+		}
+
+		//  :     .       
+		std::array<Child, MaxMoves> children;
+		int childCount = 0;
+		for (auto m : list)
+		{
+			Undo undo;
+			pos->makeMove(m, undo);
+			uint64_t key = pos->getKey();
+			bool check = pos->inCheck();
+			pos->unmakeMove(m, undo);
+			if (attacking && depth == 1 && !check)
+				continue;
+
+			//      :    -  
+			ProofNumbers n;
+			if (!table.probe(key, depth - 1, n))
+				n = { attacking && !check ? QuietProof : 1u, 1u, 0 };
+			auto& c = children[childCount++];
+			c.move = m;
+			c.phi = attacking ? n.dn : n.pn;
+			c.delta = attacking ? n.pn : n.dn;
+			c.dist = n.dist;
+		}
+
+		ProofNumbers result;
+		if (childCount == 0)
+		{
+			result = refutedAt(depth);
+		}
+		else
+		{
+			for (;;)
+			{
+				// phi  -  delta , delta  -  phi 
+				uint32_t phi = Infinity, delta = 0, secondDelta = Infinity;
+				int best = 0;
+				for (int i = 0; i < childCount; ++i)
+				{
+					auto& c = children[i];
+					if (c.delta < phi)
+					{
+						secondDelta = phi;
+						phi = c.delta;
+						best = i;
+					}
+					else if (c.delta < secondDelta)
+					{
+						secondDelta = c.delta;
+					}
+					delta = add(delta, c.phi);
+				}
+
+				if (phi >= thPhi || delta >= thDelta || nodes >= maxNodes)
+				{
+					result.pn = attacking ? phi : delta;
+					result.dn = attacking ? delta : phi;
+					break;
+				}
+
+				auto& c = children[best];
+				uint32_t childThPhi = uint32_t(std::min<uint64_t>(uint64_t(thDelta) - delta + c.phi, Infinity));
+				uint32_t childThDelta = std::min(thPhi, add(secondDelta, 1));
+
+				Undo undo;
+				pos->makeMove(c.move, undo);
+				auto n = mid(depth - 1, childThPhi, childThDelta);
+				pos->unmakeMove(c.move, undo);
+
+				c.phi = attacking ? n.dn : n.pn;
+				c.delta = attacking ? n.pn : n.dn;
+				c.dist = n.dist;
+			}
+
+			//   :    ,  - 
+			if (result.pn == 0)
+			{
+				int dist = attacking ? AnyDepth : 0;
+				for (int i = 0; i < childCount; ++i)
+				{
+					auto& c = children[i];
+					bool proven = attacking ? c.delta == 0 : c.phi == 0;
+					if (proven)
+						dist = attacking ? std::min(dist, c.dist) : std::max(dist, c.dist);
+				}
+				result.dist = dist + 1;
+			}
+			else if (result.dn == 0)
+			{
+				result.dist = depth;
+			}
+		}
+
+		table.store(pos->getKey(), depth, result, nodes - startNodes + 1);
+		return result;
+	}
+
+	int Solver::extractPv(int depth, std::vector<Move>& pv)
+	{
+		//        :       
+		int rootDist = 0;
+		std::vector<std::pair<Move, Undo>> made;
+		for (; depth > 0; --depth)
+		{
+			bool attacking = pos->getSide() == attacker;
+			MoveList list;
+			pos->generateLegalMoves(list);
+
+			Move best;
+			int bestDist = attacking ? AnyDepth : -1;
+			for (auto m : list)
+			{
+				Undo undo;
+				ProofNumbers n;
+				pos->makeMove(m, undo);
+				bool found = table.probe(pos->getKey(), depth - 1, n) && n.pn == 0;
+				pos->unmakeMove(m, undo);
+				if (found && (attacking ? n.dist < bestDist : n.dist > bestDist))
+				{
+					best = m;
+					bestDist = n.dist;
+				}
+			}
+			if (best.isNone())
+				break;
+			if (made.empty())
+				rootDist = bestDist + 1;
+
+			pv.push_back(best);
+			auto& [m, undo] = made.emplace_back(best, Undo{});
+			pos->makeMove(m, undo);
+		}
+
+		for (auto it = made.rbegin(); it != made.rend(); ++it)
+			pos->unmakeMove(it->first, it->second);
+		return rootDist;
+	}
+}
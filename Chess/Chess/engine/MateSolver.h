@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Position.h"
+
+#include <memory>
+#include <vector>
+
+namespace engine::mate
+{
+	/// <summary>
+	///    {  ,      ,   (    ) }
+	/// </summary>
+	enum class Verdict : uint8_t
+	{
+		Mate, NoMate, Unknown,
+	};
+
+	/// <summary>
+	///    "  N ?"
+	/// </summary>
+	struct Result
+	{
+		Verdict verdict = Verdict::Unknown;
+
+		/// <summary>
+		///      [   Verdict::Mate ]
+		/// </summary>
+		int mateIn = 0;
+
+		/// <summary>
+		///      : mateIn -  
+		/// [ false -         ]
+		/// </summary>
+		bool shortest = false;
+
+		/// <summary>
+		///   :       ,
+		///  -    [  ,      ]
+		/// </summary>
+		std::vector<Move> pv;
+
+		uint64_t nodes = 0;
+
+		/// <summary>
+		///       
+		/// </summary>
+		uint64_t collections = 0;
+	};
+
+	/// <summary>
+	///   ( pn )   ( dn )      .
+	/// pn = 0 -    dist , dn = 0 -    depth 
+	/// </summary>
+	struct ProofNumbers
+	{
+		uint32_t pn = 1;
+		uint32_t dn = 1;
+		int      dist = 0;
+	};
+
+	/// <summary>
+	///       .
+	///       ;    -   (   ).
+	///              ,
+	///     :    ,   
+	/// </summary>
+	class ProofTable
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="megabytes">  </param>
+		explicit ProofTable(size_t megabytes = 16);
+
+		ProofTable(const ProofTable&) = delete;
+		ProofTable& operator=(const ProofTable&) = delete;
+
+		void clear();
+
+		/// <summary>
+		///  .          ,
+		///  -     ,    ,   -     
+		/// </summary>
+		/// <param name="key">  </param>
+		/// <param name="depth"> </param>
+		/// <param name="numbers"> </param>
+		/// <returns>true -        </returns>
+		bool probe(uint64_t key, int depth, ProofNumbers& numbers) const;
+
+		/// <summary>
+		///    (         )
+		/// </summary>
+		/// <param name="key">  </param>
+		/// <param name="depth"> </param>
+		/// <param name="numbers"></param>
+		/// <param name="work">,   </param>
+		void store(uint64_t key, int depth, const ProofNumbers& numbers, uint64_t work);
+
+		uint64_t getCollections() const { return collections; }
+		size_t   getUsed()        const { return used; }
+		size_t   getCapacity()    const { return count; }
+
+	private:
+		struct Entry
+		{
+			uint64_t key;
+			uint32_t pn;
+			uint32_t dn;
+			uint32_t work; // 0 -  
+			uint16_t depth; //    pn = 0,   
+		};
+
+		static constexpr size_t BucketSize = 4;
+
+		std::unique_ptr<Entry[]> entries;
+		size_t count = 0;
+		uint64_t mask = 0;
+		size_t used = 0;
+		uint64_t collections = 0;
+
+		Entry* bucket(uint64_t key) const { return &entries[(key & mask) * BucketSize]; }
+
+		/// <summary>
+		///   :   log2      ,
+		///     
+		/// </summary>
+		void collect();
+	};
+
+	/// <summary>
+	///        ( df-pn ),      :
+	///   ,   .    ""  
+	///   ,    ( ,   ) 
+	///        ,        .
+	///    50   
+	/// </summary>
+	class Solver
+	{
+	public:
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="tableMegabytes"> , </param>
+		explicit Solver(size_t tableMegabytes = 16);
+
+		/// <summary>
+		///   maxMoves      ?   ,
+		///    :      
+		/// </summary>
+		/// <param name="pos"> [     ]</param>
+		/// <param name="maxMoves">   </param>
+		/// <param name="maxNodes">    </param>
+		/// <returns></returns>
+		Result solve(Position& pos, int maxMoves, uint64_t maxNodes);
+
+	private:
+		ProofTable table;
+		Position* pos = nullptr;
+		chess::Side attacker = chess::Side::White;
+		uint64_t nodes = 0;
+		uint64_t maxNodes = 0;
+
+		/// <summary>
+		///     ,    
+		/// </summary>
+		/// <param name="depth"> </param>
+		/// <returns> </returns>
+		ProofNumbers searchRoot(int depth);
+
+		/// <summary>
+		///  ,      ( phi / delta -      )
+		/// </summary>
+		/// <param name="depth"> </param>
+		/// <param name="thPhi"> phi</param>
+		/// <param name="thDelta"> delta</param>
+		/// <returns> </returns>
+		ProofNumbers mid(int depth, uint32_t thPhi, uint32_t thDelta);
+
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="depth">  </param>
+		/// <param name="pv"></param>
+		/// <returns>        [ 0 -   ]</returns>
+		int extractPv(int depth, std::vector<Move>& pv);
+	};
+}
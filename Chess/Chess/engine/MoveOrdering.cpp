@@ -0,0 +1,113 @@
+#include "MoveOrdering.h"
+
+#include <cstring>
+
+namespace engine
+{
+	namespace
+	{
+		//   :   ,   , ,  ,   
+		constexpr int HashMoveScore = 1 << 30;
+		constexpr int CaptureScore  = 1 << 24;
+		constexpr int KillerScore   = 1 << 22;
+		constexpr int CounterScore  = 1 << 21;
+	}
+
+	void MoveOrdering::clear()
+	{
+		for (auto& k : killers)
+			k = {};
+		std::memset(history, 0, sizeof(history));
+		for (auto& piece : counterMoves)
+			for (auto& m : piece)
+				m = {};
+	}
+
+	void MoveOrdering::age(int plies)
+	{
+		if (plies < 0 || plies >= MaxPly)
+			plies = MaxPly;
+		for (int ply = 0; ply < MaxPly; ++ply)
+			killers[ply] = ply + plies < MaxPly ? killers[ply + plies] : std::array<Move, 2>{};
+		for (auto& side : history)
+			for (auto& from : side)
+				for (auto& h : from)
+					h /= 2;
+	}
+
+	void MoveOrdering::score(MoveList& list, const Position& pos, int ply, Move hashMove, Move prevMove) const
+	{
+		Move counter = prevMove.isNone() ? Move() : counterMoves[pos.at(prevMove.to())][prevMove.to()];
+		int side = (int)pos.getSide();
+
+		for (int i = 0; i < list.size(); ++i)
+		{
+			auto m = list[i];
+			int& s = list.scores[i];
+
+			if (m == hashMove)
+			{
+				s = HashMoveScore;
+			}
+			else if (!isQuiet(pos, m))
+			{
+				auto victim = m.flag() == MoveFlag::Passing ? Pawn : typeOf(pos.at(m.to()));
+				s = CaptureScore + MvvLva[victim][typeOf(pos.at(m.from()))] + PieceValue[m.promotionType()];
+			}
+			else if (m == killers[ply][0])
+			{
+				s = KillerScore + 1;
+			}
+			else if (m == killers[ply][1])
+			{
+				s = KillerScore;
+			}
+			else if (m == counter)
+			{
+				s = CounterScore;
+			}
+			else
+			{
+				s = history[side][m.from()][m.to()];
+			}
+		}
+	}
+
+	void MoveOrdering::scoreCaptures(MoveList& list, const Position& pos) const
+	{
+		for (int i = 0; i < list.size(); ++i)
+		{
+			auto m = list[i];
+			auto victim = m.flag() == MoveFlag::Passing ? Pawn : typeOf(pos.at(m.to()));
+			list.scores[i] = MvvLva[victim][typeOf(pos.at(m.from()))] + PieceValue[m.promotionType()];
+		}
+	}
+
+	void MoveOrdering::updateHistory(chess::Side side, Move m, int bonus)
+	{
+		// "" :      MaxHistory    
+		int& h = history[(int)side][m.from()][m.to()];
+		h += bonus - h * (bonus < 0 ? -bonus : bonus) / MaxHistory;
+	}
+
+	void MoveOrdering::onCutoff(const Position& pos, Move best, Move prevMove, int ply, int depth,
+		                        const Move* quiets, int quietCount)
+	{
+		if (killers[ply][0] != best)
+		{
+			killers[ply][1] = killers[ply][0];
+			killers[ply][0] = best;
+		}
+
+		int bonus = std::min(depth * depth, 400);
+		updateHistory(pos.getSide(), best, bonus);
+		for (int i = 0; i < quietCount; ++i)
+		{
+			if (quiets[i] != best)
+				updateHistory(pos.getSide(), quiets[i], -bonus);
+		}
+
+		if (!prevMove.isNone())
+			counterMoves[pos.at(prevMove.to())][prevMove.to()] = best;
+	}
+}
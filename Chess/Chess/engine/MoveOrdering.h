@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Position.h"
+
+namespace engine
+{
+	/// <summary>
+	///  MVV-LVA :       
+	/// [  -  ,    ]
+	/// </summary>
+	constexpr auto MvvLva = []()
+	{
+		std::array<std::array<int, 7>, 7> res = {};
+		for (int victim = Pawn; victim <= Queen; ++victim)
+			for (int attacker = Pawn; attacker <= King; ++attacker)
+				res[victim][attacker] = victim * 8 - attacker;
+		return res;
+	}();
+
+	/// <summary>
+	///        :
+	/// -,     
+	/// </summary>
+	class MoveOrdering
+	{
+	public:
+		MoveOrdering() { clear(); }
+
+		/// <summary>
+		///    (    )
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		///         :   ,   ,
+		///        ,       
+		/// </summary>
+		/// <param name="plies">      [ 0 -   ,    ;
+		///      MaxPly -   ,   ]</param>
+		void age(int plies);
+
+		/// <summary>
+		///          MoveList::pickNext()
+		/// </summary>
+		/// <param name="list"> </param>
+		/// <param name="pos">,    </param>
+		/// <param name="ply">   </param>
+		/// <param name="hashMove">     (    )</param>
+		/// <param name="prevMove">   (    )</param>
+		void score(MoveList& list, const Position& pos, int ply, Move hashMove, Move prevMove) const;
+
+		/// <summary>
+		///        (  MVV-LVA )
+		/// </summary>
+		/// <param name="list"> </param>
+		/// <param name="pos"></param>
+		void scoreCaptures(MoveList& list, const Position& pos) const;
+
+		/// <summary>
+		///      
+		/// </summary>
+		/// <param name="pos">,    </param>
+		/// <param name="best">,  </param>
+		/// <param name="prevMove">  </param>
+		/// <param name="ply">   </param>
+		/// <param name="depth"> </param>
+		/// <param name="quiets"> ,    (   )</param>
+		/// <param name="quietCount">  </param>
+		void onCutoff(const Position& pos, Move best, Move prevMove, int ply, int depth,
+			          const Move* quiets, int quietCount);
+
+		/// <summary>
+		/// ,     (      )
+		/// </summary>
+		/// <param name="pos">  </param>
+		/// <param name="m"></param>
+		/// <returns>true -   </returns>
+		static bool isQuiet(const Position& pos, Move m)
+		{
+			return pos.at(m.to()) == NoPiece && m.flag() != MoveFlag::Passing && !m.isPromotion();
+		}
+
+	private:
+		static constexpr int MaxHistory = 1 << 14;
+
+		std::array<std::array<Move, 2>, MaxPly> killers;
+
+		/// <summary>
+		/// ""   [  ][  ][  ]
+		/// </summary>
+		int history[2][64][64];
+
+		/// <summary>
+		///   [    ][    ]
+		/// </summary>
+		Move counterMoves[16][64];
+
+		void updateHistory(chess::Side side, Move m, int bonus);
+	};
+}
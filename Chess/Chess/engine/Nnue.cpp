@@ -0,0 +1,328 @@
+#include "Nnue.h"
+
+#include "Position.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// MSVC   __SSE4_1__,  /arch:AVX  
+#if defined(__AVX2__)
+#define NNUE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(__AVX__)
+#define NNUE_SSE41
+#include <smmintrin.h>
+#endif
+
+namespace engine::nnue
+{
+	namespace
+	{
+		constexpr int InputSize = HalfSize * 2;
+
+		/// <summary>
+		///   
+		/// </summary>
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t featureCount;
+			uint32_t halfSize;
+			uint32_t hidden1;
+			uint32_t hidden2;
+			uint8_t reserved[40];
+		};
+		static_assert(sizeof(Header) == 64);
+
+		constexpr uint32_t Version = 1;
+
+		constexpr size_t FileSize = sizeof(Header)
+			+ sizeof(int16_t) * HalfSize + sizeof(int16_t) * size_t(FeatureCount) * HalfSize
+			+ sizeof(int32_t) * Hidden1 + sizeof(int8_t) * Hidden1 * InputSize
+			+ sizeof(int32_t) * Hidden2 + sizeof(int8_t) * Hidden2 * Hidden1
+			+ sizeof(int32_t) + sizeof(int8_t) * Hidden2;
+
+		/// <summary>
+		///   HalfKP :   ,  (  /  ),  .
+		///    ,     ""
+		/// </summary>
+		constexpr int featureIndex(chess::Side perspective, Square king, Piece p, Square s)
+		{
+			if (perspective == chess::Side::Black)
+			{
+				king ^= 56;
+				s ^= 56;
+			}
+			int piece = (typeOf(p) - Pawn) * 2 + (sideOf(p) != perspective);
+			return (king * 10 + piece) * 64 + s;
+		}
+
+		/// <summary>
+		///      
+		/// </summary>
+		bool movesKing(const DirtyPieces& dirty, chess::Side perspective)
+		{
+			for (int i = 0; i < dirty.count; ++i)
+			{
+				if (dirty.list[i].piece == makePiece(perspective, King))
+					return true;
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// acc = prev -   sub +   add
+		/// </summary>
+		void applyRows(const int16_t* weights, const int16_t* prev, int16_t* acc,
+			           const int* add, int addCount, const int* sub, int subCount)
+		{
+#if defined(NNUE_AVX2)
+			for (int i = 0; i < HalfSize; i += 16)
+			{
+				auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
+				for (int k = 0; k < subCount; ++k)
+					v = _mm256_sub_epi16(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + size_t(sub[k]) * HalfSize + i)));
+				for (int k = 0; k < addCount; ++k)
+					v = _mm256_add_epi16(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + size_t(add[k]) * HalfSize + i)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), v);
+			}
+#elif defined(NNUE_SSE41)
+			for (int i = 0; i < HalfSize; i += 8)
+			{
+				auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+				for (int k = 0; k < subCount; ++k)
+					v = _mm_sub_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + size_t(sub[k]) * HalfSize + i)));
+				for (int k = 0; k < addCount; ++k)
+					v = _mm_add_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + size_t(add[k]) * HalfSize + i)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), v);
+			}
+#else
+			for (int i = 0; i < HalfSize; ++i)
+			{
+				int v = prev[i];
+				for (int k = 0; k < subCount; ++k)
+					v -= weights[size_t(sub[k]) * HalfSize + i];
+				for (int k = 0; k < addCount; ++k)
+					v += weights[size_t(add[k]) * HalfSize + i];
+				acc[i] = int16_t(v);
+			}
+#endif
+		}
+
+		/// <summary>
+		///    [ 0, 127 ]    
+		/// </summary>
+		void clipAccumulator(const int16_t* acc, uint8_t* out)
+		{
+#if defined(NNUE_AVX2)
+			const auto zero = _mm256_setzero_si256();
+			for (int i = 0; i < HalfSize; i += 32)
+			{
+				auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i));
+				auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i + 16));
+				// packs   128- , permute  
+				auto packed = _mm256_max_epi8(_mm256_packs_epi16(a, b), zero);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+			}
+#elif defined(NNUE_SSE41)
+			const auto zero = _mm_setzero_si128();
+			for (int i = 0; i < HalfSize; i += 16)
+			{
+				auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+				auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i + 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_max_epi8(_mm_packs_epi16(a, b), zero));
+			}
+#else
+			for (int i = 0; i < HalfSize; ++i)
+				out[i] = uint8_t(std::clamp<int>(acc[i], 0, 127));
+#endif
+		}
+
+		/// <summary>
+		///     ( 0..127 )   int8
+		/// </summary>
+		int32_t dot(const uint8_t* in, const int8_t* w, int size)
+		{
+#if defined(NNUE_AVX2)
+			const auto ones = _mm256_set1_epi16(1);
+			auto sum = _mm256_setzero_si256();
+			for (int j = 0; j < size; j += 32)
+			{
+				auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + j));
+				auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + j));
+				// 127 * 128 * 2    int16,   
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), ones));
+			}
+			auto s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+			s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+			s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+			return _mm_cvtsi128_si32(s);
+#elif defined(NNUE_SSE41)
+			const auto ones = _mm_set1_epi16(1);
+			auto sum = _mm_setzero_si128();
+			for (int j = 0; j < size; j += 16)
+			{
+				auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j));
+				auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + j));
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(a, b), ones));
+			}
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+			return _mm_cvtsi128_si32(sum);
+#else
+			int32_t sum = 0;
+			for (int j = 0; j < size; ++j)
+				sum += int32_t(in[j]) * w[j];
+			return sum;
+#endif
+		}
+
+		/// <summary>
+		///       [ 0, 127 ]
+		/// </summary>
+		template <int In, int Out>
+		void affineClipped(const uint8_t* in, const int32_t* bias, const int8_t* weights, uint8_t* out)
+		{
+			for (int i = 0; i < Out; ++i)
+			{
+				int32_t v = (bias[i] + dot(in, weights + i * In, In)) >> WeightShift;
+				out[i] = uint8_t(std::clamp(v, 0, 127));
+			}
+		}
+	}
+
+	std::shared_ptr<const Network> Network::load(const std::string& path)
+	{
+		std::shared_ptr<Network> net(new Network());
+		net->file = core::MappedFile(path);
+
+		if (net->file.size() != FileSize)
+			throw std::runtime_error("nnue: unexpected size of " + path);
+
+		Header header;
+		std::memcpy(&header, net->file.data(), sizeof(header));
+		if (std::memcmp(header.magic, "CNNU", 4) != 0 || header.version != Version ||
+			header.featureCount != FeatureCount || header.halfSize != HalfSize ||
+			header.hidden1 != Hidden1 || header.hidden2 != Hidden2)
+		{
+			throw std::runtime_error("nnue: incompatible network " + path);
+		}
+
+		auto ptr = net->file.data() + sizeof(Header);
+		auto take = [&ptr](auto& dest, size_t count)
+		{
+			dest = reinterpret_cast<std::remove_reference_t<decltype(dest)>>(ptr);
+			ptr += sizeof(*dest) * count;
+		};
+		take(net->ftBias,     HalfSize);
+		take(net->ftWeights,  size_t(FeatureCount) * HalfSize);
+		take(net->l1Bias,     Hidden1);
+		take(net->l1Weights,  Hidden1 * InputSize);
+		take(net->l2Bias,     Hidden2);
+		take(net->l2Weights,  Hidden2 * Hidden1);
+		take(net->outBias,    1);
+		take(net->outWeights, Hidden2);
+		return net;
+	}
+
+	void Network::refresh(const Position& pos, Accumulator& acc, chess::Side perspective) const
+	{
+		int features[32];
+		int count = 0;
+		Square king = pos.getKingSquare(perspective);
+		for (Square s = 0; s < 64; ++s)
+		{
+			auto p = pos.at(s);
+			if (p != NoPiece && typeOf(p) != King)
+				features[count++] = featureIndex(perspective, king, p, s);
+		}
+
+		//   ,       
+		auto out = acc.values[(int)perspective];
+		const int16_t* base = ftBias;
+		for (int i = 0; i < count; i += 8)
+		{
+			applyRows(ftWeights, base, out, features + i, std::min(8, count - i), nullptr, 0);
+			base = out;
+		}
+		if (count == 0)
+			std::memcpy(out, ftBias, sizeof(int16_t) * HalfSize);
+		acc.computed[(int)perspective] = true;
+	}
+
+	void Network::update(const Position& pos, const Accumulator& prev, Accumulator& acc, chess::Side perspective) const
+	{
+		int add[3], sub[3];
+		int addCount = 0, subCount = 0;
+		Square king = pos.getKingSquare(perspective);
+
+		for (int i = 0; i < acc.dirty.count; ++i)
+		{
+			auto& d = acc.dirty.list[i];
+			if (typeOf(d.piece) == King)
+				continue;
+			if (d.from != NoSquare) sub[subCount++] = featureIndex(perspective, king, d.piece, d.from);
+			if (d.to   != NoSquare) add[addCount++] = featureIndex(perspective, king, d.piece, d.to);
+		}
+
+		applyRows(ftWeights, prev.values[(int)perspective], acc.values[(int)perspective], add, addCount, sub, subCount);
+		acc.computed[(int)perspective] = true;
+	}
+
+	int Network::evaluate(const Position& pos) const
+	{
+		auto& stack = pos.accumulators;
+		int top = (int)stack.size() - 1;
+		auto& acc = stack[top];
+
+		for (auto perspective : { chess::Side::White, chess::Side::Black })
+		{
+			int p = (int)perspective;
+			if (acc.computed[p])
+				continue;
+
+			//           .
+			//      ,     -  
+			int from = top;
+			bool kingMoved = false;
+			while (from > 0 && !stack[from].computed[p] && !kingMoved)
+			{
+				kingMoved = movesKing(stack[from].dirty, perspective);
+				--from;
+			}
+
+			if (kingMoved || !stack[from].computed[p])
+			{
+				refresh(pos, acc, perspective);
+				continue;
+			}
+			for (int i = from + 1; i <= top; ++i)
+				update(pos, stack[i - 1], stack[i], perspective);
+		}
+
+		alignas(32) uint8_t input[InputSize];
+		alignas(32) uint8_t hidden1[Hidden1];
+		alignas(32) uint8_t hidden2[Hidden2];
+
+		clipAccumulator(acc.values[(int)pos.getSide()], input);
+		clipAccumulator(acc.values[(int)chess::getOtherSide(pos.getSide())], input + HalfSize);
+		affineClipped<InputSize, Hidden1>(input, l1Bias, l1Weights, hidden1);
+		affineClipped<Hidden1, Hidden2>(hidden1, l2Bias, l2Weights, hidden2);
+
+		int32_t out = outBias[0] + dot(hidden2, outWeights, Hidden2);
+		return out / OutputScale;
+	}
+
+	const char* Network::simdName()
+	{
+#if defined(NNUE_AVX2)
+		return "AVX2";
+#elif defined(NNUE_SSE41)
+		return "SSE4.1";
+#else
+		return "scalar";
+#endif
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Types.h"
+#include "../core/MappedFile.h"
+
+#include <memory>
+#include <string>
+
+namespace engine
+{
+	class Position;
+}
+
+namespace engine::nnue
+{
+	/// <summary>
+	///   : HalfKP (  x  x  ) -> 2 x 256 -> 32 -> 32 -> 1
+	/// </summary>
+	constexpr int FeatureCount = 64 * 10 * 64;
+	constexpr int HalfSize     = 256;
+	constexpr int Hidden1      = 32;
+	constexpr int Hidden2      = 32;
+
+	/// <summary>
+	///        int8    
+	/// </summary>
+	constexpr int WeightShift = 6;
+	constexpr int OutputScale = 16;
+
+	/// <summary>
+	///      [ from == NoSquare -  , to == NoSquare -  ]
+	/// </summary>
+	struct DirtyPiece
+	{
+		Piece piece;
+		Square from;
+		Square to;
+	};
+
+	/// <summary>
+	///      (      )
+	/// </summary>
+	struct DirtyPieces
+	{
+		int count = 0;
+		DirtyPiece list[3];
+
+		void add(Piece p, Square from, Square to) { list[count++] = { p, from, to }; }
+	};
+
+	/// <summary>
+	///       [  -  ]     .
+	///   :         
+	/// </summary>
+	struct Accumulator
+	{
+		alignas(32) int16_t values[2][HalfSize];
+		bool computed[2] = { false, false };
+		DirtyPieces dirty;
+
+		//   values :         
+		Accumulator() {}
+	};
+
+	/// <summary>
+	///  ,   .
+	///   ( little-endian ) :  64  { "CNNU", ,   },
+	///  int16 bias[256], int16 weights[FeatureCount][256],
+	/// int32 bias[32], int8 weights[32][512], int32 bias[32], int8 weights[32][32], int32 bias, int8 weights[32]
+	/// </summary>
+	class Network
+	{
+	public:
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="path">   </param>
+		/// <returns> </returns>
+		static std::shared_ptr<const Network> load(const std::string& path);
+
+		/// <summary>
+		///    (    )
+		/// </summary>
+		/// <param name="pos">   </param>
+		/// <returns>        </returns>
+		int evaluate(const Position& pos) const;
+
+		/// <summary>
+		///        
+		/// </summary>
+		void refresh(const Position& pos, Accumulator& acc, chess::Side perspective) const;
+
+		/// <summary>
+		///      
+		/// [       ,     ]
+		/// </summary>
+		void update(const Position& pos, const Accumulator& prev, Accumulator& acc, chess::Side perspective) const;
+
+		/// <summary>
+		///  ,   
+		/// </summary>
+		/// <returns>"AVX2", "SSE4.1"  "scalar"</returns>
+		static const char* simdName();
+
+	private:
+		Network() = default;
+
+		core::MappedFile file;
+
+		const int16_t* ftBias    = nullptr;
+		const int16_t* ftWeights = nullptr;
+		const int32_t* l1Bias    = nullptr;
+		const int8_t*  l1Weights = nullptr;
+		const int32_t* l2Bias    = nullptr;
+		const int8_t*  l2Weights = nullptr;
+		const int32_t* outBias   = nullptr;
+		const int8_t*  outWeights = nullptr;
+	};
+}
@@ -0,0 +1,146 @@
+#include "Pawns.h"
+
+namespace engine
+{
+	namespace
+	{
+		constexpr Score Doubled  = { -11, -56 };
+		constexpr Score Isolated = {  -5, -15 };
+		constexpr Score Backward = {  -9, -24 };
+
+		/// <summary>
+		///    [     ]
+		/// </summary>
+		constexpr Score Passed[8] = {
+			{ 0, 0 }, { 2, 8 }, { 5, 12 }, { 8, 20 }, { 20, 40 }, { 35, 70 }, { 60, 110 }, { 0, 0 },
+		};
+
+		/// <summary>
+		///   [         ]
+		/// [ 0 -  , 1 -   , 2 -      ]
+		/// </summary>
+		constexpr int Shelter[3] = { 12, 6, -14 };
+
+		constexpr int relativeRank(chess::Side side, Square s)
+		{
+			return side == chess::Side::White ? rankOf(s) : 7 - rankOf(s);
+		}
+
+		/// <summary>
+		/// ,    
+		/// </summary>
+		Bitboard pawnAttacks(Bitboard pawns, chess::Side side)
+		{
+			constexpr Bitboard NotA = ~Bitboard(0x0101010101010101ull);
+			constexpr Bitboard NotH = ~Bitboard(0x8080808080808080ull);
+			return side == chess::Side::White
+				? ((pawns & NotA) << 7) | ((pawns & NotH) << 9)
+				: ((pawns & NotA) >> 9) | ((pawns & NotH) >> 7);
+		}
+
+		/// <summary>
+		///    
+		/// </summary>
+		Score evaluateSide(chess::Side us, Bitboard ours, Bitboard theirs, Bitboard& passed)
+		{
+			int side = (int)us;
+			Score score;
+			Bitboard theirAttacks = pawnAttacks(theirs, chess::getOtherSide(us));
+			int push = us == chess::Side::White ? 8 : -8;
+
+			for (Bitboard b = ours; b; )
+			{
+				Square s = popLsb(b);
+				int file = fileOf(s);
+
+				if (masks.forwardFile[side][s] & ours)
+					score += Doubled;
+
+				if ((masks.adjacentFiles[file] & ours) == 0)
+				{
+					score += Isolated;
+				}
+				else if ((masks.pawnAttackSpan[1 - side][s + push] & ours) == 0 &&
+					     (theirAttacks & bit(s + push)))
+				{
+					//      ,     
+					score += Backward;
+				}
+
+				if ((masks.passedSpan[side][s] & theirs) == 0 && (masks.forwardFile[side][s] & ours) == 0)
+				{
+					passed |= bit(s);
+					score += Passed[relativeRank(us, s)];
+				}
+			}
+			return score;
+		}
+
+		/// <summary>
+		///      :    
+		/// </summary>
+		void evaluateShelter(chess::Side us, Bitboard ours, int16_t* shelter)
+		{
+			int homeRank = us == chess::Side::White ? 1 : 6;
+			int dir = us == chess::Side::White ? 1 : -1;
+
+			for (int kingFile = 0; kingFile < 8; ++kingFile)
+			{
+				int center = kingFile == 0 ? 1 : kingFile == 7 ? 6 : kingFile;
+				int total = 0;
+				for (int file = center - 1; file <= center + 1; ++file)
+				{
+					int idx = 2;
+					if (ours & bit(toSquare(file, homeRank)))
+						idx = 0;
+					else if (ours & bit(toSquare(file, homeRank + dir)))
+						idx = 1;
+					total += Shelter[idx];
+				}
+				shelter[kingFile] = int16_t(total);
+			}
+		}
+	}
+
+	PawnTable::PawnTable(int sizeLog2)
+		: entries(size_t(1) << sizeLog2), mask((uint64_t(1) << sizeLog2) - 1)
+	{}
+
+	void PawnTable::clear()
+	{
+		for (auto& e : entries)
+			e = PawnEntry();
+		resetStats();
+	}
+
+	const PawnEntry& PawnTable::probe(const Position& pos)
+	{
+		++probes;
+		auto& e = entries[pos.getPawnKey() & mask];
+		if (e.key == pos.getPawnKey())
+		{
+			++hits;
+			return e;
+		}
+		compute(pos, e);
+		return e;
+	}
+
+	void PawnTable::compute(const Position& pos, PawnEntry& entry)
+	{
+		Bitboard pawns[2] = {};
+		for (Square s = 0; s < 64; ++s)
+		{
+			auto p = pos.at(s);
+			if (typeOf(p) == Pawn)
+				pawns[(int)sideOf(p)] |= bit(s);
+		}
+
+		entry.key = pos.getPawnKey();
+		entry.passed[0] = entry.passed[1] = 0;
+		entry.score = evaluateSide(chess::Side::White, pawns[0], pawns[1], entry.passed[0])
+			        - evaluateSide(chess::Side::Black, pawns[1], pawns[0], entry.passed[1]);
+		evaluateShelter(chess::Side::White, pawns[0], entry.shelter[0]);
+		evaluateShelter(chess::Side::Black, pawns[1], entry.shelter[1]);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Bitboard.h"
+#include "Position.h"
+
+#include <vector>
+
+namespace engine
+{
+	/// <summary>
+	///    
+	/// </summary>
+	struct PawnEntry
+	{
+		uint64_t key = ~0ull;
+
+		/// <summary>
+		/// , ,     (     )
+		/// </summary>
+		Score score;
+
+		/// <summary>
+		///   [  ]
+		/// </summary>
+		Bitboard passed[2] = {};
+
+		/// <summary>
+		///      [  ][   ]
+		/// </summary>
+		int16_t shelter[2][8] = {};
+	};
+
+	/// <summary>
+	/// -  .   ,    
+	///   .     
+	/// </summary>
+	class PawnTable
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="sizeLog2">   </param>
+		explicit PawnTable(int sizeLog2 = 14);
+
+		/// <summary>
+		///       
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <returns>  (     )</returns>
+		const PawnEntry& probe(const Position& pos);
+
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="entry"> </param>
+		static void compute(const Position& pos, PawnEntry& entry);
+
+		void clear();
+
+		uint64_t getProbes() const { return probes; }
+		uint64_t getHits()   const { return hits; }
+		void resetStats() { probes = hits = 0; }
+
+	private:
+		std::vector<PawnEntry> entries;
+		uint64_t mask;
+		uint64_t probes = 0;
+		uint64_t hits = 0;
+	};
+}
@@ -0,0 +1,301 @@
+#include "Pgn.h"
+
+#include "San.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace engine::pgn
+{
+	namespace
+	{
+		constexpr bool isSpace(char c)
+		{
+			return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+		}
+
+		/// <summary>
+		/// ,      
+		/// </summary>
+		constexpr bool isDelimiter(char c)
+		{
+			return isSpace(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == ';' || c == '[';
+		}
+
+		constexpr bool isResult(std::string_view token)
+		{
+			return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+		}
+
+		/// <summary>
+		///      from :      
+		/// </summary>
+		size_t findGameStart(std::string_view text, size_t from)
+		{
+			for (size_t p = from; p < text.size();)
+			{
+				p = text.find("\n[", p);
+				if (p == std::string_view::npos)
+					return text.size();
+
+				size_t q = p;
+				while (q > 0 && text[q - 1] == '\r')
+					--q;
+				if (q == 0 || text[q - 1] == '\n')
+					return p + 1;
+				p += 2;
+			}
+			return text.size();
+		}
+	}
+
+	std::string_view Game::tag(std::string_view name) const
+	{
+		for (auto& t : tags)
+		{
+			if (t.name == name)
+				return t.value;
+		}
+		return {};
+	}
+
+	Parser::Parser(std::string_view text, size_t base)
+		: text(text), base(base), board(Position::startPosition()), start(board)
+	{}
+
+	void Parser::skipSpace()
+	{
+		while (pos < text.size() && isSpace(text[pos]))
+			++pos;
+	}
+
+	bool Parser::skipNonMove()
+	{
+		char c = text[pos];
+		if (c == '{')
+		{
+			auto end = text.find('}', pos);
+			pos = end == std::string_view::npos ? text.size() : end + 1;
+			return true;
+		}
+		if (c == ';' || (c == '%' && (pos == 0 || text[pos - 1] == '\n')))
+		{
+			auto end = text.find('\n', pos);
+			pos = end == std::string_view::npos ? text.size() : end + 1;
+			return true;
+		}
+		if (c == ')' || c == '}')
+		{
+			++pos;
+			return true;
+		}
+		if (c != '(')
+			return false;
+
+		//         
+		int depth = 0;
+		while (pos < text.size())
+		{
+			c = text[pos];
+			if (c == '{' || c == ';')
+			{
+				skipNonMove();
+				continue;
+			}
+			++pos;
+			if (c == '(')
+				++depth;
+			else if (c == ')' && --depth == 0)
+				break;
+		}
+		return true;
+	}
+
+	bool Parser::readTag(Game& game)
+	{
+		// [Name "Value"]
+		auto end = text.find('\n', pos);
+		if (end == std::string_view::npos)
+			end = text.size();
+		auto line = text.substr(pos + 1, end - pos - 1);
+		pos = end;
+
+		size_t nameEnd = 0;
+		while (nameEnd < line.size() && !isSpace(line[nameEnd]) && line[nameEnd] != '"' && line[nameEnd] != ']')
+			++nameEnd;
+		auto open = line.find('"', nameEnd);
+		if (nameEnd == 0 || open == std::string_view::npos)
+			return false;
+
+		size_t close = open + 1;
+		while (close < line.size() && line[close] != '"')
+			close += line[close] == '\\' ? 2 : 1;
+		if (close >= line.size())
+			return false;
+
+		game.tags.push_back({ line.substr(0, nameEnd), line.substr(open + 1, close - open - 1) });
+		return true;
+	}
+
+	void Parser::readMoves(Game& game)
+	{
+		if (auto fen = game.tag("FEN"); !fen.empty())
+		{
+			try
+			{
+				board = Position::fromFEN(fen);
+			}
+			catch (const std::exception&)
+			{
+				game.error = fen;
+			}
+		}
+		else
+		{
+			board = start;
+		}
+
+		while (true)
+		{
+			skipSpace();
+			if (pos >= text.size() || text[pos] == '[')
+				return;
+			if (skipNonMove())
+				continue;
+
+			size_t end = pos;
+			while (end < text.size() && !isDelimiter(text[end]))
+				++end;
+			auto token = text.substr(pos, end - pos);
+			pos = end;
+
+			if (isResult(token))
+			{
+				game.result = token;
+				return;
+			}
+			if (token[0] == '$')
+				continue;
+
+			//   "12."  "12..." - ,    ( "12.e4" )
+			if (token[0] >= '0' && token[0] <= '9')
+			{
+				size_t n = token.find_first_not_of("0123456789");
+				if (n == std::string_view::npos || token[n] != '.')
+				{
+					if (game.error.empty())
+						game.error = token;
+					continue;
+				}
+				token.remove_prefix(token.find_first_not_of('.', n) == std::string_view::npos
+					? token.size() : token.find_first_not_of('.', n));
+				if (token.empty())
+					continue;
+			}
+			if (!game.error.empty())
+				continue;
+
+			auto m = san::parse(board, token);
+			if (m.isNone())
+			{
+				game.error = token;
+				continue;
+			}
+			game.moves.push_back(m.toFullMove());
+			Undo undo;
+			board.makeMove(m, undo);
+		}
+	}
+
+	bool Parser::next(Game& game)
+	{
+		game.tags.clear();
+		game.moves.clear();
+		game.result = {};
+		game.error = {};
+
+		//       :      
+		while (true)
+		{
+			skipSpace();
+			if (pos >= text.size())
+				return false;
+			if (text[pos] == '[' || !skipNonMove())
+				break;
+		}
+
+		size_t begin = pos;
+		while (pos < text.size() && text[pos] == '[')
+		{
+			if (!readTag(game) && game.error.empty())
+				game.error = text.substr(begin, pos - begin);
+			skipSpace();
+		}
+		readMoves(game);
+
+		game.offset = base + begin;
+		game.text = text.substr(begin, pos - begin);
+		return true;
+	}
+
+	Reader::Reader(const std::string& path) : file(path) {}
+
+	std::vector<std::string_view> Reader::split(std::string_view text, int parts)
+	{
+		std::vector<std::string_view> res;
+		size_t begin = 0;
+		for (int i = 1; i <= parts && begin < text.size(); ++i)
+		{
+			size_t end = i == parts ? text.size() : findGameStart(text, std::max(begin, text.size() / parts * i));
+			if (end > begin)
+				res.push_back(text.substr(begin, end - begin));
+			begin = end;
+		}
+		return res;
+	}
+
+	ReadStats Reader::forEach(int threads, const std::function<void(const Game&, int thread)>& callback) const
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		threads = std::max(threads, 1);
+
+		//  ,   :     
+		auto parts = split(text(), threads * 8);
+		std::atomic<size_t> next = 0;
+		std::vector<ReadStats> stats(threads);
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t)
+		{
+			pool.emplace_back([&, t]()
+			{
+				Game game;
+				for (size_t i; (i = next.fetch_add(1)) < parts.size();)
+				{
+					Parser parser(parts[i], size_t(parts[i].data() - text().data()));
+					while (parser.next(game))
+					{
+						++stats[t].games;
+						stats[t].moves += game.moves.size();
+						stats[t].errors += !game.error.empty();
+						callback(game, t);
+					}
+				}
+			});
+		}
+		for (auto& th : pool)
+			th.join();
+
+		ReadStats total;
+		for (auto& s : stats)
+		{
+			total.games += s.games;
+			total.moves += s.moves;
+			total.errors += s.errors;
+		}
+		total.bytes = text().size();
+		total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return total;
+	}
+}
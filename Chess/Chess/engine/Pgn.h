@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::pgn
+{
+	/// <summary>
+	///    : [Name "Value"]
+	/// </summary>
+	struct Tag
+	{
+		std::string_view name;
+
+		/// <summary>
+		///    [  \"  \\   ]
+		/// </summary>
+		std::string_view value;
+	};
+
+	/// <summary>
+	///  .       ,   .
+	///        :      
+	/// </summary>
+	struct Game
+	{
+		std::vector<Tag> tags;
+
+		/// <summary>
+		///    (       )
+		/// </summary>
+		std::vector<chess::FullMove> moves;
+
+		/// <summary>
+		///     ( "1-0", "0-1", "1/2-1/2", "*" ) [  -    ]
+		/// </summary>
+		std::string_view result;
+
+		/// <summary>
+		///   
+		/// </summary>
+		std::string_view text;
+
+		/// <summary>
+		///     
+		/// </summary>
+		size_t offset = 0;
+
+		/// <summary>
+		/// ,       [  -   ].
+		///      moves
+		/// </summary>
+		std::string_view error;
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="name"> </param>
+		/// <returns> [  -    ]</returns>
+		std::string_view tag(std::string_view name) const;
+	};
+
+	/// <summary>
+	///       PGN   :      
+	/// </summary>
+	class Parser
+	{
+	public:
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="text"> [        ]</param>
+		/// <param name="base">    (  Game::offset )</param>
+		explicit Parser(std::string_view text, size_t base = 0);
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="game">  </param>
+		/// <returns>false -    </returns>
+		bool next(Game& game);
+
+	private:
+		std::string_view text;
+		size_t pos = 0;
+		size_t base;
+
+		/// <summary>
+		///           
+		/// </summary>
+		Position board;
+		Position start;
+
+		void skipSpace();
+		bool readTag(Game& game);
+		void readMoves(Game& game);
+
+		/// <summary>
+		///  ,   ,   '%'
+		/// </summary>
+		/// <returns>true -  - </returns>
+		bool skipNonMove();
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct ReadStats
+	{
+		uint64_t games = 0;
+		uint64_t moves = 0;
+		uint64_t errors = 0;
+		uint64_t bytes = 0;
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///  ,   
+	/// </summary>
+	class Reader
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="path">  </param>
+		explicit Reader(const std::string& path);
+
+		std::string_view text() const { return file.view(); }
+
+		/// <summary>
+		///       
+		/// </summary>
+		Parser parser() const { return Parser(text()); }
+
+		/// <summary>
+		///        (      )
+		/// </summary>
+		/// <param name="text"></param>
+		/// <param name="parts">  </param>
+		/// <returns>   [     ]</returns>
+		static std::vector<std::string_view> split(std::string_view text, int parts);
+
+		/// <summary>
+		///       :      
+		/// </summary>
+		/// <param name="threads"> </param>
+		/// <param name="callback">       (    )</param>
+		/// <returns> </returns>
+		ReadStats forEach(int threads, const std::function<void(const Game&, int thread)>& callback) const;
+
+	private:
+		core::MappedFile file;
+	};
+}
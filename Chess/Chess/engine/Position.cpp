@@ -0,0 +1,731 @@
+#include "Position.h"
+
+#include "Zobrist.h"
+#include "../chess/BoardState.h"
+
+#include <sstream>
+
+namespace engine
+{
+	using chess::Side;
+
+	namespace
+	{
+		//    - ,   - 
+		constexpr int DirDx[8] = { 0,  0, 1, -1, 1, -1,  1, -1 };
+		constexpr int DirDy[8] = { 1, -1, 0,  0, 1,  1, -1, -1 };
+
+		constexpr int KnightDx[8] = { 1, 2,  1, -2, -1,  2, -1, -2 };
+		constexpr int KnightDy[8] = { 2, 1, -2,  1,  2, -1, -2, -1 };
+
+		/// <summary>
+		///      
+		/// </summary>
+		struct Tables
+		{
+			int8_t toEdge[64][8]     = {};
+			int8_t knight[64][8]     = {};
+			int8_t knightCount[64]   = {};
+			int8_t king[64][8]       = {};
+			int8_t kingCount[64]     = {};
+			uint8_t castlingMask[64] = {};
+
+			constexpr Tables()
+			{
+				for (Square s = 0; s < 64; ++s)
+				{
+					int x = fileOf(s), y = rankOf(s);
+					for (int d = 0; d < 8; ++d)
+					{
+						int n = 0;
+						for (int i = x + DirDx[d], j = y + DirDy[d];
+							 i >= 0 && i < 8 && j >= 0 && j < 8;
+							 i += DirDx[d], j += DirDy[d])
+						{
+							++n;
+						}
+						toEdge[s][d] = int8_t(n);
+						if (n > 0)
+							king[s][kingCount[s]++] = int8_t(toSquare(x + DirDx[d], y + DirDy[d]));
+
+						int kx = x + KnightDx[d], ky = y + KnightDy[d];
+						if (kx >= 0 && kx < 8 && ky >= 0 && ky < 8)
+							knight[s][knightCount[s]++] = int8_t(toSquare(kx, ky));
+					}
+					castlingMask[s] = 15;
+				}
+				castlingMask[toSquare(4, 0)] = 15 & ~(WhiteKingside | WhiteQueenside);
+				castlingMask[toSquare(7, 0)] = 15 & ~WhiteKingside;
+				castlingMask[toSquare(0, 0)] = 15 & ~WhiteQueenside;
+				castlingMask[toSquare(4, 7)] = 15 & ~(BlackKingside | BlackQueenside);
+				castlingMask[toSquare(7, 7)] = 15 & ~BlackKingside;
+				castlingMask[toSquare(0, 7)] = 15 & ~BlackQueenside;
+			}
+		};
+
+		constexpr Tables tables{};
+
+		constexpr int dirOffset(int d) { return DirDy[d] * 8 + DirDx[d]; }
+
+		constexpr int pawnPush(Side s) { return s == Side::White ? 8 : -8; }
+
+		PieceType typeFromLetter(char c)
+		{
+			switch (tolower(c))
+			{
+				case 'p': return Pawn;
+				case 'n': return Knight;
+				case 'b': return Bishop;
+				case 'r': return Rook;
+				case 'q': return Queen;
+				case 'k': return King;
+			}
+			return NoType;
+		}
+
+		template <class T>
+		bool isUnmoved(const chess::BoardState& state, int x, int y)
+		{
+			auto* ptr = dynamic_cast<const T*>(state.at(x, y));
+			return ptr != nullptr && !ptr->getMadeFirstMove();
+		}
+
+		constexpr char PieceLetters[] = " PNBRQK";
+	}
+
+	Position::Position()
+		: board{}, pieceCounts{}, officers(0), side(Side::White), castling(0), passing(NoSquare),
+		  halfMoveClock(0), moveCounter(1), key(0), pawnKey(0), psq{}, phase(0)
+	{
+		kingSquare[Side::White] = kingSquare[Side::Black] = NoSquare;
+		occupied[Side::White] = occupied[Side::Black] = 0;
+		keyHistory.reserve(512);
+	}
+
+	Position Position::startPosition()
+	{
+		return fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	}
+
+	Position Position::fromState(const chess::BoardState& state)
+	{
+		Position pos;
+		for (int j = 0; j < 8; ++j)
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				auto* ptr = state.at(i, j);
+				if (ptr == nullptr)
+					continue;
+				pos.putPiece(toSquare(i, j), makePiece(ptr->getSide(), typeFromLetter(ptr->getLetter())));
+			}
+		}
+
+		//     ,   BoardState -      
+		if (isUnmoved<chess::King>(state, 4, 0))
+		{
+			if (isUnmoved<chess::Rook>(state, 7, 0)) pos.castling |= WhiteKingside;
+			if (isUnmoved<chess::Rook>(state, 0, 0)) pos.castling |= WhiteQueenside;
+		}
+		if (isUnmoved<chess::King>(state, 4, 7))
+		{
+			if (isUnmoved<chess::Rook>(state, 7, 7)) pos.castling |= BlackKingside;
+			if (isUnmoved<chess::Rook>(state, 0, 7)) pos.castling |= BlackQueenside;
+		}
+
+		pos.side = state.getCurrentSide();
+		pos.halfMoveClock = state.getHalfMoveClock();
+		pos.moveCounter = state.getMoveCounter();
+
+		// BoardState      ,  -   
+		auto target = state.getPassingTarget();
+		if (target.isValid())
+			pos.passing = toSquare(target) + pawnPush(pos.side);
+
+		pos.computeKey();
+		return pos;
+	}
+
+	Position Position::fromFEN(std::string_view fen)
+	{
+		Position pos;
+		std::istringstream ss{ std::string(fen) };
+		std::string pieces, side, castling, passing;
+		ss >> pieces >> side >> castling >> passing;
+
+		int x = 0, y = 7;
+		for (char c : pieces)
+		{
+			if (c == '/')
+			{
+				x = 0;
+				--y;
+			}
+			else if (c >= '1' && c <= '8')
+			{
+				x += c - '0';
+			}
+			else if (auto type = typeFromLetter(c); type != NoType && x < 8 && y >= 0)
+			{
+				pos.putPiece(toSquare(x++, y), makePiece(isupper(c) ? Side::White : Side::Black, type));
+			}
+			else
+			{
+				throw std::invalid_argument(core::concat("invalid FEN: ", fen));
+			}
+		}
+
+		pos.side = side == "b" ? Side::Black : Side::White;
+		for (char c : castling)
+		{
+			switch (c)
+			{
+				case 'K': pos.castling |= WhiteKingside;  break;
+				case 'Q': pos.castling |= WhiteQueenside; break;
+				case 'k': pos.castling |= BlackKingside;  break;
+				case 'q': pos.castling |= BlackQueenside; break;
+			}
+		}
+		if (passing.size() == 2)
+			pos.passing = toSquare(passing[0] - 'a', passing[1] - '1');
+
+		if (!(ss >> pos.halfMoveClock)) pos.halfMoveClock = 0;
+		if (!(ss >> pos.moveCounter))   pos.moveCounter = 1;
+
+		pos.computeKey();
+		return pos;
+	}
+
+	void Position::setPieces(const Piece* pieces, const Square* squares, int count, Side toMove)
+	{
+		board = {};
+		pieceCounts = {};
+		officers = 0;
+		occupied[Side::White] = occupied[Side::Black] = 0;
+		kingSquare[Side::White] = kingSquare[Side::Black] = NoSquare;
+		side = toMove;
+		castling = 0;
+		passing = NoSquare;
+		halfMoveClock = 0;
+		moveCounter = 1;
+		key = pawnKey = 0;
+		psq = {};
+		phase = 0;
+		keyHistory.clear();
+		if (network)
+			setNetwork(network);
+
+		for (int i = 0; i < count; ++i)
+			putPiece(squares[i], pieces[i]);
+		computeKey();
+	}
+
+	std::string Position::getFEN() const
+	{
+		std::stringstream s;
+		for (int y = 7; y >= 0; --y)
+		{
+			int empty = 0;
+			for (int x = 0; x < 8; ++x)
+			{
+				auto p = board[toSquare(x, y)];
+				if (p == NoPiece)
+				{
+					++empty;
+					continue;
+				}
+				if (empty != 0) s << empty;
+				empty = 0;
+				char c = PieceLetters[typeOf(p)];
+				s << (sideOf(p) == Side::White ? c : (char)tolower(c));
+			}
+			if (empty != 0) s << empty;
+			if (y != 0) s << '/';
+		}
+		s << ' ' << (side == Side::White ? 'w' : 'b') << ' ';
+		if (castling == 0) s << '-';
+		if (castling & WhiteKingside)  s << 'K';
+		if (castling & WhiteQueenside) s << 'Q';
+		if (castling & BlackKingside)  s << 'k';
+		if (castling & BlackQueenside) s << 'q';
+		s << ' ' << toPos(passing) << ' ' << halfMoveClock << ' ' << moveCounter;
+		return s.str();
+	}
+
+	void Position::computeKey()
+	{
+		key = 0;
+		for (Square s = 0; s < 64; ++s)
+		{
+			if (board[s] != NoPiece)
+				key ^= zobrist::keys.pieces[board[s]][s];
+		}
+		key ^= zobrist::keys.castling[castling];
+		if (passing != NoSquare) key ^= zobrist::keys.passing[fileOf(passing)];
+		if (side == Side::Black) key ^= zobrist::keys.side;
+	}
+
+	void Position::putPiece(Square s, Piece p)
+	{
+		board[s] = p;
+		++pieceCounts[p];
+		if (typeOf(p) >= Knight && typeOf(p) <= Queen)
+			officers |= bit(s);
+		occupied[sideOf(p)] |= bit(s);
+		key ^= zobrist::keys.pieces[p][s];
+		if (typeOf(p) == Pawn)
+			pawnKey ^= zobrist::keys.pieces[p][s];
+		psq += Psqt[p][s];
+		phase += PhaseWeight[typeOf(p)];
+		if (typeOf(p) == King)
+			kingSquare[sideOf(p)] = s;
+	}
+
+	void Position::removePiece(Square s)
+	{
+		key ^= zobrist::keys.pieces[board[s]][s];
+		if (typeOf(board[s]) == Pawn)
+			pawnKey ^= zobrist::keys.pieces[board[s]][s];
+		--pieceCounts[board[s]];
+		officers &= ~bit(s);
+		occupied[sideOf(board[s])] &= ~bit(s);
+		psq -= Psqt[board[s]][s];
+		phase -= PhaseWeight[typeOf(board[s])];
+		board[s] = NoPiece;
+	}
+
+	void Position::movePiece(Square from, Square to)
+	{
+		auto p = board[from];
+		removePiece(from);
+		putPiece(to, p);
+	}
+
+	bool Position::isAttacked(Square s, Side by) const
+	{
+		//     ,      "" 
+		int pawnDir = by == Side::White ? -1 : 1;
+		int y = rankOf(s) + pawnDir;
+		if (y >= 0 && y < 8)
+		{
+			for (int dx : { -1, 1 })
+			{
+				int x = fileOf(s) + dx;
+				if (x >= 0 && x < 8 && board[toSquare(x, y)] == makePiece(by, Pawn))
+					return true;
+			}
+		}
+
+		for (int i = 0; i < tables.knightCount[s]; ++i)
+		{
+			if (board[tables.knight[s][i]] == makePiece(by, Knight))
+				return true;
+		}
+		for (int i = 0; i < tables.kingCount[s]; ++i)
+		{
+			if (board[tables.king[s][i]] == makePiece(by, King))
+				return true;
+		}
+
+		for (int d = 0; d < 8; ++d)
+		{
+			auto slider = d < 4 ? Rook : Bishop;
+			int offset = dirOffset(d);
+			Square t = s;
+			for (int n = tables.toEdge[s][d]; n > 0; --n)
+			{
+				t += offset;
+				auto p = board[t];
+				if (p == NoPiece) continue;
+				if (sideOf(p) == by && (typeOf(p) == slider || typeOf(p) == Queen))
+					return true;
+				break;
+			}
+		}
+		return false;
+	}
+
+	Bitboard Position::attackersOf(Square s, Piece p) const
+	{
+		Bitboard res = 0;
+		auto type = typeOf(p);
+		if (type == Knight || type == King)
+		{
+			int count = type == King ? tables.kingCount[s] : tables.knightCount[s];
+			auto& from = type == King ? tables.king[s] : tables.knight[s];
+			for (int i = 0; i < count; ++i)
+			{
+				if (board[from[i]] == p)
+					res |= bit(from[i]);
+			}
+			return res;
+		}
+
+		int first = type == Bishop ? 4 : 0;
+		int last = type == Rook ? 4 : 8;
+		for (int d = first; d < last; ++d)
+		{
+			int offset = dirOffset(d);
+			Square t = s;
+			for (int n = tables.toEdge[s][d]; n > 0; --n)
+			{
+				t += offset;
+				if (board[t] == NoPiece) continue;
+				if (board[t] == p)
+					res |= bit(t);
+				break;
+			}
+		}
+		return res;
+	}
+
+	int Position::mobility(Square s) const
+	{
+		auto p = board[s];
+		auto own = occupied[sideOf(p)];
+		auto all = occupied[Side::White] | occupied[Side::Black];
+		Bitboard attacks;
+		switch (typeOf(p))
+		{
+		case Knight: attacks = masks.knightAttacks[s];            break;
+		case Bishop: attacks = slidingAttacks(s, 1, 2, all);      break;
+		case Rook:   attacks = slidingAttacks(s, 0, 2, all);      break;
+		default:     attacks = slidingAttacks(s, 0, 1, all);      break;
+		}
+		return popCount(attacks & ~own);
+	}
+
+	void Position::generateMoves(MoveList& list) const
+	{
+		generate(list, false);
+	}
+
+	void Position::generateCaptures(MoveList& list) const
+	{
+		generate(list, true);
+	}
+
+	void Position::generateLegalMoves(MoveList& list)
+	{
+		MoveList pseudo;
+		generate(pseudo, false);
+		list.count = 0;
+		for (auto m : pseudo)
+		{
+			Undo undo;
+			if (makeMove(m, undo))
+				list.add(m);
+			unmakeMove(m, undo);
+		}
+	}
+
+	void Position::generate(MoveList& list, bool capturesOnly) const
+	{
+		list.count = 0;
+		auto us = side;
+		auto them = chess::getOtherSide(us);
+		int push = pawnPush(us);
+		int promotionRank = us == Side::White ? 7 : 0;
+		int startRank = us == Side::White ? 1 : 6;
+
+		auto addPawnMove = [&](Square from, Square to)
+		{
+			if (rankOf(to) == promotionRank)
+			{
+				list.add({ from, to, MoveFlag::PromoQueen });
+				list.add({ from, to, MoveFlag::PromoKnight });
+				list.add({ from, to, MoveFlag::PromoRook });
+				list.add({ from, to, MoveFlag::PromoBishop });
+			}
+			else
+			{
+				list.add({ from, to });
+			}
+		};
+
+		for (Square from = 0; from < 64; ++from)
+		{
+			auto p = board[from];
+			if (p == NoPiece || sideOf(p) != us)
+				continue;
+
+			switch (typeOf(p))
+			{
+				case Pawn:
+				{
+					Square to = from + push;
+					if (board[to] == NoPiece && (!capturesOnly || rankOf(to) == promotionRank))
+					{
+						addPawnMove(from, to);
+						if (!capturesOnly && rankOf(from) == startRank && board[to + push] == NoPiece)
+							list.add({ from, to + push, MoveFlag::DoubleAdvance });
+					}
+					for (int dx : { -1, 1 })
+					{
+						int x = fileOf(from) + dx;
+						if (x < 0 || x > 7)
+							continue;
+						Square target = toSquare(x, rankOf(to));
+						if (board[target] != NoPiece && sideOf(board[target]) == them)
+							addPawnMove(from, target);
+						else if (target == passing)
+							list.add({ from, target, MoveFlag::Passing });
+					}
+				} break;
+
+				case Knight:
+				case King:
+				{
+					bool isKing = typeOf(p) == King;
+					int count = isKing ? tables.kingCount[from] : tables.knightCount[from];
+					auto& targets = isKing ? tables.king[from] : tables.knight[from];
+					for (int i = 0; i < count; ++i)
+					{
+						Square to = targets[i];
+						auto target = board[to];
+						if (target == NoPiece ? !capturesOnly : sideOf(target) == them)
+							list.add({ from, to });
+					}
+				} break;
+
+				default:
+				{
+					int first = typeOf(p) == Bishop ? 4 : 0;
+					int last = typeOf(p) == Rook ? 4 : 8;
+					for (int d = first; d < last; ++d)
+					{
+						int offset = dirOffset(d);
+						Square to = from;
+						for (int n = tables.toEdge[from][d]; n > 0; --n)
+						{
+							to += offset;
+							auto target = board[to];
+							if (target == NoPiece)
+							{
+								if (!capturesOnly) list.add({ from, to });
+								continue;
+							}
+							if (sideOf(target) == them) list.add({ from, to });
+							break;
+						}
+					}
+				} break;
+			}
+		}
+
+		if (capturesOnly)
+			return;
+
+		//  :      ,      
+		int rank = us == Side::White ? 0 : 7;
+		Square kingFrom = toSquare(4, rank);
+		uint8_t kingside = us == Side::White ? WhiteKingside : BlackKingside;
+		uint8_t queenside = us == Side::White ? WhiteQueenside : BlackQueenside;
+		if ((castling & (kingside | queenside)) && board[kingFrom] == makePiece(us, King) && !isAttacked(kingFrom, them))
+		{
+			if ((castling & kingside) &&
+				board[kingFrom + 1] == NoPiece && board[kingFrom + 2] == NoPiece &&
+				!isAttacked(kingFrom + 1, them) && !isAttacked(kingFrom + 2, them))
+			{
+				list.add({ kingFrom, kingFrom + 2, MoveFlag::Castling });
+			}
+			if ((castling & queenside) &&
+				board[kingFrom - 1] == NoPiece && board[kingFrom - 2] == NoPiece && board[kingFrom - 3] == NoPiece &&
+				!isAttacked(kingFrom - 1, them) && !isAttacked(kingFrom - 2, them))
+			{
+				list.add({ kingFrom, kingFrom - 2, MoveFlag::QueensideCastling });
+			}
+		}
+	}
+
+	bool Position::makeMove(Move m, Undo& undo)
+	{
+		undo = { NoPiece, castling, passing, halfMoveClock, key };
+		keyHistory.push_back(key);
+		auto dirty = pushAccumulator();
+
+		auto us = side;
+		auto them = chess::getOtherSide(us);
+		Square from = m.from(), to = m.to();
+		auto piece = board[from];
+
+		++halfMoveClock;
+		if (passing != NoSquare)
+		{
+			key ^= zobrist::keys.passing[fileOf(passing)];
+			passing = NoSquare;
+		}
+
+		Square captureSquare = m.flag() == MoveFlag::Passing ? to - pawnPush(us) : to;
+		if (board[captureSquare] != NoPiece)
+		{
+			undo.captured = board[captureSquare];
+			removePiece(captureSquare);
+			if (dirty) dirty->add(undo.captured, captureSquare, NoSquare);
+		}
+		if (undo.captured != NoPiece || typeOf(piece) == Pawn)
+			halfMoveClock = 0;
+
+		movePiece(from, to);
+		if (dirty)
+		{
+			if (m.isPromotion())
+			{
+				dirty->add(piece, from, NoSquare);
+				dirty->add(makePiece(us, m.promotionType()), NoSquare, to);
+			}
+			else
+			{
+				dirty->add(piece, from, to);
+			}
+		}
+
+		switch (m.flag())
+		{
+			case MoveFlag::DoubleAdvance:
+				passing = from + pawnPush(us);
+				key ^= zobrist::keys.passing[fileOf(passing)];
+				break;
+			case MoveFlag::Castling:
+				movePiece(to + 1, to - 1);
+				if (dirty) dirty->add(board[to - 1], to + 1, to - 1);
+				break;
+			case MoveFlag::QueensideCastling:
+				movePiece(to - 2, to + 1);
+				if (dirty) dirty->add(board[to + 1], to - 2, to + 1);
+				break;
+			default:
+				if (m.isPromotion())
+				{
+					removePiece(to);
+					putPiece(to, makePiece(us, m.promotionType()));
+				}
+				break;
+		}
+
+		key ^= zobrist::keys.castling[castling];
+		castling &= tables.castlingMask[from] & tables.castlingMask[to];
+		key ^= zobrist::keys.castling[castling];
+
+		if (us == Side::Black) ++moveCounter;
+		side = them;
+		key ^= zobrist::keys.side;
+
+		return !isAttacked(kingSquare[us], them);
+	}
+
+	void Position::unmakeMove(Move m, const Undo& undo)
+	{
+		side = chess::getOtherSide(side);
+		auto us = side;
+		if (us == Side::Black) --moveCounter;
+
+		Square from = m.from(), to = m.to();
+		switch (m.flag())
+		{
+			case MoveFlag::Castling:
+				movePiece(to - 1, to + 1);
+				break;
+			case MoveFlag::QueensideCastling:
+				movePiece(to + 1, to - 2);
+				break;
+			default:
+				if (m.isPromotion())
+				{
+					removePiece(to);
+					putPiece(to, makePiece(us, Pawn));
+				}
+				break;
+		}
+		movePiece(to, from);
+
+		if (undo.captured != NoPiece)
+		{
+			Square captureSquare = m.flag() == MoveFlag::Passing ? to - pawnPush(us) : to;
+			putPiece(captureSquare, undo.captured);
+		}
+
+		castling = undo.castling;
+		passing = undo.passing;
+		halfMoveClock = undo.halfMoveClock;
+		key = undo.key;
+		keyHistory.pop_back();
+		if (network)
+			accumulators.pop_back();
+	}
+
+	void Position::makeNullMove(Undo& undo)
+	{
+		undo = { NoPiece, castling, passing, halfMoveClock, key };
+		keyHistory.push_back(key);
+		pushAccumulator();
+
+		if (passing != NoSquare)
+		{
+			key ^= zobrist::keys.passing[fileOf(passing)];
+			passing = NoSquare;
+		}
+		++halfMoveClock;
+		side = chess::getOtherSide(side);
+		key ^= zobrist::keys.side;
+	}
+
+	void Position::unmakeNullMove(const Undo& undo)
+	{
+		side = chess::getOtherSide(side);
+		passing = undo.passing;
+		halfMoveClock = undo.halfMoveClock;
+		key = undo.key;
+		keyHistory.pop_back();
+		if (network)
+			accumulators.pop_back();
+	}
+
+	void Position::setNetwork(const nnue::Network* net)
+	{
+		network = net;
+		accumulators.clear();
+		if (network)
+		{
+			accumulators.reserve(MaxPly + 1);
+			accumulators.emplace_back();
+		}
+	}
+
+	nnue::DirtyPieces* Position::pushAccumulator()
+	{
+		if (!network)
+			return nullptr;
+		accumulators.emplace_back();
+		return &accumulators.back().dirty;
+	}
+
+	bool Position::isRepetition() const
+	{
+		int n = (int)keyHistory.size();
+		int limit = std::max(0, n - halfMoveClock);
+		for (int i = n - 2; i >= limit; i -= 2)
+		{
+			if (keyHistory[i] == key)
+				return true;
+		}
+		return false;
+	}
+
+	Move Position::findMove(chess::FullMove move)
+	{
+		MoveList list;
+		generateLegalMoves(list);
+		for (auto m : list)
+		{
+			if (toPos(m.from()) != move.from || toPos(m.to()) != move.to)
+				continue;
+
+			auto wanted = move.promotionResult == chess::PromotionResult::None
+				? chess::PromotionResult::Queen : move.promotionResult;
+			if (!m.isPromotion() || m.toFullMove().promotionResult == wanted)
+				return m;
+		}
+		return {};
+	}
+}
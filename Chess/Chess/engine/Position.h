@@ -0,0 +1,297 @@
+#pragma once
+
+#include "Bitboard.h"
+#include "Nnue.h"
+#include "Psqt.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chess
+{
+	class BoardState;
+}
+
+namespace engine
+{
+	/// <summary>
+	///   {  ,  , ׸ , ׸  }
+	/// </summary>
+	enum CastlingRights : uint8_t
+	{
+		WhiteKingside  = 1,
+		WhiteQueenside = 2,
+		BlackKingside  = 4,
+		BlackQueenside = 8,
+	};
+
+	/// <summary>
+	///    
+	/// </summary>
+	struct Undo
+	{
+		Piece captured;
+		uint8_t castling;
+		Square passing;
+		int halfMoveClock;
+		uint64_t key;
+	};
+
+	/// <summary>
+	///       
+	/// [ 64    ,       ]
+	/// </summary>
+	class Position
+	{
+	public:
+		Position();
+
+		/// <summary>
+		///      
+		/// </summary>
+		/// <param name="state"> </param>
+		/// <returns> </returns>
+		static Position fromState(const chess::BoardState& state);
+
+		/// <summary>
+		///      FEN
+		/// </summary>
+		/// <param name="fen">   </param>
+		/// <returns> </returns>
+		static Position fromFEN(std::string_view fen);
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <returns> </returns>
+		static Position startPosition();
+
+		/// <summary>
+		///      (        ).
+		///    -    
+		/// </summary>
+		/// <param name="pieces"></param>
+		/// <param name="squares"> </param>
+		/// <param name="count"> </param>
+		/// <param name="toMove"> </param>
+		void setPieces(const Piece* pieces, const Square* squares, int count, chess::Side toMove);
+
+		/// <summary>
+		///    FEN
+		/// </summary>
+		/// <returns>   </returns>
+		std::string getFEN() const;
+
+		constexpr Piece       at(Square s)       const { return board[s]; }
+		constexpr chess::Side getSide()          const { return side; }
+		constexpr uint8_t     getCastling()      const { return castling; }
+		constexpr Square      getPassing()       const { return passing; }
+		constexpr int         getHalfMoveClock() const { return halfMoveClock; }
+		constexpr int         getMoveCounter()   const { return moveCounter; }
+		constexpr uint64_t    getKey()           const { return key; }
+		constexpr uint64_t    getPawnKey()       const { return pawnKey; }
+		constexpr Square      getKingSquare(chess::Side s) const { return kingSquare[s]; }
+
+		/// <summary>
+		///    [ 0 -      ]
+		/// </summary>
+		constexpr int getGamePly() const { return (moveCounter - 1) * 2 + (side == chess::Side::Black); }
+
+		/// <summary>
+		///       (     )
+		/// [    ,      ]
+		/// </summary>
+		constexpr Score getPsq()   const { return psq; }
+
+		/// <summary>
+		///      [ MaxPhase -  , 0 -  ]
+		/// </summary>
+		constexpr int   getPhase() const { return phase < MaxPhase ? phase : MaxPhase; }
+
+		/// <summary>
+		///      
+		/// </summary>
+		/// <param name="p"> (    )</param>
+		/// <returns></returns>
+		constexpr int count(Piece p) const { return pieceCounts[p]; }
+
+		/// <summary>
+		///  , ,      (       )
+		/// </summary>
+		constexpr Bitboard getOfficers() const { return officers; }
+
+		/// <summary>
+		///    
+		/// </summary>
+		constexpr Bitboard getOccupied(chess::Side s) const { return occupied[s]; }
+
+		/// <summary>
+		/// ,         
+		/// [      -  ]
+		/// </summary>
+		/// <param name="s"> </param>
+		/// <returns>true -         </returns>
+		constexpr bool hasNonPawnMaterial(chess::Side s) const
+		{
+			return count(makePiece(s, Knight)) + count(makePiece(s, Bishop)) +
+				   count(makePiece(s, Rook))   + count(makePiece(s, Queen)) > 0;
+		}
+
+		/// <summary>
+		///    [ nullptr -     ].
+		///     
+		/// </summary>
+		/// <param name="net"> </param>
+		void setNetwork(const nnue::Network* net);
+
+		constexpr const nnue::Network* getNetwork() const { return network; }
+
+		/// <summary>
+		///  -  (      )
+		/// </summary>
+		/// <param name="list">  </param>
+		void generateMoves(MoveList& list) const;
+
+		/// <summary>
+		/// -    (    )
+		/// </summary>
+		/// <param name="list">  </param>
+		void generateCaptures(MoveList& list) const;
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="list">  </param>
+		void generateLegalMoves(MoveList& list);
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="m"></param>
+		/// <param name="undo">   </param>
+		/// <returns>false -        (     )</returns>
+		bool makeMove(Move m, Undo& undo);
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="m"></param>
+		/// <param name="undo">,    </param>
+		void unmakeMove(Move m, const Undo& undo);
+
+		/// <summary>
+		///   (      )
+		/// </summary>
+		/// <param name="undo">  </param>
+		void makeNullMove(Undo& undo);
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="undo">,   </param>
+		void unmakeNullMove(const Undo& undo);
+
+		/// <summary>
+		/// ,    
+		/// </summary>
+		/// <param name="s"></param>
+		/// <param name="by">  </param>
+		/// <returns>true -    </returns>
+		bool isAttacked(Square s, chess::Side by) const;
+
+		/// <summary>
+		///   ,    (   ;      ).
+		///     -    
+		/// </summary>
+		/// <param name="s"></param>
+		/// <param name="p"> (    ) [ , , ,    ]</param>
+		/// <returns>  </returns>
+		Bitboard attackersOf(Square s, Piece p) const;
+
+		/// <summary>
+		///   :  ,      (      ),
+		///   .    ,     
+		/// </summary>
+		/// <param name="s">  [ , ,    ]</param>
+		/// <returns> </returns>
+		int mobility(Square s) const;
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <returns>true -   </returns>
+		bool inCheck() const
+		{
+			return isAttacked(kingSquare[side], chess::getOtherSide(side));
+		}
+
+		/// <summary>
+		/// ,       
+		/// </summary>
+		/// <returns>true -    </returns>
+		bool isRepetition() const;
+
+		/// <summary>
+		///        
+		/// </summary>
+		/// <param name="move"> </param>
+		/// <returns>  [   -     ]</returns>
+		Move findMove(chess::FullMove move);
+
+	private:
+		std::array<Piece, 64> board;
+		std::array<uint8_t, 16> pieceCounts;
+		Bitboard officers;
+		chess::SideEntries<Bitboard> occupied;
+		chess::SideEntries<Square> kingSquare;
+		chess::Side side;
+		uint8_t castling;
+
+		/// <summary>
+		/// ,       ( NoSquare -      )
+		/// </summary>
+		Square passing;
+
+		int halfMoveClock;
+		int moveCounter;
+		uint64_t key;
+
+		/// <summary>
+		///      (      )
+		/// </summary>
+		uint64_t pawnKey;
+
+		Score psq;
+		int phase;
+
+		const nnue::Network* network = nullptr;
+
+		/// <summary>
+		///    :      
+		/// [ mutable -   ,   ]
+		/// </summary>
+		mutable std::vector<nnue::Accumulator> accumulators;
+
+		friend class nnue::Network;
+
+		/// <summary>
+		///    (    )
+		/// </summary>
+		std::vector<uint64_t> keyHistory;
+
+		void putPiece(Square s, Piece p);
+		void removePiece(Square s);
+		void movePiece(Square from, Square to);
+
+		void computeKey();
+
+		/// <summary>
+		///     
+		/// </summary>
+		/// <returns>     [ nullptr -     ]</returns>
+		nnue::DirtyPieces* pushAccumulator();
+
+		void generate(MoveList& list, bool capturesOnly) const;
+	};
+}
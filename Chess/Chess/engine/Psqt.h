@@ -0,0 +1,58 @@
+#pragma once
+
+#include "EvalWeights.h"
+#include "Types.h"
+
+namespace engine
+{
+	/// <summary>
+	///   { ,  }      
+	/// </summary>
+	struct Score
+	{
+		int mg = 0;
+		int eg = 0;
+
+		constexpr Score& operator +=(Score o) { mg += o.mg; eg += o.eg; return *this; }
+		constexpr Score& operator -=(Score o) { mg -= o.mg; eg -= o.eg; return *this; }
+
+		friend constexpr Score operator +(Score a, Score b) { return a += b; }
+		friend constexpr Score operator -(Score a, Score b) { return a -= b; }
+		friend constexpr Score operator -(Score a) { return { -a.mg, -a.eg }; }
+		friend constexpr bool operator ==(Score a, Score b) { return a.mg == b.mg && a.eg == b.eg; }
+	};
+
+	/// <summary>
+	///      [ 24 -   , 0 -     ]
+	/// </summary>
+	constexpr std::array<int, 7> PhaseWeight = { 0, 0, 1, 1, 2, 4, 0 };
+	constexpr int MaxPhase = 24;
+
+	/// <summary>
+	///      :     [   ]
+	/// </summary>
+	constexpr std::array<int, 7> MobilityCenter = { 0, 0, 4, 6, 7, 13, 0 };
+
+	/// <summary>
+	///   [  ][  ] :  + ,   
+	/// [  - ,  -  ;       ]
+	/// </summary>
+	constexpr auto Psqt = []()
+	{
+		std::array<std::array<Score, 64>, 16> res = {};
+		for (int type = Pawn; type <= King; ++type)
+		{
+			for (Square s = 0; s < 64; ++s)
+			{
+				//  0 - a1,     8- 
+				Square white = s ^ 56;
+				Square black = s;
+				res[makePiece(chess::Side::White, PieceType(type))][s] = {
+					MgValue[type] + MgTable[type][white], EgValue[type] + EgTable[type][white] };
+				res[makePiece(chess::Side::Black, PieceType(type))][s] = {
+					-(MgValue[type] + MgTable[type][black]), -(EgValue[type] + EgTable[type][black]) };
+			}
+		}
+		return res;
+	}();
+}
@@ -0,0 +1,239 @@
+#include "San.h"
+
+namespace engine::san
+{
+	namespace
+	{
+		constexpr char PieceLetters[] = " PNBRQK";
+
+		constexpr PieceType pieceFromLetter(char c)
+		{
+			switch (c)
+			{
+				case 'N': return Knight;
+				case 'B': return Bishop;
+				case 'R': return Rook;
+				case 'Q': return Queen;
+				case 'K': return King;
+			}
+			return NoType;
+		}
+
+		/// <summary>
+		///  -     
+		/// </summary>
+		bool isLegal(Position& pos, Move m)
+		{
+			Undo undo;
+			bool legal = pos.makeMove(m, undo);
+			pos.unmakeMove(m, undo);
+			return legal;
+		}
+
+		bool hasLegalMove(Position& pos)
+		{
+			MoveList list;
+			pos.generateMoves(list);
+			for (auto m : list)
+			{
+				if (isLegal(pos, m))
+					return true;
+			}
+			return false;
+		}
+
+		char* writeSquare(char* p, Square s)
+		{
+			*p++ = char('a' + fileOf(s));
+			*p++ = char('1' + rankOf(s));
+			return p;
+		}
+	}
+
+	int write(Position& pos, Move m, char* buffer)
+	{
+		char* p = buffer;
+		auto from = m.from(), to = m.to();
+
+		if (m.flag() == MoveFlag::Castling || m.flag() == MoveFlag::QueensideCastling)
+		{
+			for (char c : std::string_view(m.flag() == MoveFlag::Castling ? "O-O" : "O-O-O"))
+				*p++ = c;
+		}
+		else
+		{
+			auto piece = pos.at(from);
+			bool capture = pos.at(to) != NoPiece || m.flag() == MoveFlag::Passing;
+			if (typeOf(piece) == Pawn)
+			{
+				if (capture)
+					*p++ = char('a' + fileOf(from));
+			}
+			else
+			{
+				*p++ = PieceLetters[typeOf(piece)];
+
+				//         ,        
+				// [      ]
+				bool ambiguous = false, sameFile = false, sameRank = false;
+				for (auto others = pos.attackersOf(to, piece) & ~bit(from); others;)
+				{
+					auto s = popLsb(others);
+					if (!isLegal(pos, { s, to }))
+						continue;
+					ambiguous = true;
+					sameFile |= fileOf(s) == fileOf(from);
+					sameRank |= rankOf(s) == rankOf(from);
+				}
+				if (ambiguous && (!sameFile || sameRank))
+					*p++ = char('a' + fileOf(from));
+				if (ambiguous && sameFile)
+					*p++ = char('1' + rankOf(from));
+			}
+
+			if (capture)
+				*p++ = 'x';
+			p = writeSquare(p, to);
+			if (m.isPromotion())
+			{
+				*p++ = '=';
+				*p++ = PieceLetters[m.promotionType()];
+			}
+		}
+
+		Undo undo;
+		pos.makeMove(m, undo);
+		if (pos.inCheck())
+			*p++ = hasLegalMove(pos) ? '+' : '#';
+		pos.unmakeMove(m, undo);
+
+		*p = '\0';
+		return int(p - buffer);
+	}
+
+	Move parse(Position& pos, std::string_view text)
+	{
+		while (!text.empty() && (text.back() == '+' || text.back() == '#' || text.back() == '!' || text.back() == '?'))
+			text.remove_suffix(1);
+		if (text.size() < 2)
+			return {};
+
+		//    :     
+		if (text[0] == 'O' || text[0] == '0')
+		{
+			bool queenside = text == "O-O-O" || text == "0-0-0";
+			if (!queenside && text != "O-O" && text != "0-0")
+				return {};
+			auto flag = queenside ? MoveFlag::QueensideCastling : MoveFlag::Castling;
+
+			MoveList list;
+			pos.generateMoves(list);
+			for (auto m : list)
+			{
+				if (m.flag() == flag)
+					return isLegal(pos, m) ? m : Move();
+			}
+			return {};
+		}
+
+		auto type = pieceFromLetter(text[0]);
+		if (type != NoType)
+			text.remove_prefix(1);
+		else
+			type = Pawn;
+
+		//  : "e8=Q"  "e8Q"
+		auto promotion = NoType;
+		if (type == Pawn && text.size() >= 3)
+		{
+			char c = text.back();
+			bool withSign = text[text.size() - 2] == '=';
+			if (withSign && c >= 'a' && c <= 'z')
+				c = char(c - 'a' + 'A');
+			if (auto p = pieceFromLetter(c); p != NoType && p != King)
+			{
+				promotion = p;
+				text.remove_suffix(withSign ? 2 : 1);
+			}
+		}
+		if (text.size() < 2)
+			return {};
+
+		int toFile = text[text.size() - 2] - 'a', toRank = text[text.size() - 1] - '1';
+		if (toFile < 0 || toFile > 7 || toRank < 0 || toRank > 7)
+			return {};
+		Square to = toSquare(toFile, toRank);
+		text.remove_suffix(2);
+
+		//  :   /    ,   
+		int fromFile = -1, fromRank = -1;
+		for (char c : text)
+		{
+			if (c >= 'a' && c <= 'h')      fromFile = c - 'a';
+			else if (c >= '1' && c <= '8') fromRank = c - '1';
+			else if (c != 'x' && c != ':' && c != '-') return {};
+		}
+
+		auto us = pos.getSide();
+		auto target = pos.at(to);
+		if (target != NoPiece && (sideOf(target) == us || typeOf(target) == King))
+			return {};
+
+		if (type == Pawn)
+		{
+			int dir = us == chess::Side::White ? 1 : -1;
+			int promotionRank = us == chess::Side::White ? 7 : 0;
+			int back = toRank - dir;
+			if ((toRank == promotionRank) != (promotion != NoType) || back < 0 || back > 7)
+				return {};
+
+			auto flag = promotion != NoType ? MoveFlag(int(MoveFlag::PromoKnight) + promotion - Knight) : MoveFlag::Normal;
+			Square from;
+			if (fromFile < 0 || fromFile == toFile)
+			{
+				//   :         
+				if (target != NoPiece)
+					return {};
+				from = toSquare(toFile, back);
+				if (pos.at(from) == NoPiece && toRank == (us == chess::Side::White ? 3 : 4))
+				{
+					from -= 8 * dir;
+					flag = MoveFlag::DoubleAdvance;
+				}
+			}
+			else
+			{
+				if (fromFile != toFile - 1 && fromFile != toFile + 1)
+					return {};
+				from = toSquare(fromFile, back);
+				if (target == NoPiece)
+				{
+					if (to != pos.getPassing())
+						return {};
+					flag = MoveFlag::Passing;
+				}
+			}
+			if (pos.at(from) != makePiece(us, Pawn) || (fromRank >= 0 && rankOf(from) != fromRank))
+				return {};
+
+			Move m(from, to, flag);
+			return isLegal(pos, m) ? m : Move();
+		}
+
+		//    ,    , -     
+		Move found;
+		for (auto candidates = pos.attackersOf(to, makePiece(us, type)); candidates;)
+		{
+			auto from = popLsb(candidates);
+			if ((fromFile >= 0 && fileOf(from) != fromFile) || (fromRank >= 0 && rankOf(from) != fromRank))
+				continue;
+			Move m(from, to);
+			if (!isLegal(pos, m))
+				continue;
+			if (!found.isNone())
+				return {};
+			found = m;
+		}
+		return found;
+	}
+}
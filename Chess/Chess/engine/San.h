@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Position.h"
+
+#include <string_view>
+
+namespace engine::san
+{
+	/// <summary>
+	///        ( "Qa1xb2+", "exd8=Q#" )
+	/// </summary>
+	constexpr int BufferSize = 8;
+
+	/// <summary>
+	///        ( SAN ) : ,   ,
+	/// ,  ,      .    
+	///    ,    [    ]
+	/// </summary>
+	/// <param name="pos">   [     ]</param>
+	/// <param name="m"> </param>
+	/// <param name="buffer">   BufferSize  (    )</param>
+	/// <returns> </returns>
+	int write(Position& pos, Move m, char* buffer);
+
+	/// <summary>
+	///      .  "0-0",   '=' ( "e8Q" ),
+	///   ( "Ng1f3" )     ( "!", "?" )
+	/// </summary>
+	/// <param name="pos"> [     ]</param>
+	/// <param name="text"> ( "Nbd7", "exd8=Q+", "O-O" )</param>
+	/// <returns>  [   -   ,     ]</returns>
+	Move parse(Position& pos, std::string_view text);
+}
@@ -0,0 +1,394 @@
+#include "Search.h"
+
+#include "Evaluate.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace engine
+{
+	namespace
+	{
+		/// <summary>
+		///        : ln(x) = 2 * atanh((x - 1) / (x + 1))
+		/// </summary>
+		constexpr double constexprLog(double x)
+		{
+			double y = (x - 1) / (x + 1);
+			double y2 = y * y;
+			double term = y, sum = 0;
+			for (int n = 1; n < 200; n += 2)
+			{
+				sum += term / n;
+				term *= y2;
+			}
+			return 2 * sum;
+		}
+
+		/// <summary>
+		///    [  ][   ]
+		/// </summary>
+		constexpr auto Reductions = []()
+		{
+			std::array<std::array<int, 64>, 64> res = {};
+			for (int depth = 1; depth < 64; ++depth)
+				for (int moveNumber = 1; moveNumber < 64; ++moveNumber)
+					res[depth][moveNumber] = int(0.75 + constexprLog(depth) * constexprLog(moveNumber) / 2.25);
+			return res;
+		}();
+
+		constexpr int FutilityMargin[4] = { 0, 150, 300, 500 };
+	}
+
+	SearchResult Searcher::search(Position& pos, const SearchLimits& searchLimits)
+	{
+		limits = searchLimits;
+		stats = {};
+		pawns.resetStats();
+		stopFlag = false;
+		startTime = std::chrono::steady_clock::now();
+		pvLength[0] = 0;
+
+		if (pos.getNetwork() != options.network.get())
+			pos.setNetwork(options.network.get());
+
+		SearchResult result;
+		prevPv.clear();
+		ordering.age(rootPly < 0 ? MaxPly : pos.getGamePly() - rootPly);
+		rootPly = pos.getGamePly();
+
+		//    :      ,    
+		if (predictedKey == pos.getKey() && !predictedPv.empty())
+		{
+			prevPv = predictedPv;
+			stats.reusedPv = prevPv.size();
+		}
+		predictedKey = 0;
+		predictedPv.clear();
+
+		int lineCount = 1;
+		if (limits.multiPv > 1)
+		{
+			MoveList legal;
+			pos.generateLegalMoves(legal);
+			int rootMoves = 0;
+			for (auto m : legal)
+				rootMoves += limits.searchMoves.empty() || std::find(limits.searchMoves.begin(), limits.searchMoves.end(), m) != limits.searchMoves.end();
+			lineCount = std::min(limits.multiPv, rootMoves);
+		}
+
+		for (int depth = 1; depth <= limits.depth && depth < MaxPly; ++depth)
+		{
+			int score = alphaBeta(pos, -Infinity, Infinity, depth, 0, {});
+			stats.pawnProbes = pawns.getProbes();
+			stats.pawnHits = pawns.getHits();
+
+			//    ,    
+			if (stopFlag && !result.best.isNone())
+				break;
+
+			result.score = score;
+			result.depth = depth;
+			result.pv.assign(pv[0], pv[0] + pvLength[0]);
+			if (!result.pv.empty())
+				result.best = result.pv.front();
+			//     ,      
+			bool prefix = result.pv.size() <= prevPv.size() && std::equal(result.pv.begin(), result.pv.end(), prevPv.begin());
+			if (!prefix)
+				prevPv = result.pv;
+
+			//   :         
+			std::vector<PvLine> lines = { { score, result.pv } };
+			for (int k = 1; k < lineCount && !stopFlag && !result.pv.empty(); ++k)
+			{
+				rootExcluded.push_back(lines.back().pv.front());
+				int lineScore = alphaBeta(pos, -Infinity, Infinity, depth, 0, {});
+				if (stopFlag || pvLength[0] == 0)
+					break;
+				lines.push_back({ lineScore, { pv[0], pv[0] + pvLength[0] } });
+			}
+			rootExcluded.clear();
+			std::stable_sort(lines.begin() + 1, lines.end(), [](const PvLine& a, const PvLine& b) { return a.score > b.score; });
+
+			//         
+			if (int(lines.size()) == lineCount || lines.size() >= result.lines.size())
+				result.lines = std::move(lines);
+			else
+				result.lines.front() = lines.front();
+
+			if (onIteration)
+				onIteration(result);
+
+			if (stopFlag || std::abs(score) >= MateBound)
+				break;
+		}
+
+		if (result.pv.size() > 2)
+		{
+			Undo first, second;
+			pos.makeMove(result.pv[0], first);
+			pos.makeMove(result.pv[1], second);
+			predictedKey = pos.getKey();
+			pos.unmakeMove(result.pv[1], second);
+			pos.unmakeMove(result.pv[0], first);
+			predictedPv.assign(result.pv.begin() + 2, result.pv.end());
+		}
+		return result;
+	}
+
+	bool Searcher::shouldStop()
+	{
+		if (stopFlag)
+			return true;
+		if (limits.stop && limits.stop->load(std::memory_order_relaxed))
+			return stopFlag = true;
+		if ((stats.nodes & 1023) != 0)
+			return false;
+
+		if (limits.nodes != 0 && stats.nodes >= limits.nodes)
+			stopFlag = true;
+		if (limits.movetimeMs != 0)
+		{
+			auto elapsed = std::chrono::steady_clock::now() - startTime;
+			if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits.movetimeMs)
+				stopFlag = true;
+		}
+		return stopFlag;
+	}
+
+	void Searcher::updatePv(int ply, Move m)
+	{
+		pv[ply][0] = m;
+		for (int i = 0; i < pvLength[ply + 1]; ++i)
+			pv[ply][i + 1] = pv[ply + 1][i];
+		pvLength[ply] = pvLength[ply + 1] + 1;
+	}
+
+	int Searcher::alphaBeta(Position& pos, int alpha, int beta, int depth, int ply, Move prevMove, bool allowNull)
+	{
+		pvLength[ply] = 0;
+		bool inCheck = pos.inCheck();
+
+		if (inCheck && options.checkExtensions && ply < MaxPly / 2)
+		{
+			++depth;
+			++stats.checkExtensions;
+		}
+		if (depth <= 0 || ply >= MaxPly - 1)
+			return quiescence(pos, alpha, beta, ply);
+
+		++stats.nodes;
+		if (shouldStop())
+			return 0;
+
+		if (ply > 0 && (pos.isRepetition() || pos.getHalfMoveClock() >= 100))
+			return 0;
+
+		bool pvNode = beta - alpha > 1;
+		int alphaOrig = alpha;
+
+		//               
+		TTEntry ttEntry;
+		auto* table = options.table.get();
+		if (table && table->probe(pos.getKey(), ttEntry))
+		{
+			++stats.tableHits;
+			int ttScore = TranspositionTable::scoreFromTable(ttEntry.score, ply);
+			if (!pvNode && ttEntry.depth >= depth &&
+				(ttEntry.bound == Bound::Exact ||
+				 (ttEntry.bound == Bound::Lower && ttScore >= beta) ||
+				 (ttEntry.bound == Bound::Upper && ttScore <= alpha)))
+			{
+				++stats.tableCutoffs;
+				return ttScore;
+			}
+		}
+
+		bool canPrune = !pvNode && !inCheck && std::abs(beta) < MateBound;
+		int staticEval = inCheck ? -Infinity : evaluate(pos, &pawns);
+
+		//   :    beta,    
+		if (options.reverseFutility && canPrune && depth <= 6 && staticEval - 90 * depth >= beta)
+		{
+			++stats.reverseFutilityPrunes;
+			return staticEval;
+		}
+
+		//   :         beta - .
+		//   (   )  ,    
+		if (options.nullMove && allowNull && canPrune && depth >= 3 && staticEval >= beta &&
+			pos.hasNonPawnMaterial(pos.getSide()))
+		{
+			int r = 3 + depth / 6;
+			Undo undo;
+			pos.makeNullMove(undo);
+			int score = -alphaBeta(pos, -beta, -beta + 1, depth - 1 - r, ply + 1, {}, false);
+			pos.unmakeNullMove(undo);
+
+			if (stopFlag)
+				return 0;
+			if (score >= beta)
+			{
+				++stats.nullMoveCutoffs;
+				return score >= MateBound ? beta : score;
+			}
+		}
+
+		//  :         alpha
+		bool futile = options.futility && canPrune && depth <= 3 &&
+			          staticEval + FutilityMargin[depth] <= alpha;
+
+		MoveList list;
+		pos.generateMoves(list);
+		if (options.moveOrdering)
+		{
+			Move pvMove = !ttEntry.move.isNone() ? ttEntry.move : ply < (int)prevPv.size() ? prevPv[ply] : Move();
+			ordering.score(list, pos, ply, pvMove, prevMove);
+		}
+
+		Move quiets[MaxMoves];
+		int quietCount = 0;
+		int legalCount = 0;
+		int bestScore = -Infinity;
+		Move bestMove;
+
+		//         (   Piece::getValidMoves )
+		for (int i = 0; i < list.size(); ++i)
+		{
+			auto m = options.moveOrdering ? list.pickNext(i) : list[i];
+			if (ply == 0 && ((!limits.searchMoves.empty() &&
+				std::find(limits.searchMoves.begin(), limits.searchMoves.end(), m) == limits.searchMoves.end()) ||
+				std::find(rootExcluded.begin(), rootExcluded.end(), m) != rootExcluded.end()))
+			{
+				continue;
+			}
+			bool quiet = MoveOrdering::isQuiet(pos, m);
+
+			Undo undo;
+			if (!pos.makeMove(m, undo))
+			{
+				pos.unmakeMove(m, undo);
+				continue;
+			}
+			++legalCount;
+			bool givesCheck = pos.inCheck();
+
+			if (futile && quiet && !givesCheck && legalCount > 1)
+			{
+				++stats.futilityPrunes;
+				pos.unmakeMove(m, undo);
+				continue;
+			}
+
+			int score;
+			if (legalCount == 1)
+			{
+				score = -alphaBeta(pos, -beta, -alpha, depth - 1, ply + 1, m);
+			}
+			else
+			{
+				//        
+				int r = 0;
+				if (options.lateMoveReductions && depth >= 3 && quiet && !inCheck && !givesCheck)
+				{
+					r = Reductions[std::min(depth, 63)][std::min(legalCount, 63)];
+					if (pvNode) --r;
+					r = std::clamp(r, 0, depth - 2);
+					if (r > 0) ++stats.reductions;
+				}
+
+				score = -alphaBeta(pos, -alpha - 1, -alpha, depth - 1 - r, ply + 1, m);
+				if (score > alpha && r > 0)
+				{
+					++stats.reSearches;
+					score = -alphaBeta(pos, -alpha - 1, -alpha, depth - 1, ply + 1, m);
+				}
+				if (score > alpha && score < beta)
+					score = -alphaBeta(pos, -beta, -alpha, depth - 1, ply + 1, m);
+			}
+			pos.unmakeMove(m, undo);
+
+			if (stopFlag)
+				return 0;
+
+			if (score > bestScore)
+			{
+				bestScore = score;
+				bestMove = m;
+			}
+
+			if (score > alpha)
+			{
+				alpha = score;
+				updatePv(ply, m);
+			}
+			if (alpha >= beta)
+			{
+				++stats.cutoffs;
+				if (legalCount == 1)
+					++stats.firstMoveCutoffs;
+				if (quiet && options.moveOrdering)
+					ordering.onCutoff(pos, m, prevMove, ply, depth, quiets, quietCount);
+				break;
+			}
+			if (quiet)
+				quiets[quietCount++] = m;
+		}
+
+		if (legalCount == 0)
+			return inCheck ? -MateScore + ply : 0;
+
+		//     -   
+		if (table && !(ply == 0 && !rootExcluded.empty()))
+		{
+			auto bound = bestScore >= beta ? Bound::Lower : bestScore > alphaOrig ? Bound::Exact : Bound::Upper;
+			table->store(pos.getKey(), { bound == Bound::Upper ? Move() : bestMove,
+				         TranspositionTable::scoreToTable(bestScore, ply), depth, bound });
+		}
+		return bestScore;
+	}
+
+	int Searcher::quiescence(Position& pos, int alpha, int beta, int ply)
+	{
+		++stats.nodes;
+		++stats.qnodes;
+		if (shouldStop())
+			return 0;
+
+		int standPat = evaluate(pos, &pawns);
+		if (standPat >= beta || ply >= MaxPly - 1)
+			return standPat;
+		if (standPat > alpha)
+			alpha = standPat;
+
+		//     MVV-LVA :      
+		MoveList list;
+		pos.generateCaptures(list);
+		ordering.scoreCaptures(list, pos);
+
+		for (int i = 0; i < list.size(); ++i)
+		{
+			auto m = list.pickNext(i);
+
+			Undo undo;
+			if (!pos.makeMove(m, undo))
+			{
+				pos.unmakeMove(m, undo);
+				continue;
+			}
+			int score = -quiescence(pos, -beta, -alpha, ply + 1);
+			pos.unmakeMove(m, undo);
+
+			if (stopFlag)
+				return 0;
+
+			if (score > alpha)
+			{
+				alpha = score;
+				if (alpha >= beta)
+					break;
+			}
+		}
+		return alpha;
+	}
+}
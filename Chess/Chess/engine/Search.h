@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Position.h"
+#include "MoveOrdering.h"
+#include "Pawns.h"
+#include "Transposition.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine
+{
+	/// <summary>
+	///   [ 0 -   ]
+	/// </summary>
+	struct SearchLimits
+	{
+		int depth = MaxPly - 1;
+		uint64_t nodes = 0;
+		int64_t movetimeMs = 0;
+
+		/// <summary>
+		///       [  -   ]
+		/// </summary>
+		std::vector<Move> searchMoves;
+
+		/// <summary>
+		///    :     k      1 .. k - 1
+		/// </summary>
+		int multiPv = 1;
+
+		/// <summary>
+		///   ,      [ nullptr -  ].
+		///    ,    
+		/// </summary>
+		const std::atomic<bool>* stop = nullptr;
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	struct SearchOptions
+	{
+		bool moveOrdering       = true;
+		bool nullMove           = true;
+		bool lateMoveReductions = true;
+		bool futility           = true;
+		bool reverseFutility    = true;
+		bool checkExtensions    = true;
+
+		/// <summary>
+		///   [ nullptr -     ]
+		/// </summary>
+		std::shared_ptr<const nnue::Network> network;
+
+		/// <summary>
+		///  ,       [ nullptr -   ]
+		/// </summary>
+		std::shared_ptr<TranspositionTable> table;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct SearchStats
+	{
+		uint64_t nodes = 0;
+		uint64_t qnodes = 0;
+		uint64_t cutoffs = 0;
+		uint64_t firstMoveCutoffs = 0;
+
+		uint64_t nullMoveCutoffs = 0;
+		uint64_t reductions = 0;
+		uint64_t reSearches = 0;
+		uint64_t futilityPrunes = 0;
+		uint64_t reverseFutilityPrunes = 0;
+		uint64_t checkExtensions = 0;
+
+		uint64_t pawnProbes = 0;
+		uint64_t pawnHits = 0;
+
+		uint64_t tableHits = 0;
+		uint64_t tableCutoffs = 0;
+
+		/// <summary>
+		///   ,     [ 0 -     ]
+		/// </summary>
+		uint64_t reusedPv = 0;
+
+		/// <summary>
+		///  ,    
+		/// </summary>
+		/// <returns>  0  1</returns>
+		double firstMoveCutoffRate() const
+		{
+			return cutoffs == 0 ? 0.0 : double(firstMoveCutoffs) / cutoffs;
+		}
+
+		/// <summary>
+		///    ,   
+		/// </summary>
+		/// <returns>  0  1</returns>
+		double pawnHitRate() const
+		{
+			return pawnProbes == 0 ? 0.0 : double(pawnHits) / pawnProbes;
+		}
+	};
+
+	/// <summary>
+	///    :        
+	/// </summary>
+	struct PvLine
+	{
+		int score = 0;
+		std::vector<Move> pv;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct SearchResult
+	{
+		Move best;
+		int score = 0;
+		int depth = 0;
+		std::vector<Move> pv;
+
+		/// <summary>
+		///        
+		/// ( SearchLimits::multiPv ,     ;    pv )
+		/// </summary>
+		std::vector<PvLine> lines;
+	};
+
+	/// <summary>
+	///   -    .
+	///   -    (       )
+	/// </summary>
+	class Searcher
+	{
+	public:
+		SearchOptions options;
+
+		/// <summary>
+		///          [    ]
+		/// </summary>
+		std::function<void(const SearchResult&)> onIteration;
+
+		Searcher() = default;
+		Searcher(const Searcher&) = delete;
+		Searcher& operator=(const Searcher&) = delete;
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="pos"> [     ]</param>
+		/// <param name="limits"> </param>
+		/// <returns>     </returns>
+		SearchResult search(Position& pos, const SearchLimits& limits);
+
+		/// <summary>
+		///   (      )
+		/// </summary>
+		void stop() { stopFlag = true; }
+
+		/// <summary>
+		///      .
+		///       :  ,   
+		/// </summary>
+		void newGame()
+		{
+			ordering.clear();
+			pawns.clear();
+			rootPly = -1;
+			predictedKey = 0;
+			predictedPv.clear();
+		}
+
+		const SearchStats& getStats() const { return stats; }
+
+	private:
+		MoveOrdering ordering;
+		PawnTable pawns;
+		SearchStats stats;
+		SearchLimits limits;
+		std::atomic<bool> stopFlag = false;
+		std::chrono::steady_clock::time_point startTime;
+
+		/// <summary>
+		///    
+		/// </summary>
+		Move pv[MaxPly + 1][MaxPly + 1];
+		int pvLength[MaxPly + 1];
+
+		/// <summary>
+		///     (     )
+		/// </summary>
+		std::vector<Move> prevPv;
+
+		/// <summary>
+		///   ,       (    )
+		/// </summary>
+		std::vector<Move> rootExcluded;
+
+		/// <summary>
+		///       [ -1 -        ]
+		/// </summary>
+		int rootPly = -1;
+
+		/// <summary>
+		///      (      )
+		///       :   ,    
+		/// </summary>
+		uint64_t predictedKey = 0;
+		std::vector<Move> predictedPv;
+
+		/// <summary>
+		///         ( PVS )
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="alpha"> </param>
+		/// <param name="beta"> </param>
+		/// <param name="depth"> </param>
+		/// <param name="ply">  </param>
+		/// <param name="prevMove">  (     )</param>
+		/// <param name="allowNull">    (     )</param>
+		/// <returns> </returns>
+		int alphaBeta(Position& pos, int alpha, int beta, int depth, int ply, Move prevMove, bool allowNull = true);
+		int quiescence(Position& pos, int alpha, int beta, int ply);
+
+		/// <summary>
+		///      
+		/// </summary>
+		/// <returns>true -    </returns>
+		bool shouldStop();
+
+		void updatePv(int ply, Move m);
+	};
+}
@@ -0,0 +1,473 @@
+#include "Tablebase.h"
+
+#include "../chess/BoardState.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace engine::tb
+{
+	namespace
+	{
+		constexpr std::string_view PieceLetters = " PNBRQK";
+
+		/// <summary>
+		///      :    
+		/// </summary>
+		constexpr PieceType NameOrder[] = { Queen, Rook, Bishop, Knight, Pawn };
+
+		/// <summary>
+		///   a1-d1-d4       
+		/// </summary>
+		constexpr Square TriangleSquares[10] = { 0, 1, 2, 3, 9, 10, 11, 18, 19, 27 };
+
+		constexpr auto TriangleSlot = []()
+		{
+			std::array<int, 64> res = {};
+			for (auto& r : res)
+				r = -1;
+			for (int i = 0; i < 10; ++i)
+				res[TriangleSquares[i]] = i;
+			return res;
+		}();
+
+		constexpr Square transpose(Square s) { return (fileOf(s) << 3) | rankOf(s); }
+
+		/// <summary>
+		///        
+		/// </summary>
+		bool passingCapturable(const Position& pos)
+		{
+			Square target = pos.getPassing();
+			if (target == NoSquare)
+				return false;
+			int pawnRank = rankOf(target) + (pos.getSide() == chess::Side::White ? -1 : 1);
+			auto pawn = makePiece(pos.getSide(), Pawn);
+			for (int dx : { -1, 1 })
+			{
+				int x = fileOf(target) + dx;
+				if (x >= 0 && x < 8 && pos.at(toSquare(x, pawnRank)) == pawn)
+					return true;
+			}
+			return false;
+		}
+
+		std::string joinPath(const std::string& directory, const std::string& name)
+		{
+			if (directory.empty())
+				return name;
+			auto last = directory.back();
+			return directory + (last == '/' || last == '\\' ? "" : "/") + name;
+		}
+
+		uint64_t readU64(const std::byte* p)
+		{
+			uint64_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+	}
+
+	std::vector<uint8_t> compressBlock(const uint8_t* data, size_t size)
+	{
+		std::vector<uint8_t> res;
+		size_t i = 0;
+		while (i < size)
+		{
+			size_t run = 1;
+			while (i + run < size && run < 130 && data[i + run] == data[i])
+				++run;
+
+			if (run >= 3)
+			{
+				res.push_back(uint8_t(run + 125));
+				res.push_back(data[i]);
+				i += run;
+				continue;
+			}
+
+			//   -        
+			size_t start = i, count = 0;
+			while (i < size && count < 128)
+			{
+				if (i + 2 < size && data[i] == data[i + 1] && data[i] == data[i + 2])
+					break;
+				++i;
+				++count;
+			}
+			res.push_back(uint8_t(count - 1));
+			res.insert(res.end(), data + start, data + start + count);
+		}
+		return res;
+	}
+
+	bool decompressBlock(const uint8_t* data, size_t size, uint8_t* out, size_t outSize)
+	{
+		size_t i = 0, o = 0;
+		while (i < size)
+		{
+			uint8_t c = data[i++];
+			if (c < 128)
+			{
+				size_t count = size_t(c) + 1;
+				if (i + count > size || o + count > outSize)
+					return false;
+				std::memcpy(out + o, data + i, count);
+				i += count;
+				o += count;
+			}
+			else
+			{
+				size_t count = size_t(c) - 125;
+				if (i >= size || o + count > outSize)
+					return false;
+				std::memset(out + o, data[i++], count);
+				o += count;
+			}
+		}
+		return o == outSize;
+	}
+
+	std::optional<Layout> Layout::fromName(std::string_view material)
+	{
+		auto v = material.find('v');
+		if (v == std::string_view::npos || material.size() > sizeof(FileHeader::material) - 1)
+			return std::nullopt;
+
+		Layout res;
+		res.material = std::string(material);
+		std::vector<Piece> others;
+		for (auto side : { chess::Side::White, chess::Side::Black })
+		{
+			auto half = side == chess::Side::White ? material.substr(0, v) : material.substr(v + 1);
+			if (half.empty() || half[0] != 'K')
+				return std::nullopt;
+			res.pieces.push_back(makePiece(side, King));
+
+			for (auto c : half.substr(1))
+			{
+				auto type = PieceLetters.find(c);
+				if (type == std::string_view::npos || type == King || type == NoType)
+					return std::nullopt;
+				others.push_back(makePiece(side, PieceType(type)));
+				res.pawns |= type == Pawn;
+			}
+		}
+		res.pieces.insert(res.pieces.end(), others.begin(), others.end());
+		if (res.pieces.size() > MaxPieces)
+			return std::nullopt;
+
+		res.perSide = res.pawns ? 32 : 10;
+		for (size_t i = 1; i < res.pieces.size(); ++i)
+			res.perSide *= 64;
+		return res;
+	}
+
+	std::string Layout::nameOf(const Position& pos, bool flipped)
+	{
+		std::string res;
+		for (auto side : { chess::Side::White, chess::Side::Black })
+		{
+			auto s = flipped ? chess::getOtherSide(side) : side;
+			if (!res.empty())
+				res += 'v';
+			res += 'K';
+			for (auto type : NameOrder)
+				res.append(pos.count(makePiece(s, type)), PieceLetters[type]);
+		}
+		return res;
+	}
+
+	uint64_t Layout::index(const Square* squares, chess::Side side) const
+	{
+		//     :   ,
+		//    -       a1-h8
+		Square king = squares[0];
+		bool mirrorFile = fileOf(king) > 3;
+		if (mirrorFile) king ^= 7;
+		bool mirrorRank = !pawns && rankOf(king) > 3;
+		if (mirrorRank) king ^= 56;
+		bool flipDiagonal = !pawns && rankOf(king) > fileOf(king);
+
+		//    :      ,
+		//       
+		if (!pawns && rankOf(king) == fileOf(king))
+		{
+			for (size_t i = 1; i < pieces.size(); ++i)
+			{
+				Square s = squares[i];
+				if (mirrorFile) s ^= 7;
+				if (mirrorRank) s ^= 56;
+				if (rankOf(s) != fileOf(s))
+				{
+					flipDiagonal = rankOf(s) > fileOf(s);
+					break;
+				}
+			}
+		}
+
+		auto map = [&](Square s)
+		{
+			if (mirrorFile)   s ^= 7;
+			if (mirrorRank)   s ^= 56;
+			if (flipDiagonal) s = transpose(s);
+			return s;
+		};
+
+		king = map(squares[0]);
+		uint64_t idx = pawns ? uint64_t(rankOf(king) * 4 + fileOf(king)) : uint64_t(TriangleSlot[king]);
+		for (size_t i = 1; i < pieces.size(); ++i)
+			idx = idx * 64 + uint64_t(map(squares[i]));
+		return idx + (side == chess::Side::Black ? perSide : 0);
+	}
+
+	chess::Side Layout::squares(uint64_t idx, Square* squares) const
+	{
+		auto side = idx >= perSide ? chess::Side::Black : chess::Side::White;
+		idx %= perSide;
+		for (size_t i = pieces.size() - 1; i > 0; --i)
+		{
+			squares[i] = Square(idx % 64);
+			idx /= 64;
+		}
+		squares[0] = pawns ? Square((idx / 4) * 8 + idx % 4) : TriangleSquares[idx];
+		return side;
+	}
+
+	Tablebase::Tablebase(std::string directory, size_t cacheBlocks)
+		: directory(std::move(directory)), cacheCapacity(std::max<size_t>(cacheBlocks, 1))
+	{}
+
+	bool Tablebase::canProbe(const Position& pos)
+	{
+		int total = 0;
+		for (Piece p = 0; p < 16; ++p)
+			total += pos.count(p);
+		return total <= MaxPieces && pos.getCastling() == 0 && !passingCapturable(pos);
+	}
+
+	const Tablebase::File* Tablebase::open(const std::string& name) const
+	{
+		std::lock_guard lock(filesMutex);
+		auto it = files.find(name);
+		if (it != files.end())
+			return it->second.get();
+
+		auto& slot = files[name];
+		auto path = joinPath(directory, name);
+		auto file = std::make_unique<File>();
+		try
+		{
+			file->mapped = core::MappedFile(path);
+		}
+		catch (const std::exception&)
+		{
+			return nullptr; //   -      
+		}
+
+		auto fail = [&](const char* why) -> const File*
+		{
+			std::clog << "tablebase: " << path << ": " << why << "\n";
+			return nullptr;
+		};
+
+		if (file->mapped.size() < sizeof(FileHeader))
+			return fail("file is too small");
+		std::memcpy(&file->header, file->mapped.data(), sizeof(FileHeader));
+		auto& h = file->header;
+
+		bool isDtm = std::memcmp(h.magic, DtmMagic, 4) == 0;
+		if ((!isDtm && std::memcmp(h.magic, WdlMagic, 4) != 0) || h.version != FormatVersion)
+			return fail("unknown format");
+
+		h.material[sizeof(h.material) - 1] = '\0';
+		auto layout = Layout::fromName(h.material);
+		if (!layout || name.compare(0, layout->name().size() + 1, layout->name() + ".") != 0)
+			return fail("wrong material");
+		if (h.entries != layout->size() || h.blockSize == 0)
+			return fail("wrong size");
+
+		file->layout = std::move(*layout);
+		file->dataSize = isDtm ? h.entries : (h.entries + 3) / 4;
+		if (h.blockCount != (file->dataSize + h.blockSize - 1) / h.blockSize)
+			return fail("wrong block count");
+
+		size_t tableEnd = sizeof(FileHeader) + (size_t(h.blockCount) + 1) * sizeof(uint64_t);
+		if (file->mapped.size() < tableEnd)
+			return fail("truncated");
+		file->offsets = file->mapped.data() + sizeof(FileHeader);
+		file->blocks  = file->mapped.data() + tableEnd;
+		if (readU64(file->offsets + size_t(h.blockCount) * sizeof(uint64_t)) > file->mapped.size() - tableEnd)
+			return fail("truncated");
+
+		file->id = uint32_t(files.size());
+		slot = std::move(file);
+		return slot.get();
+	}
+
+	Tablebase::Block Tablebase::block(const File& file, uint64_t n) const
+	{
+		uint64_t key = (uint64_t(file.id) << 32) | n;
+		{
+			std::lock_guard lock(cacheMutex);
+			auto it = cacheIndex.find(key);
+			if (it != cacheIndex.end())
+			{
+				++cacheHits;
+				cacheOrder.splice(cacheOrder.begin(), cacheOrder, it->second);
+				return it->second->second;
+			}
+		}
+		++cacheMisses;
+
+		//  -   :       
+		uint64_t begin = readU64(file.offsets + n * sizeof(uint64_t));
+		uint64_t end   = readU64(file.offsets + (n + 1) * sizeof(uint64_t));
+		uint64_t limit = file.mapped.size() - (file.blocks - file.mapped.data());
+		if (begin > end || end > limit)
+			return nullptr;
+
+		auto size = std::min<uint64_t>(file.header.blockSize, file.dataSize - n * file.header.blockSize);
+		auto data = std::make_shared<std::vector<uint8_t>>(size);
+		auto* compressed = reinterpret_cast<const uint8_t*>(file.blocks + begin);
+		if (!decompressBlock(compressed, size_t(end - begin), data->data(), data->size()))
+			return nullptr;
+
+		std::lock_guard lock(cacheMutex);
+		if (cacheIndex.find(key) == cacheIndex.end())
+		{
+			cacheOrder.emplace_front(key, data);
+			cacheIndex[key] = cacheOrder.begin();
+			if (cacheOrder.size() > cacheCapacity)
+			{
+				cacheIndex.erase(cacheOrder.back().first);
+				cacheOrder.pop_back();
+			}
+		}
+		return data;
+	}
+
+	std::optional<uint8_t> Tablebase::readByte(const File& file, uint64_t offset) const
+	{
+		if (offset >= file.dataSize)
+			return std::nullopt;
+		auto b = block(file, offset / file.header.blockSize);
+		if (!b)
+			return std::nullopt;
+		return (*b)[offset % file.header.blockSize];
+	}
+
+	std::optional<ProbeResult> Tablebase::probe(const Position& pos, bool withDtm) const
+	{
+		if (!canProbe(pos))
+			return std::nullopt;
+
+		//   -    
+		auto name = Layout::nameOf(pos);
+		if (name == "KvK")
+			return ProbeResult{ Wdl::Draw, -1 };
+
+		//       :      
+		bool flipped = false;
+		auto* wdl = open(name + ".ctbw");
+		if (wdl == nullptr)
+		{
+			flipped = true;
+			name = Layout::nameOf(pos, true);
+			wdl = open(name + ".ctbw");
+			if (wdl == nullptr)
+				return std::nullopt;
+		}
+
+		auto& pieces = wdl->layout.getPieces();
+		Square squares[MaxPieces];
+		uint64_t used = 0;
+		for (size_t i = 0; i < pieces.size(); ++i)
+		{
+			auto want = flipped ? makePiece(chess::getOtherSide(sideOf(pieces[i])), typeOf(pieces[i])) : pieces[i];
+			for (Square s = 0; s < 64; ++s)
+			{
+				if (pos.at(s) == want && !(used & (1ull << s)))
+				{
+					used |= 1ull << s;
+					squares[i] = flipped ? s ^ 56 : s;
+					break;
+				}
+			}
+		}
+
+		auto side = flipped ? chess::getOtherSide(pos.getSide()) : pos.getSide();
+		auto idx = wdl->layout.index(squares, side);
+		auto packed = readByte(*wdl, idx / 4);
+		if (!packed)
+			return std::nullopt;
+
+		auto code = (*packed >> (idx % 4 * 2)) & 3;
+		if (code == CodeInvalid)
+			return std::nullopt;
+
+		ProbeResult res{ Wdl(int(code) - 1), -1 };
+		if (withDtm && res.wdl != Wdl::Draw)
+		{
+			if (auto* dtm = open(name + ".ctbm"))
+			{
+				if (auto d = readByte(*dtm, idx))
+					res.dtm = *d;
+			}
+		}
+		return res;
+	}
+
+	std::optional<ProbeResult> Tablebase::probe(const chess::BoardState& state) const
+	{
+		return probe(Position::fromState(state), true);
+	}
+
+	Move Tablebase::bestMove(Position& pos) const
+	{
+		auto root = probe(pos, true);
+		if (!root)
+			return {};
+
+		MoveList list;
+		pos.generateLegalMoves(list);
+
+		Move best;
+		int bestScore = INT_MIN;
+		for (auto m : list)
+		{
+			Undo undo;
+			pos.makeMove(m, undo);
+			std::optional<ProbeResult> child;
+			MoveList replies;
+			pos.generateLegalMoves(replies);
+			if (replies.empty())
+				child = ProbeResult{ pos.inCheck() ? Wdl::Loss : Wdl::Draw, pos.inCheck() ? 0 : -1 };
+			else
+				child = probe(pos, true);
+			pos.unmakeMove(m, undo);
+
+			if (!child)
+				continue;
+			if (child->wdl != Wdl::Draw && child->dtm < 0)
+				return {}; //       
+
+			//    -    
+			int score = 0;
+			if (child->wdl == Wdl::Loss) score = 1000 - child->dtm;
+			if (child->wdl == Wdl::Win)  score = -1000 + child->dtm;
+			if (score > bestScore)
+			{
+				bestScore = score;
+				best = m;
+			}
+		}
+
+		//   ,   (        )
+		bool keeps = (root->wdl == Wdl::Win && bestScore > 0) || (root->wdl == Wdl::Draw && bestScore >= 0) ||
+			         (root->wdl == Wdl::Loss && bestScore != INT_MIN);
+		return keeps ? best : Move();
+	}
+}
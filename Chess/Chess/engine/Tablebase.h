@@ -0,0 +1,281 @@
+#pragma once
+
+#include "Position.h"
+#include "../core/MappedFile.h"
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::tb
+{
+	/// <summary>
+	///    (    )  
+	/// </summary>
+	constexpr int MaxPieces = 5;
+
+	/// <summary>
+	///     
+	/// </summary>
+	enum class Wdl : int8_t
+	{
+		Loss = -1, Draw = 0, Win = 1,
+	};
+
+	/// <summary>
+	///     ( 2    )
+	/// </summary>
+	enum WdlCode : uint8_t
+	{
+		CodeLoss = 0, CodeDraw = 1, CodeWin = 2,
+
+		/// <summary>
+		///   (    ,    ,    )
+		/// </summary>
+		CodeInvalid = 3,
+	};
+
+	/// <summary>
+	///   
+	/// </summary>
+	enum class FileKind
+	{
+		/// <summary>
+		///  : 2   , 4   
+		/// </summary>
+		Wdl,
+
+		/// <summary>
+		///      :    [ 0 - ,       ]
+		/// </summary>
+		Dtm,
+	};
+
+	/// <summary>
+	///    ( little-endian ).
+	///   -   ( uint64_t x ( blockCount + 1 )    )   
+	/// </summary>
+	struct FileHeader
+	{
+		char     magic[4];
+		uint32_t version;
+		char     material[16];
+		uint64_t entries;
+		uint32_t blockSize;
+		uint32_t blockCount;
+	};
+
+	constexpr char     WdlMagic[4]    = { 'C', 'T', 'B', 'W' };
+	constexpr char     DtmMagic[4]    = { 'C', 'T', 'B', 'M' };
+	constexpr uint32_t FormatVersion  = 1;
+	constexpr uint32_t DefaultBlockSize = 1 << 14;
+
+	/// <summary>
+	///    (  PackBits ) :   c &lt; 128 -  c + 1   ,
+	///     c - 125 
+	/// </summary>
+	/// <param name="data"></param>
+	/// <param name="size"> </param>
+	/// <returns> </returns>
+	std::vector<uint8_t> compressBlock(const uint8_t* data, size_t size);
+
+	/// <summary>
+	///  ,  compressBlock()
+	/// </summary>
+	/// <param name="data"> </param>
+	/// <param name="size">  </param>
+	/// <param name="out">   </param>
+	/// <param name="outSize">   </param>
+	/// <returns>false -   </returns>
+	bool decompressBlock(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+	/// <summary>
+	///       .
+	///      a1-d1-d4 (   )    a-d (   ),
+	///     64 .      .      ,  - 
+	/// </summary>
+	class Layout
+	{
+	public:
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="material">  "KQvKR" (  ,   )</param>
+		/// <returns> [ nullopt -    ]</returns>
+		static std::optional<Layout> fromName(std::string_view material);
+
+		/// <summary>
+		///    
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="flipped">true -   </param>
+		/// <returns>  "KQvKR"</returns>
+		static std::string nameOf(const Position& pos, bool flipped = false);
+
+		const std::string& name() const { return material; }
+
+		/// <summary>
+		///     :  ,  ,  ,  
+		/// </summary>
+		const std::vector<Piece>& getPieces() const { return pieces; }
+
+		constexpr bool hasPawns() const { return pawns; }
+
+		/// <summary>
+		///      
+		/// </summary>
+		constexpr uint64_t sideSize() const { return perSide; }
+
+		/// <summary>
+		///    
+		/// </summary>
+		constexpr uint64_t size() const { return perSide * 2; }
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="squares">    getPieces()</param>
+		/// <param name="side"> </param>
+		/// <returns>  </returns>
+		uint64_t index(const Square* squares, chess::Side side) const;
+
+		/// <summary>
+		///     .   ,   
+		///    index() (   ) -      
+		/// </summary>
+		/// <param name="idx">  </param>
+		/// <param name="squares">    getPieces()</param>
+		/// <returns> </returns>
+		chess::Side squares(uint64_t idx, Square* squares) const;
+
+	private:
+		std::string material;
+		std::vector<Piece> pieces;
+		bool pawns = false;
+		uint64_t perSide = 0;
+	};
+
+	/// <summary>
+	///    
+	/// </summary>
+	struct ProbeResult
+	{
+		Wdl wdl;
+
+		/// <summary>
+		///      [ -1 -        ]
+		/// </summary>
+		int dtm;
+	};
+
+	/// <summary>
+	///    .  ( "KQvK.ctbw" - , "KQvK.ctbm" -    )
+	///      ,    
+	///          .
+	///       
+	/// </summary>
+	class Tablebase
+	{
+	public:
+		/// <summary>
+		///     (       )
+		/// </summary>
+		/// <param name="directory"></param>
+		/// <param name="cacheBlocks">    </param>
+		explicit Tablebase(std::string directory, size_t cacheBlocks = 64);
+
+		Tablebase(const Tablebase&) = delete;
+		Tablebase& operator=(const Tablebase&) = delete;
+
+		/// <summary>
+		/// ,      :  ,       
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <returns>true -    </returns>
+		static bool canProbe(const Position& pos);
+
+		/// <summary>
+		///     
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <param name="withDtm">    </param>
+		/// <returns> [ nullopt -        ]</returns>
+		std::optional<ProbeResult> probe(const Position& pos, bool withDtm = false) const;
+
+		/// <summary>
+		///       
+		/// </summary>
+		/// <param name="state"> </param>
+		/// <returns> [ nullopt -        ]</returns>
+		std::optional<ProbeResult> probe(const chess::BoardState& state) const;
+
+		/// <summary>
+		///     :  -    ,  -  .
+		///     ,       
+		/// </summary>
+		/// <param name="pos"></param>
+		/// <returns> [   -     ]</returns>
+		Move bestMove(Position& pos) const;
+
+		size_t getCacheHits()   const { return cacheHits; }
+		size_t getCacheMisses() const { return cacheMisses; }
+
+	private:
+		/// <summary>
+		///   
+		/// </summary>
+		struct File
+		{
+			core::MappedFile mapped;
+			FileHeader header;
+			Layout layout;
+
+			/// <summary>
+			///      
+			/// </summary>
+			uint32_t id;
+
+			/// <summary>
+			///   
+			/// </summary>
+			uint64_t dataSize;
+
+			const std::byte* offsets;
+			const std::byte* blocks;
+		};
+
+		using Block = std::shared_ptr<const std::vector<uint8_t>>;
+
+		std::string directory;
+
+		/// <summary>
+		///    [ nullptr -  ,    ]
+		/// </summary>
+		mutable std::map<std::string, std::unique_ptr<File>> files;
+		mutable std::mutex filesMutex;
+
+		/// <summary>
+		///   :           
+		/// </summary>
+		size_t cacheCapacity;
+		mutable std::list<std::pair<uint64_t, Block>> cacheOrder;
+		mutable std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Block>>::iterator> cacheIndex;
+		mutable std::mutex cacheMutex;
+		mutable std::atomic<size_t> cacheHits   = 0;
+		mutable std::atomic<size_t> cacheMisses = 0;
+
+		const File* open(const std::string& name) const;
+		Block block(const File& file, uint64_t n) const;
+
+		/// <summary>
+		///    
+		/// </summary>
+		std::optional<uint8_t> readByte(const File& file, uint64_t offset) const;
+	};
+}
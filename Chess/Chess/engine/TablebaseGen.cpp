@@ -0,0 +1,512 @@
+#include "TablebaseGen.h"
+
+#include "../chess/BoardState.h"
+#include "../chess/Piece.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace engine::tb
+{
+	using chess::Side;
+
+	namespace
+	{
+		/// <summary>
+		///     :    ,    -  
+		/// </summary>
+		enum Result : uint16_t
+		{
+			Unknown = 0, Win = 1, Loss = 2, Draw = 3, Invalid = 4,
+		};
+
+		constexpr uint16_t makeCell(Result r, int dtm) { return uint16_t((r << 8) | dtm); }
+		constexpr Result   resultOf(uint16_t c)        { return Result(c >> 8); }
+		constexpr int      dtmOf(uint16_t c)           { return c & 0xFF; }
+
+		constexpr uint8_t NoPending = 0xFF;
+		constexpr int MaxDtm = 254;
+
+		constexpr int KnightDx[8] = { 1, 2,  1, -2, -1,  2, -1, -2 };
+		constexpr int KnightDy[8] = { 2, 1, -2,  1,  2, -1, -2, -1 };
+		constexpr int DirDx[8]    = { 0,  0, 1, -1, 1, -1,  1, -1 };
+		constexpr int DirDy[8]    = { 1, -1, 0,  0, 1,  1, -1, -1 };
+
+		constexpr std::string_view Letters = "QRBNP";
+
+		/// <summary>
+		///  f( , ,   )    [ 0, n )   
+		/// </summary>
+		void parallelFor(uint64_t n, int threads, const std::function<void(uint64_t, uint64_t, int)>& f)
+		{
+			constexpr uint64_t Chunk = 1 << 12;
+			std::atomic<uint64_t> next = 0;
+			std::vector<std::thread> pool;
+			for (int t = 0; t < threads; ++t)
+			{
+				pool.emplace_back([&, t]()
+				{
+					for (uint64_t begin; (begin = next.fetch_add(Chunk)) < n;)
+						f(begin, std::min(begin + Chunk, n), t);
+				});
+			}
+			for (auto& th : pool)
+				th.join();
+		}
+
+		/// <summary>
+		/// ,        s   (   )
+		/// </summary>
+		/// <param name="p"></param>
+		/// <param name="s">,    </param>
+		/// <param name="occupied"> </param>
+		/// <param name="out">-</param>
+		/// <returns> </returns>
+		int unmoves(Piece p, Square s, uint64_t occupied, Square* out)
+		{
+			int count = 0;
+			int x = fileOf(s), y = rankOf(s);
+			auto free = [&](int i, int j) { return i >= 0 && i < 8 && j >= 0 && j < 8 && !(occupied & (1ull << toSquare(i, j))); };
+
+			switch (typeOf(p))
+			{
+				case Pawn:
+				{
+					//     :    ,     -   
+					int back = sideOf(p) == Side::White ? -1 : 1;
+					int start = sideOf(p) == Side::White ? 1 : 6;
+					if (free(x, y + back) && y + back != 0 && y + back != 7)
+					{
+						out[count++] = toSquare(x, y + back);
+						if (y + 2 * back == start && free(x, y + 2 * back))
+							out[count++] = toSquare(x, y + 2 * back);
+					}
+					break;
+				}
+				case Knight:
+					for (int d = 0; d < 8; ++d)
+					{
+						if (free(x + KnightDx[d], y + KnightDy[d]))
+							out[count++] = toSquare(x + KnightDx[d], y + KnightDy[d]);
+					}
+					break;
+				case King:
+					for (int d = 0; d < 8; ++d)
+					{
+						if (free(x + DirDx[d], y + DirDy[d]))
+							out[count++] = toSquare(x + DirDx[d], y + DirDy[d]);
+					}
+					break;
+				default:
+				{
+					//    - ,   - 
+					int first = typeOf(p) == Bishop ? 4 : 0;
+					int last  = typeOf(p) == Rook ? 4 : 8;
+					for (int d = first; d < last; ++d)
+					{
+						for (int i = x + DirDx[d], j = y + DirDy[d]; free(i, j); i += DirDx[d], j += DirDy[d])
+							out[count++] = toSquare(i, j);
+					}
+					break;
+				}
+			}
+			return count;
+		}
+
+		/// <summary>
+		///         
+		/// </summary>
+		struct BoardPieces
+		{
+			chess::King   king[2]   = { chess::King(Side::White),   chess::King(Side::Black) };
+			chess::Queen  queen[2]  = { chess::Queen(Side::White),  chess::Queen(Side::Black) };
+			chess::Rook   rook[2]   = { chess::Rook(Side::White),   chess::Rook(Side::Black) };
+			chess::Bishop bishop[2] = { chess::Bishop(Side::White), chess::Bishop(Side::Black) };
+			chess::Knight knight[2] = { chess::Knight(Side::White), chess::Knight(Side::Black) };
+
+			/// <summary>
+			///  [  ][ 0 -   , 1 -   ]
+			/// </summary>
+			chess::Pawn pawn[2][2] = {
+				{ chess::Pawn(Side::White), chess::Pawn(Side::White) },
+				{ chess::Pawn(Side::Black), chess::Pawn(Side::Black) },
+			};
+
+			BoardPieces()
+			{
+				//     :      
+				for (int s = 0; s < 2; ++s)
+				{
+					king[s].onMoved();
+					rook[s].onMoved();
+					pawn[s][1].onMoved();
+				}
+			}
+
+			const chess::Piece* get(Piece p, Square s) const
+			{
+				int side = (int)sideOf(p);
+				switch (typeOf(p))
+				{
+					case King:   return &king[side];
+					case Queen:  return &queen[side];
+					case Rook:   return &rook[side];
+					case Bishop: return &bishop[side];
+					case Knight: return &knight[side];
+					default:
+						return &pawn[side][rankOf(s) != (sideOf(p) == Side::White ? 1 : 6)];
+				}
+			}
+		};
+
+		/// <summary>
+		///      ,    
+		/// </summary>
+		bool matchesBoardRules(const MoveList& legal, const Piece* pieces, const Square* squares, int count, Side side)
+		{
+			static const BoardPieces boardPieces;
+
+			chess::BoardState state;
+			state.reset();
+			for (int i = 0; i < count; ++i)
+				state.at(toPos(squares[i])) = boardPieces.get(pieces[i], squares[i]);
+			state.update();
+
+			std::set<std::pair<Square, Square>> engineMoves, boardMoves;
+			for (auto m : legal)
+				engineMoves.emplace(m.from(), m.to());
+
+			std::vector<chess::Move> valid;
+			for (int i = 0; i < count; ++i)
+			{
+				if (sideOf(pieces[i]) != side)
+					continue;
+				state.at(toPos(squares[i]))->getValidMoves(toPos(squares[i]), state, valid);
+				for (auto m : valid)
+					boardMoves.emplace(squares[i], toSquare(m.pos));
+			}
+			return engineMoves == boardMoves;
+		}
+	}
+
+	Generator::Generator(std::string directory, int threads)
+		: directory(std::move(directory)), threads(std::max(threads, 1))
+	{}
+
+	std::vector<std::string> Generator::allTables(int maxPieces)
+	{
+		//     :     
+		std::vector<std::vector<std::string>> sides(maxPieces - 1);
+		sides[0] = { "" };
+		for (int n = 1; n < maxPieces - 1; ++n)
+		{
+			for (auto& prev : sides[n - 1])
+			{
+				for (size_t i = prev.empty() ? 0 : Letters.find(prev.back()); i < Letters.size(); ++i)
+					sides[n].push_back(prev + Letters[i]);
+			}
+		}
+
+		auto strength = [](const std::string& s)
+		{
+			int res = 0;
+			for (auto c : s)
+				res += PieceValue[std::string_view(" PNBRQK").find(c)];
+			return res;
+		};
+
+		std::vector<std::string> res;
+		for (int total = 1; total <= maxPieces - 2; ++total)
+		{
+			for (int white = total; white * 2 >= total; --white)
+			{
+				for (auto& w : sides[white])
+				{
+					for (auto& b : sides[total - white])
+					{
+						//   - ,   -  
+						if (w.size() == b.size() && (strength(w) < strength(b) || (strength(w) == strength(b) && w > b)))
+							continue;
+						res.push_back("K" + w + "vK" + b);
+					}
+				}
+			}
+		}
+
+		auto pawns = [](const std::string& s) { return std::count(s.begin(), s.end(), 'P'); };
+		std::stable_sort(res.begin(), res.end(), [&](const std::string& a, const std::string& b)
+		{
+			if (a.size() != b.size())
+				return a.size() < b.size();
+			return pawns(a) < pawns(b);
+		});
+		return res;
+	}
+
+	void Generator::writeTable(const std::string& path, FileKind kind, const Layout& layout,
+		                       const std::vector<uint8_t>& data)
+	{
+		FileHeader header = {};
+		std::memcpy(header.magic, kind == FileKind::Wdl ? WdlMagic : DtmMagic, 4);
+		header.version = FormatVersion;
+		layout.name().copy(header.material, sizeof(header.material) - 1);
+		header.entries = layout.size();
+		header.blockSize = DefaultBlockSize;
+		header.blockCount = uint32_t((data.size() + DefaultBlockSize - 1) / DefaultBlockSize);
+
+		std::vector<uint64_t> offsets = { 0 };
+		std::vector<uint8_t> blocks;
+		for (uint32_t b = 0; b < header.blockCount; ++b)
+		{
+			size_t begin = size_t(b) * DefaultBlockSize;
+			auto compressed = compressBlock(data.data() + begin, std::min<size_t>(DefaultBlockSize, data.size() - begin));
+			blocks.insert(blocks.end(), compressed.begin(), compressed.end());
+			offsets.push_back(blocks.size());
+		}
+
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+		file.write(reinterpret_cast<const char*>(blocks.data()), blocks.size());
+		if (!file)
+			throw std::runtime_error("tablebase: cannot write " + path);
+	}
+
+	GenerateStats Generator::generate(const std::string& material, std::ostream& log)
+	{
+		auto start = std::chrono::steady_clock::now();
+		auto parsed = Layout::fromName(material);
+		if (!parsed)
+			throw std::invalid_argument("tablebase: invalid material " + material);
+		const auto& layout = *parsed;
+		const auto& pieces = layout.getPieces();
+		const int n = int(pieces.size());
+		const uint64_t size = layout.size();
+
+		std::vector<std::atomic<uint16_t>> cells(size);
+		std::vector<std::atomic<uint8_t>>  remaining(size);
+
+		//    :  ,   ,   
+		std::vector<uint8_t> pendingWin(size, NoPending);
+		std::vector<uint8_t> lossFloor(size, 0);
+		std::vector<uint8_t> drawExit(size, 0);
+
+		//      -    
+		Tablebase smaller(directory, 4096);
+		std::atomic<int> horizon = 0;
+		std::atomic<bool> missing = false;
+		std::atomic<uint64_t> checked = 0, mismatches = 0;
+		auto raiseHorizon = [&](int d)
+		{
+			for (int h = horizon; h < d && !horizon.compare_exchange_weak(h, d);) {}
+		};
+
+		std::vector<Position> positions(threads);
+		parallelFor(size, threads, [&](uint64_t begin, uint64_t end, int t)
+		{
+			auto& pos = positions[t];
+			Square squares[MaxPieces];
+			for (uint64_t i = begin; i < end; ++i)
+			{
+				auto side = layout.squares(i, squares);
+				cells[i] = makeCell(Invalid, 0);
+
+				//         
+				if (layout.index(squares, side) != i)
+					continue;
+				uint64_t occupied = 0;
+				bool valid = true;
+				for (int k = 0; k < n && valid; ++k)
+				{
+					valid = !(occupied & (1ull << squares[k])) &&
+						    (typeOf(pieces[k]) != Pawn || (rankOf(squares[k]) != 0 && rankOf(squares[k]) != 7));
+					occupied |= 1ull << squares[k];
+				}
+				if (!valid)
+					continue;
+
+				pos.setPieces(pieces.data(), squares, n, side);
+				if (pos.isAttacked(pos.getKingSquare(chess::getOtherSide(side)), side))
+					continue;
+
+				MoveList legal;
+				pos.generateLegalMoves(legal);
+
+				//      -   
+				if (i % 1024 == 0)
+				{
+					++checked;
+					if (!matchesBoardRules(legal, pieces.data(), squares, n, side))
+						++mismatches;
+				}
+
+				if (legal.empty())
+				{
+					cells[i] = pos.inCheck() ? makeCell(Loss, 0) : makeCell(Draw, 0);
+					continue;
+				}
+
+				uint64_t children[MaxMoves];
+				int childCount = 0;
+				int win = NoPending, floor = 0;
+				bool draw = false;
+				for (auto m : legal)
+				{
+					if (pos.at(m.to()) != NoPiece || m.isPromotion())
+					{
+						Undo undo;
+						pos.makeMove(m, undo);
+						auto child = smaller.probe(pos, true);
+						pos.unmakeMove(m, undo);
+						if (!child || (child->wdl != Wdl::Draw && child->dtm < 0))
+						{
+							missing = true;
+							continue;
+						}
+						if (child->wdl == Wdl::Loss) win   = std::min(win, child->dtm + 1);
+						if (child->wdl == Wdl::Win)  floor = std::max(floor, child->dtm + 1);
+						if (child->wdl == Wdl::Draw) draw  = true;
+						continue;
+					}
+
+					//      :  (  )    
+					Square moved[MaxPieces];
+					std::copy(squares, squares + n, moved);
+					*std::find(moved, moved + n, m.from()) = m.to();
+					auto child = layout.index(moved, chess::getOtherSide(side));
+					if (std::find(children, children + childCount, child) == children + childCount)
+						children[childCount++] = child;
+				}
+
+				pendingWin[i] = uint8_t(win);
+				lossFloor[i]  = uint8_t(floor);
+				drawExit[i]   = draw;
+				remaining[i]  = uint8_t(childCount);
+				cells[i] = makeCell(Unknown, 0);
+
+				if (childCount == 0)
+				{
+					//      -   
+					if (win != NoPending)  cells[i] = makeCell(Win, win);
+					else if (draw)         cells[i] = makeCell(Draw, 0);
+					else                   cells[i] = makeCell(Loss, floor);
+				}
+				if (win != NoPending)
+					raiseHorizon(win);
+				raiseHorizon(floor);
+			}
+		});
+
+		if (missing)
+			throw std::runtime_error("tablebase: " + material + " needs tables with fewer pieces");
+
+		//   :     p     
+		for (int p = 0; p <= horizon && p < MaxDtm; ++p)
+		{
+			parallelFor(size, threads, [&](uint64_t begin, uint64_t end, int)
+			{
+				Square squares[MaxPieces], from[64];
+				uint64_t parents[MaxMoves * 4];
+				for (uint64_t i = begin; i < end; ++i)
+				{
+					auto cell = cells[i].load(std::memory_order_relaxed);
+					if (resultOf(cell) == Unknown && pendingWin[i] == p)
+					{
+						auto expected = cell;
+						if (cells[i].compare_exchange_strong(expected, makeCell(Win, p)))
+							cell = makeCell(Win, p);
+					}
+					auto result = resultOf(cell);
+					if ((result != Win && result != Loss) || dtmOf(cell) != p)
+						continue;
+
+					//   ,    ;   -  
+					auto side = layout.squares(i, squares);
+					auto mover = chess::getOtherSide(side);
+					uint64_t occupied = 0;
+					for (int k = 0; k < n; ++k)
+						occupied |= 1ull << squares[k];
+
+					int parentCount = 0;
+					for (int k = 0; k < n; ++k)
+					{
+						if (sideOf(pieces[k]) != mover)
+							continue;
+						Square at = squares[k];
+						int count = unmoves(pieces[k], at, occupied, from);
+						for (int f = 0; f < count; ++f)
+						{
+							squares[k] = from[f];
+							auto parent = layout.index(squares, mover);
+							if (std::find(parents, parents + parentCount, parent) == parents + parentCount)
+								parents[parentCount++] = parent;
+						}
+						squares[k] = at;
+					}
+
+					for (int j = 0; j < parentCount; ++j)
+					{
+						auto parent = parents[j];
+						uint16_t unknown = makeCell(Unknown, 0);
+						if (result == Loss)
+						{
+							//       - 
+							if (cells[parent].compare_exchange_strong(unknown, makeCell(Win, p + 1)))
+								raiseHorizon(p + 1);
+						}
+						else if (--remaining[parent] == 0 && pendingWin[parent] == NoPending && !drawExit[parent])
+						{
+							//       - 
+							int d = std::max(p + 1, int(lossFloor[parent]));
+							if (cells[parent].compare_exchange_strong(unknown, makeCell(Loss, d)))
+								raiseHorizon(d);
+						}
+					}
+				}
+			});
+		}
+
+		GenerateStats stats;
+		std::vector<uint8_t> wdl((size + 3) / 4), dtm(size);
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			auto cell = cells[i].load();
+			uint8_t code = CodeInvalid;
+			switch (resultOf(cell))
+			{
+				case Win:     code = CodeWin;  ++stats.wins;   dtm[i] = uint8_t(dtmOf(cell)); break;
+				case Loss:    code = CodeLoss; ++stats.losses; dtm[i] = uint8_t(dtmOf(cell)); break;
+				case Unknown: //      
+				case Draw:    code = CodeDraw; ++stats.draws; break;
+				default: break;
+			}
+			if (code != CodeInvalid)
+			{
+				++stats.positions;
+				stats.longestMate = std::max(stats.longestMate, int(dtm[i]));
+			}
+			wdl[i / 4] |= uint8_t(code << (i % 4 * 2));
+		}
+
+		writeTable(directory + "/" + material + ".ctbw", FileKind::Wdl, layout, wdl);
+		writeTable(directory + "/" + material + ".ctbm", FileKind::Dtm, layout, dtm);
+
+		stats.checked = checked;
+		stats.mismatches = mismatches;
+		stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		log << material << ": " << stats.positions << " positions, +" << stats.wins << " =" << stats.draws
+			<< " -" << stats.losses << ", longest mate " << stats.longestMate << " plies, "
+			<< stats.seconds << " s\n";
+		if (stats.mismatches != 0)
+			log << material << ": " << stats.mismatches << " of " << stats.checked
+				<< " checked positions differ from board rules\n";
+		return stats;
+	}
+}
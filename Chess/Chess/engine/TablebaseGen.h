@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Tablebase.h"
+
+#include <ostream>
+
+namespace engine::tb
+{
+	/// <summary>
+	///    
+	/// </summary>
+	struct GenerateStats
+	{
+		uint64_t positions = 0;
+		uint64_t wins = 0, draws = 0, losses = 0;
+
+		/// <summary>
+		///     
+		/// </summary>
+		int longestMate = 0;
+
+		/// <summary>
+		///          
+		/// </summary>
+		uint64_t checked = 0, mismatches = 0;
+
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///     .
+	///        (    -     ),
+	///          
+	/// </summary>
+	class Generator
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="directory">   (         )</param>
+		/// <param name="threads"> </param>
+		Generator(std::string directory, int threads);
+
+		/// <summary>
+		///          
+		/// </summary>
+		/// <param name="material">   ( "KQvK" )</param>
+		/// <param name="log">     </param>
+		/// <returns> </returns>
+		GenerateStats generate(const std::string& material, std::ostream& log);
+
+		/// <summary>
+		///           :
+		///   - ,   ,   
+		/// </summary>
+		/// <param name="maxPieces">    </param>
+		/// <returns> </returns>
+		static std::vector<std::string> allTables(int maxPieces);
+
+		/// <summary>
+		///   ,    
+		/// </summary>
+		/// <param name="path">  </param>
+		/// <param name="kind"> </param>
+		/// <param name="layout"> </param>
+		/// <param name="data"> </param>
+		static void writeTable(const std::string& path, FileKind kind, const Layout& layout,
+			                   const std::vector<uint8_t>& data);
+
+	private:
+		std::string directory;
+		int threads;
+	};
+}
@@ -0,0 +1,110 @@
+#include "Transposition.h"
+
+#include <algorithm>
+
+namespace engine
+{
+	namespace
+	{
+		/// <summary>
+		///   :  ( 16  ) |  ( 16  ) |  ( 8  ) |   ( 2  ) |   ( 6  )
+		/// </summary>
+		constexpr uint64_t pack(const TTEntry& e, uint8_t generation)
+		{
+			return uint64_t(e.move.raw())
+				 | uint64_t(uint16_t(int16_t(e.score))) << 16
+				 | uint64_t(uint8_t(e.depth)) << 32
+				 | uint64_t(e.bound) << 40
+				 | uint64_t(generation) << 42;
+		}
+
+		constexpr uint8_t generationOf(uint64_t data)
+		{
+			return uint8_t(data >> 42) & 63;
+		}
+
+		constexpr TTEntry unpack(uint64_t data)
+		{
+			TTEntry e;
+			e.move  = Move::fromRaw(uint16_t(data));
+			e.score = int16_t(uint16_t(data >> 16));
+			e.depth = uint8_t(data >> 32);
+			e.bound = Bound(uint8_t(data >> 40) & 3);
+			return e;
+		}
+	}
+
+	TranspositionTable::TranspositionTable(size_t megabytes)
+	{
+		resize(megabytes);
+	}
+
+	void TranspositionTable::resize(size_t megabytes)
+	{
+		size_t wanted = std::max<size_t>(megabytes, 1) << 20;
+		size_t n = 1;
+		while (n * 2 * sizeof(Slot) <= wanted)
+			n *= 2;
+
+		slots.reset();
+		slots = std::make_unique<Slot[]>(n);
+		count = n;
+		mask = n - 1;
+		clear();
+	}
+
+	void TranspositionTable::clear()
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			slots[i].check.store(0, std::memory_order_relaxed);
+			slots[i].data.store(0, std::memory_order_relaxed);
+		}
+		generation = 0;
+	}
+
+	bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const
+	{
+		auto& slot = slots[key & mask];
+		uint64_t data = slot.data.load(std::memory_order_relaxed);
+		if (data == 0 || (slot.check.load(std::memory_order_relaxed) ^ data) != key)
+			return false;
+
+		entry = unpack(data);
+		return true;
+	}
+
+	void TranspositionTable::store(uint64_t key, const TTEntry& entry)
+	{
+		auto& slot = slots[key & mask];
+		auto e = entry;
+
+		uint64_t old = slot.data.load(std::memory_order_relaxed);
+		if (old != 0 && (slot.check.load(std::memory_order_relaxed) ^ old) == key)
+		{
+			auto prev = unpack(old);
+			if (e.depth < prev.depth && e.bound != Bound::Exact && generationOf(old) == generation)
+				return;
+
+			//      
+			if (e.move.isNone())
+				e.move = prev.move;
+		}
+
+		uint64_t data = pack(e, generation);
+		slot.check.store(key ^ data, std::memory_order_relaxed);
+		slot.data.store(data, std::memory_order_relaxed);
+	}
+
+	int TranspositionTable::hashfull() const
+	{
+		size_t n = std::min<size_t>(count, 1000);
+		int used = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			uint64_t data = slots[i].data.load(std::memory_order_relaxed);
+			used += data != 0 && generationOf(data) == generation;
+		}
+		return n == 0 ? 0 : int(used * 1000 / n);
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Types.h"
+
+#include <atomic>
+#include <memory>
+
+namespace engine
+{
+	/// <summary>
+	///     { , ,   (   beta ),   (      alpha ) }
+	/// </summary>
+	enum class Bound : uint8_t
+	{
+		None, Exact, Lower, Upper,
+	};
+
+	/// <summary>
+	///    
+	/// </summary>
+	struct TTEntry
+	{
+		Move move;
+		int score = 0;
+		int depth = 0;
+		Bound bound = Bound::None;
+	};
+
+	/// <summary>
+	///      -  :       .
+	///  -  64-  (  ^ ,  )   :
+	/// ,    ,       
+	/// </summary>
+	class TranspositionTable
+	{
+	public:
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="megabytes">  </param>
+		explicit TranspositionTable(size_t megabytes = 16);
+
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+		/// <summary>
+		///    (   ).     
+		/// </summary>
+		/// <param name="megabytes">   [       ]</param>
+		void resize(size_t megabytes);
+
+		/// <summary>
+		///    .     
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		///     :      ,
+		///       
+		/// </summary>
+		void newSearch() { generation = uint8_t((generation + 1) & GenerationMask); }
+
+		/// <summary>
+		///  
+		/// </summary>
+		/// <param name="key">  </param>
+		/// <param name="entry"> </param>
+		/// <returns>true -     </returns>
+		bool probe(uint64_t key, TTEntry& entry) const;
+
+		/// <summary>
+		///    .     ,
+		///     -    ,       
+		/// </summary>
+		/// <param name="key">  </param>
+		/// <param name="entry"></param>
+		void store(uint64_t key, const TTEntry& entry);
+
+		/// <summary>
+		///       (     )
+		/// </summary>
+		/// <returns>    </returns>
+		int hashfull() const;
+
+		size_t getSizeMb() const { return (count * sizeof(Slot)) >> 20; }
+
+		/// <summary>
+		///     "  n   "  "  "  
+		/// </summary>
+		/// <param name="score"></param>
+		/// <param name="ply">  </param>
+		/// <returns>  </returns>
+		static constexpr int scoreToTable(int score, int ply)
+		{
+			return score >= MateBound ? score + ply : score <= -MateBound ? score - ply : score;
+		}
+
+		/// <summary>
+		///  scoreToTable()    
+		/// </summary>
+		/// <param name="score">  </param>
+		/// <param name="ply">  </param>
+		/// <returns>  </returns>
+		static constexpr int scoreFromTable(int score, int ply)
+		{
+			return score >= MateBound ? score - ply : score <= -MateBound ? score + ply : score;
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> check;
+			std::atomic<uint64_t> data;
+		};
+
+		static constexpr uint8_t GenerationMask = 63;
+
+		std::unique_ptr<Slot[]> slots;
+		size_t count = 0;
+		uint64_t mask = 0;
+
+		/// <summary>
+		///  ,     [  , 6  ]
+		/// </summary>
+		uint8_t generation = 0;
+	};
+}
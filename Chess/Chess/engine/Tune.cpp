@@ -0,0 +1,479 @@
+#include "Tune.h"
+
+#include "Datagen.h"
+#include "Evaluate.h"
+#include "Psqt.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+namespace engine::tune
+{
+	namespace
+	{
+		/// <summary>
+		///   :  [  ],  [  ][   ],  [  ].
+		///      -    
+		/// </summary>
+		constexpr int ValueIndex    = 0;
+		constexpr int TableIndex    = ValueIndex + 7;
+		constexpr int MobilityIndex = TableIndex + 7 * 64;
+		constexpr int WeightCount   = MobilityIndex + 7;
+
+		/// <summary>
+		///       :      
+		/// </summary>
+		constexpr int MaxScore = 2000;
+
+		constexpr double Ln10 = 2.302585092994046;
+
+		/// <summary>
+		///       
+		/// </summary>
+		double sigmoid(double k, double eval)
+		{
+			return 1.0 / (1.0 + std::exp(-k * Ln10 / 400.0 * eval));
+		}
+
+		/// <summary>
+		///      
+		/// </summary>
+		struct Params
+		{
+			std::vector<double> mg = std::vector<double>(WeightCount, 0.0);
+			std::vector<double> eg = std::vector<double>(WeightCount, 0.0);
+
+			static Params from(const Weights& w)
+			{
+				Params p;
+				for (int t = 0; t < 7; ++t)
+				{
+					p.mg[ValueIndex + t] = w.mgValue[t];
+					p.eg[ValueIndex + t] = w.egValue[t];
+					p.mg[MobilityIndex + t] = w.mobilityMg[t];
+					p.eg[MobilityIndex + t] = w.mobilityEg[t];
+					for (int s = 0; s < 64; ++s)
+					{
+						p.mg[TableIndex + t * 64 + s] = w.mgTable[t][s];
+						p.eg[TableIndex + t * 64 + s] = w.egTable[t][s];
+					}
+				}
+				return p;
+			}
+
+			Weights round() const
+			{
+				Weights w;
+				auto r = [](double v) { return int(std::lround(v)); };
+				for (int t = 0; t < 7; ++t)
+				{
+					w.mgValue[t] = r(mg[ValueIndex + t]);
+					w.egValue[t] = r(eg[ValueIndex + t]);
+					w.mobilityMg[t] = r(mg[MobilityIndex + t]);
+					w.mobilityEg[t] = r(eg[MobilityIndex + t]);
+					for (int s = 0; s < 64; ++s)
+					{
+						w.mgTable[t][s] = r(mg[TableIndex + t * 64 + s]);
+						w.egTable[t][s] = r(eg[TableIndex + t * 64 + s]);
+					}
+				}
+				return w;
+			}
+		};
+
+		void writeArray(std::ostream& out, const char* name, const std::array<int, 7>& values)
+		{
+			out << "\tconstexpr std::array<int, 7> " << name << " = { ";
+			for (int t = 0; t < 7; ++t)
+				out << (t ? ", " : "") << values[t];
+			out << " };\n";
+		}
+
+		void writeTable(std::ostream& out, const char* name, const std::array<std::array<int, 64>, 7>& table)
+		{
+			constexpr const char* Names[] = { "", "", "", "", "", "", "" };
+			out << "\tconstexpr int " << name << "[7][64] = {\n\t\t{},\n";
+			for (int t = Pawn; t <= King; ++t)
+			{
+				out << "\t\t{ // " << Names[t] << "\n";
+				for (int row = 0; row < 8; ++row)
+				{
+					out << "\t\t\t";
+					for (int col = 0; col < 8; ++col)
+						out << (col ? "," : "") << std::setw(4) << table[t][row * 8 + col];
+					out << ",\n";
+				}
+				out << "\t\t},\n";
+			}
+			out << "\t};\n";
+		}
+	}
+
+	/// <summary>
+	///    :  ,    ,  
+	/// </summary>
+	struct Trainer
+	{
+		const Dataset& data;
+		int threads;
+		double k = 1;
+		double resultWeight = 1;
+		Params params;
+
+		/// <summary>
+		///      :    
+		/// </summary>
+		std::vector<float> evals;
+		std::vector<float> errors;
+		std::vector<std::vector<double>> gradMg;
+		std::vector<std::vector<double>> gradEg;
+
+		Trainer(const Dataset& data, int threads) : data(data), threads(std::max(threads, 1)),
+			evals(data.size()), errors(data.size()),
+			gradMg(size_t(this->threads), std::vector<double>(WeightCount)),
+			gradEg(size_t(this->threads), std::vector<double>(WeightCount))
+		{}
+
+		float target(const Dataset::Sample& s) const
+		{
+			return float(resultWeight * s.result + (1 - resultWeight) * sigmoid(k, s.score));
+		}
+
+		/// <summary>
+		///      
+		/// </summary>
+		float evaluate(const Dataset::Sample& s) const
+		{
+			double mg = 0, eg = 0;
+			auto* f = data.features.data() + s.begin;
+			for (int i = 0; i < s.count; ++i)
+			{
+				mg += params.mg[f[i].index] * f[i].coef;
+				eg += params.eg[f[i].index] * f[i].coef;
+			}
+			return float(s.fixed + (mg * s.phase + eg * (MaxPhase - s.phase)) / MaxPhase);
+		}
+
+		/// <summary>
+		///   ,       
+		/// </summary>
+		/// <returns>  </returns>
+		double computeErrors(size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				evals[i] = evaluate(data.samples[i]);
+
+			//     :  ,    
+			double loss = 0;
+			float scale = float(k * Ln10 / 400.0);
+			for (size_t i = begin; i < end; ++i)
+			{
+				float p = 1.0f / (1.0f + std::exp(-scale * evals[i]));
+				float diff = p - target(data.samples[i]);
+				loss += double(diff) * diff;
+				errors[i] = diff * p * (1.0f - p) * scale;
+			}
+			return loss;
+		}
+
+		/// <summary>
+		///    
+		/// </summary>
+		double loss()
+		{
+			std::vector<double> sums(size_t(threads), 0.0);
+			size_t n = data.size();
+			core::parallelFor(size_t(threads), threads, [&](size_t part, int t)
+			{
+				sums[t] += computeErrors(n * part / threads, n * (part + 1) / threads);
+			});
+			double total = 0;
+			for (auto s : sums)
+				total += s;
+			return n ? total / double(n) : 0;
+		}
+
+		/// <summary>
+		///   k    :   k ,   
+		/// </summary>
+		void fitK()
+		{
+			double lo = 0.1, hi = 4.0;
+			constexpr double Ratio = 0.6180339887498949;
+			for (int i = 0; i < 30; ++i)
+			{
+				double a = hi - (hi - lo) * Ratio, b = lo + (hi - lo) * Ratio;
+				k = a;
+				double la = loss();
+				k = b;
+				double lb = loss();
+				if (la < lb)
+					hi = b;
+				else
+					lo = a;
+			}
+			k = (lo + hi) / 2;
+		}
+
+		/// <summary>
+		///   :     ,   
+		/// </summary>
+		void gradient(size_t begin, size_t end, std::vector<double>& mg, std::vector<double>& eg)
+		{
+			for (int t = 0; t < threads; ++t)
+			{
+				std::fill(gradMg[t].begin(), gradMg[t].end(), 0.0);
+				std::fill(gradEg[t].begin(), gradEg[t].end(), 0.0);
+			}
+			size_t n = end - begin;
+			core::parallelFor(size_t(threads), threads, [&](size_t part, int t)
+			{
+				size_t b = begin + n * part / threads, e = begin + n * (part + 1) / threads;
+				computeErrors(b, e);
+				auto& gm = gradMg[t];
+				auto& ge = gradEg[t];
+				for (size_t i = b; i < e; ++i)
+				{
+					auto& s = data.samples[i];
+					double g = errors[i];
+					double gmg = g * s.phase / MaxPhase, geg = g * (MaxPhase - s.phase) / MaxPhase;
+					auto* f = data.features.data() + s.begin;
+					for (int j = 0; j < s.count; ++j)
+					{
+						gm[f[j].index] += gmg * f[j].coef;
+						ge[f[j].index] += geg * f[j].coef;
+					}
+				}
+			});
+			std::fill(mg.begin(), mg.end(), 0.0);
+			std::fill(eg.begin(), eg.end(), 0.0);
+			for (int t = 0; t < threads; ++t)
+			{
+				for (int i = 0; i < WeightCount; ++i)
+				{
+					mg[i] += gradMg[t][i] / double(n);
+					eg[i] += gradEg[t][i] / double(n);
+				}
+			}
+		}
+	};
+
+	Weights Weights::current()
+	{
+		Weights w;
+		for (int t = 0; t < 7; ++t)
+		{
+			w.mgValue[t] = MgValue[t];
+			w.egValue[t] = EgValue[t];
+			w.mobilityMg[t] = MobilityMg[t];
+			w.mobilityEg[t] = MobilityEg[t];
+			for (int s = 0; s < 64; ++s)
+			{
+				w.mgTable[t][s] = MgTable[t][s];
+				w.egTable[t][s] = EgTable[t][s];
+			}
+		}
+		return w;
+	}
+
+	double Dataset::bytesPerPosition() const
+	{
+		return samples.empty() ? 0.0 : double(samples.size() * sizeof(Sample) + features.size() * sizeof(Feature)) / samples.size();
+	}
+
+	Dataset Dataset::load(const std::string& path, int threads, uint64_t maxPositions)
+	{
+		threads = std::max(threads, 1);
+		datagen::Reader reader(path);
+		auto current = Params::from(Weights::current());
+
+		//    :     ,   
+		struct Part
+		{
+			std::vector<Sample> samples;
+			std::vector<Feature> features;
+			uint64_t skipped = 0;
+		};
+		std::vector<Part> parts(static_cast<size_t>(threads));
+		std::atomic<uint64_t> taken = 0;
+
+		reader.forEach(threads, [&](const datagen::Record& r, int t)
+		{
+			auto& part = parts[t];
+			const auto& pos = r.pos;
+			bool noisy = pos.at(r.played.to()) != NoPiece || r.played.isPromotion() || r.played.flag() == MoveFlag::Passing;
+			if (noisy || std::abs(r.score) >= MaxScore || pos.inCheck() ||
+				(maxPositions && taken.fetch_add(1, std::memory_order_relaxed) >= maxPositions))
+			{
+				++part.skipped;
+				return;
+			}
+
+			//      :    ,    
+			Feature local[64 + 14];
+			int count = 0;
+			auto add = [&](int index, int coef)
+			{
+				for (int i = 0; i < count; ++i)
+				{
+					if (local[i].index == index)
+					{
+						local[i].coef = int16_t(local[i].coef + coef);
+						return;
+					}
+				}
+				local[count++] = { uint16_t(index), int16_t(coef) };
+			};
+			for (Square s = 0; s < 64; ++s)
+			{
+				auto p = pos.at(s);
+				if (p == NoPiece)
+					continue;
+				bool white = sideOf(p) == chess::Side::White;
+				add(ValueIndex + typeOf(p), white ? 1 : -1);
+				add(TableIndex + typeOf(p) * 64 + (white ? s ^ 56 : s), white ? 1 : -1);
+			}
+			auto mob = mobility(pos);
+			for (int type = Knight; type <= Queen; ++type)
+			{
+				if (mob[type])
+					add(MobilityIndex + type, mob[type]);
+			}
+
+			Sample sample{};
+			sample.begin = uint32_t(part.features.size());
+			sample.phase = uint8_t(pos.getPhase());
+			sample.result = r.result == archive::Result::WhiteWins ? 1.0f : r.result == archive::Result::BlackWins ? 0.0f : 0.5f;
+			sample.score = float(r.score);
+
+			//   - ,    (  ,    )
+			double mg = 0, eg = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if (local[i].coef == 0)
+					continue;
+				mg += current.mg[local[i].index] * local[i].coef;
+				eg += current.eg[local[i].index] * local[i].coef;
+				part.features.push_back(local[i]);
+			}
+			sample.count = uint16_t(part.features.size() - sample.begin);
+			int white = pos.getSide() == chess::Side::White ? evaluate(pos) : -evaluate(pos);
+			sample.fixed = float(white - (mg * sample.phase + eg * (MaxPhase - sample.phase)) / MaxPhase);
+			part.samples.push_back(sample);
+		});
+
+		//  :         
+		std::vector<std::pair<int, uint32_t>> order;
+		Dataset data;
+		for (int t = 0; t < threads; ++t)
+		{
+			data.skippedCount += parts[t].skipped;
+			for (uint32_t i = 0; i < parts[t].samples.size(); ++i)
+				order.push_back({ t, i });
+		}
+		std::shuffle(order.begin(), order.end(), std::mt19937_64(1));
+
+		size_t featureCount = 0;
+		for (auto& part : parts)
+			featureCount += part.features.size();
+		if (featureCount > UINT32_MAX)
+			throw std::runtime_error("tune: too many positions");
+		data.samples.reserve(order.size());
+		data.features.reserve(featureCount);
+		for (auto [t, i] : order)
+		{
+			auto s = parts[t].samples[i];
+			auto* f = parts[t].features.data() + s.begin;
+			s.begin = uint32_t(data.features.size());
+			data.features.insert(data.features.end(), f, f + s.count);
+			data.samples.push_back(s);
+		}
+		return data;
+	}
+
+	Report run(const Dataset& data, const Options& options, Weights& weights, std::ostream& log)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		Report report;
+		Trainer trainer(data, options.threads);
+		trainer.params = Params::from(weights);
+		trainer.resultWeight = options.resultWeight;
+		if (options.k > 0)
+			trainer.k = options.k;
+		else
+			trainer.fitK();
+		report.k = trainer.k;
+		report.lossBefore = trainer.loss();
+		log << std::fixed << std::setprecision(4) << "k " << trainer.k << ", loss " << std::setprecision(6)
+			<< report.lossBefore << std::endl;
+
+		// Adam :           
+		constexpr double Beta1 = 0.9, Beta2 = 0.999, Epsilon = 1e-8;
+		std::vector<double> gm(WeightCount), ge(WeightCount);
+		std::vector<double> m1(2 * WeightCount), m2(2 * WeightCount);
+		size_t batch = std::max<size_t>(options.batchSize, 1);
+		long long step = 0;
+		for (int epoch = 1; epoch <= options.epochs; ++epoch)
+		{
+			for (size_t begin = 0; begin < data.size(); begin += batch)
+			{
+				trainer.gradient(begin, std::min(begin + batch, data.size()), gm, ge);
+				++step;
+				double c1 = 1 - std::pow(Beta1, double(step)), c2 = 1 - std::pow(Beta2, double(step));
+				for (int i = 0; i < 2 * WeightCount; ++i)
+				{
+					double g = i < WeightCount ? gm[i] : ge[i - WeightCount];
+					m1[i] = Beta1 * m1[i] + (1 - Beta1) * g;
+					m2[i] = Beta2 * m2[i] + (1 - Beta2) * g * g;
+					double delta = options.learningRate * (m1[i] / c1) / (std::sqrt(m2[i] / c2) + Epsilon);
+					auto& w = i < WeightCount ? trainer.params.mg[i] : trainer.params.eg[i - WeightCount];
+					w -= delta;
+				}
+			}
+			double loss = trainer.loss();
+			log << "epoch " << std::setw(4) << epoch << ", loss " << std::setprecision(6) << loss << std::endl;
+			report.lossAfter = loss;
+		}
+		if (options.epochs <= 0)
+			report.lossAfter = report.lossBefore;
+
+		weights = trainer.params.round();
+		report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return report;
+	}
+
+	void writeHeader(std::ostream& out, const Weights& weights)
+	{
+		out << "#pragma once\n\n"
+			   "//    ( \"Tune.exe\" ) :    \n\n"
+			   "#include <array>\n\n"
+			   "namespace engine\n{\n"
+			   "\t/// <summary>\n"
+			   "\t///     \n"
+			   "\t/// </summary>\n";
+		writeArray(out, "MgValue", weights.mgValue);
+		writeArray(out, "EgValue", weights.egValue);
+		out << "\n"
+			   "\t/// <summary>\n"
+			   "\t///      [   ][  ].\n"
+			   "\t///     :   - 8- \n"
+			   "\t/// </summary>\n";
+		writeTable(out, "MgTable", weights.mgTable);
+		out << "\n";
+		writeTable(out, "EgTable", weights.egTable);
+		out << "\n"
+			   "\t/// <summary>\n"
+			   "\t///  :          ( MobilityCenter ) [   ]\n"
+			   "\t/// </summary>\n";
+		writeArray(out, "MobilityMg", weights.mobilityMg);
+		writeArray(out, "MobilityEg", weights.mobilityEg);
+		out << "}\n";
+	}
+}
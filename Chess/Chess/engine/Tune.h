@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace engine::tune
+{
+	/// <summary>
+	///    :  ,    
+	/// (   EvalWeights.h : [   ],    8-  )
+	/// </summary>
+	struct Weights
+	{
+		std::array<int, 7> mgValue = {};
+		std::array<int, 7> egValue = {};
+		std::array<std::array<int, 64>, 7> mgTable = {};
+		std::array<std::array<int, 64>, 7> egTable = {};
+		std::array<int, 7> mobilityMg = {};
+		std::array<int, 7> mobilityEg = {};
+
+		/// <summary>
+		/// ,    
+		/// </summary>
+		static Weights current();
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Options
+	{
+		/// <summary>
+		///        
+		/// </summary>
+		int threads = 1;
+
+		/// <summary>
+		///    
+		/// </summary>
+		int epochs = 50;
+
+		/// <summary>
+		///    
+		/// </summary>
+		size_t batchSize = 16384;
+
+		/// <summary>
+		///   ( Adam ),   
+		/// </summary>
+		double learningRate = 1.0;
+
+		/// <summary>
+		///   :   ,  -     [ 1 -   ]
+		/// </summary>
+		double resultWeight = 1.0;
+
+		/// <summary>
+		///       [ 0 -     ]
+		/// </summary>
+		double k = 0;
+	};
+
+	/// <summary>
+	///     :     ,      -
+	///  (  ,  ),        (   ).
+	///         :     
+	/// </summary>
+	class Dataset
+	{
+	public:
+		/// <summary>
+		///     ( engine::datagen ),     :
+		///  ,   -     ,  -  
+		/// </summary>
+		/// <param name="path">  </param>
+		/// <param name="threads">  </param>
+		/// <param name="maxPositions">   [ 0 -  ]</param>
+		/// <returns></returns>
+		static Dataset load(const std::string& path, int threads, uint64_t maxPositions = 0);
+
+		size_t   size()    const { return samples.size(); }
+		uint64_t skipped() const { return skippedCount; }
+
+		/// <summary>
+		///    
+		/// </summary>
+		double bytesPerPosition() const;
+
+	private:
+		/// <summary>
+		///     :   index    coef
+		/// </summary>
+		struct Feature
+		{
+			uint16_t index;
+			int16_t  coef;
+		};
+
+		struct Sample
+		{
+			uint32_t begin;
+			uint16_t count;
+			uint8_t  phase;
+			uint8_t  reserved;
+
+			/// <summary>
+			///       [ 1, 0.5, 0 ]
+			/// </summary>
+			float result;
+
+			/// <summary>
+			///        (   -    )
+			/// </summary>
+			float score;
+
+			/// <summary>
+			///        
+			/// </summary>
+			float fixed;
+		};
+
+		std::vector<Sample> samples;
+		std::vector<Feature> features;
+		uint64_t skippedCount = 0;
+
+		friend struct Trainer;
+	};
+
+	/// <summary>
+	///  
+	/// </summary>
+	struct Report
+	{
+		double k = 0;
+		double lossBefore = 0;
+		double lossAfter = 0;
+		double seconds = 0;
+	};
+
+	/// <summary>
+	///     (  Texel ) :   1 / ( 1 + 10^( -k *  / 400 ) )
+	///    -  .    ,
+	///      
+	/// </summary>
+	/// <param name="data"></param>
+	/// <param name="options"></param>
+	/// <param name="weights"> ,  </param>
+	/// <param name="log">      </param>
+	/// <returns> </returns>
+	Report run(const Dataset& data, const Options& options, Weights& weights, std::ostream& log);
+
+	/// <summary>
+	///      EvalWeights.h
+	/// </summary>
+	/// <param name="out"> </param>
+	/// <param name="weights"></param>
+	void writeHeader(std::ostream& out, const Weights& weights);
+}
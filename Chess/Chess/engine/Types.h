@@ -0,0 +1,178 @@
+#pragma once
+
+#include "../chess/Common.h"
+
+#include <array>
+#include <cstdint>
+
+namespace engine
+{
+	/// <summary>
+	///   { , , , , , ,  }
+	/// </summary>
+	enum PieceType : uint8_t
+	{
+		NoType = 0,
+		Pawn, Knight, Bishop, Rook, Queen, King,
+	};
+
+	/// <summary>
+	///     :  | (  << 3 ) ; 0 -  
+	/// </summary>
+	using Piece = uint8_t;
+
+	constexpr Piece NoPiece = 0;
+
+	/// <summary>
+	///    ( y * 8 + x ),   BoardState
+	/// </summary>
+	using Square = int;
+
+	constexpr Square NoSquare = -1;
+
+	constexpr int MaxPly   = 128;
+	constexpr int MaxMoves = 256;
+
+	constexpr Piece makePiece(chess::Side side, PieceType type)
+	{
+		return Piece(type | ((int)side << 3));
+	}
+	constexpr PieceType  typeOf(Piece p) { return PieceType(p & 7); }
+	constexpr chess::Side sideOf(Piece p) { return chess::Side(p >> 3); }
+
+	constexpr Square toSquare(chess::Pos p) { return p.y() * 8 + p.x(); }
+	constexpr Square toSquare(int x, int y) { return y * 8 + x; }
+	constexpr int fileOf(Square s) { return s & 7; }
+	constexpr int rankOf(Square s) { return s >> 3; }
+
+	inline chess::Pos toPos(Square s)
+	{
+		if (s == NoSquare) return chess::Pos::Invalid;
+		return { fileOf(s), rankOf(s) };
+	}
+
+	/// <summary>
+	///   (  chess::Move::Type,     )
+	/// </summary>
+	enum class MoveFlag : uint8_t
+	{
+		Normal,
+		DoubleAdvance,
+		Passing,
+		Castling,
+		QueensideCastling,
+		PromoKnight,
+		PromoBishop,
+		PromoRook,
+		PromoQueen,
+	};
+
+	/// <summary>
+	///    ( 16  :  |  |   )
+	/// </summary>
+	class Move
+	{
+		uint16_t val = 0;
+
+	public:
+		constexpr Move() = default;
+		constexpr Move(Square from, Square to, MoveFlag flag = MoveFlag::Normal)
+			: val(uint16_t(from | (to << 6) | ((int)flag << 12)))
+		{}
+
+		constexpr Square   from() const { return val & 63; }
+		constexpr Square   to()   const { return (val >> 6) & 63; }
+		constexpr MoveFlag flag() const { return MoveFlag(val >> 12); }
+		constexpr uint16_t raw()  const { return val; }
+
+		constexpr bool isNone()      const { return val == 0; }
+		constexpr bool isPromotion() const { return flag() >= MoveFlag::PromoKnight; }
+
+		/// <summary>
+		/// ,    
+		/// </summary>
+		/// <returns>  [ NoType -     ]</returns>
+		constexpr PieceType promotionType() const
+		{
+			return isPromotion() ? PieceType((int)flag() - (int)MoveFlag::PromoKnight + Knight) : NoType;
+		}
+
+		static constexpr Move fromRaw(uint16_t raw)
+		{
+			Move m;
+			m.val = raw;
+			return m;
+		}
+
+		/// <summary>
+		///       
+		/// </summary>
+		/// <returns>  </returns>
+		chess::FullMove toFullMove() const
+		{
+			constexpr chess::PromotionResult promotions[] = {
+				chess::PromotionResult::Knight, chess::PromotionResult::Bishop,
+				chess::PromotionResult::Rook,   chess::PromotionResult::Queen,
+			};
+			auto promotion = isPromotion() ? promotions[promotionType() - Knight] : chess::PromotionResult::None;
+			return { toPos(from()), toPos(to()), promotion };
+		}
+
+		friend constexpr bool operator ==(Move a, Move b) { return a.val == b.val; }
+		friend constexpr bool operator !=(Move a, Move b) { return a.val != b.val; }
+
+		friend std::ostream& operator<<(std::ostream& s, Move m)
+		{
+			if (m.isNone()) return s << "0000";
+			return s << m.toFullMove();
+		}
+	};
+
+	/// <summary>
+	///     (    )    
+	/// </summary>
+	struct MoveList
+	{
+		std::array<Move, MaxMoves> moves;
+		std::array<int,  MaxMoves> scores;
+		int count = 0;
+
+		void add(Move m) { moves[count++] = m; }
+
+		constexpr int  size()  const { return count; }
+		constexpr bool empty() const { return count == 0; }
+
+		Move  operator[](int i) const { return moves[i]; }
+		Move* begin() { return moves.data(); }
+		Move* end()   { return moves.data() + count; }
+		const Move* begin() const { return moves.data(); }
+		const Move* end()   const { return moves.data() + count; }
+
+		/// <summary>
+		///             i
+		/// </summary>
+		/// <param name="i">  </param>
+		/// <returns>   </returns>
+		Move pickNext(int i)
+		{
+			int best = i;
+			for (int j = i + 1; j < count; ++j)
+			{
+				if (scores[j] > scores[best])
+					best = j;
+			}
+			std::swap(moves[i], moves[best]);
+			std::swap(scores[i], scores[best]);
+			return moves[i];
+		}
+	};
+
+	/// <summary>
+	///   (    )
+	/// </summary>
+	constexpr int Infinity  = 32001;
+	constexpr int MateScore = 32000;
+	constexpr int MateBound = MateScore - MaxPly;
+
+	constexpr std::array<int, 7> PieceValue = { 0, 100, 320, 330, 500, 900, 0 };
+}
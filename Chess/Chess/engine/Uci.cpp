@@ -0,0 +1,450 @@
+#include "Uci.h"
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+namespace engine
+{
+	namespace
+	{
+		constexpr const char* StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+		constexpr int DefaultHashMb = 16;
+		constexpr int MaxHashMb     = 1 << 16;
+		constexpr int MaxThreads    = 256;
+
+		/// <summary>
+		///         (   )
+		/// </summary>
+		constexpr int64_t MoveOverhead = 30;
+
+		using Clock = std::chrono::steady_clock;
+
+		int64_t millisecondsSince(Clock::time_point start)
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+		}
+
+		std::string toLower(std::string s)
+		{
+			std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+			return s;
+		}
+
+		/// <summary>
+		///    UCI : "cp 35"  "mate -3" (  ,    )
+		/// </summary>
+		std::string formatScore(int score)
+		{
+			if (std::abs(score) < MateBound)
+				return core::concat("cp ", score);
+
+			int plies = MateScore - std::abs(score);
+			int moves = (plies + 1) / 2;
+			return core::concat("mate ", score > 0 ? moves : -moves);
+		}
+	}
+
+	UciEngine::UciEngine()
+		: position(Position::startPosition()),
+		  table(std::make_shared<TranspositionTable>(DefaultHashMb))
+	{
+		setThreads(1);
+	}
+
+	UciEngine::~UciEngine()
+	{
+		stop();
+		if (searchThread.joinable())
+			searchThread.join();
+	}
+
+	int UciEngine::run(std::istream& in, std::ostream& output)
+	{
+		out = &output;
+
+		// getline     :     
+		//   ,     stop
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (!execute(line))
+				return 0;
+		}
+		execute("quit");
+		return 0;
+	}
+
+	bool UciEngine::execute(const std::string& line)
+	{
+		std::istringstream args(line);
+		std::string command;
+		if (!(args >> command))
+			return true;
+
+		if (command == "uci")
+		{
+			uci();
+		}
+		else if (command == "isready")
+		{
+			send("readyok");
+		}
+		else if (command == "setoption")
+		{
+			waitSearch();
+			setOption(args);
+		}
+		else if (command == "ucinewgame")
+		{
+			waitSearch();
+			table->clear();
+			for (auto& s : searchers)
+				s->newGame();
+		}
+		else if (command == "position")
+		{
+			waitSearch();
+			setPosition(args);
+		}
+		else if (command == "go")
+		{
+			waitSearch();
+			go(args);
+		}
+		else if (command == "stop")
+		{
+			stop();
+		}
+		else if (command == "ponderhit")
+		{
+			//    :    ,       
+			{
+				std::lock_guard lock(stopMutex);
+				infinite = false;
+			}
+			stopCondition.notify_all();
+		}
+		else if (command == "quit")
+		{
+			stop();
+			if (searchThread.joinable())
+				searchThread.join();
+			return false;
+		}
+		else if (command == "bench")
+		{
+			int depth = 0;
+			if (!(args >> depth) || depth <= 0)
+				depth = 9;
+			waitSearch();
+			bench(depth);
+		}
+		else if (command == "d")
+		{
+			waitSearch();
+			send(position.getFEN());
+		}
+		else
+		{
+			send("info string unknown command " + command);
+		}
+		return true;
+	}
+
+	void UciEngine::send(const std::string& line)
+	{
+		std::lock_guard lock(outMutex);
+		*out << line << std::endl;
+	}
+
+	void UciEngine::uci()
+	{
+		send("id name Chess");
+		send("id author Keronon");
+		send(core::concat("option name Hash type spin default ", DefaultHashMb, " min 1 max ", MaxHashMb));
+		send(core::concat("option name Threads type spin default 1 min 1 max ", MaxThreads));
+		send("option name Clear Hash type button");
+		send("option name Ponder type check default false");
+		send("uciok");
+	}
+
+	void UciEngine::setOption(std::istringstream& args)
+	{
+		// setoption name <   > [ value <> ]
+		std::string token, name, value;
+		args >> token;
+		while (args >> token && token != "value")
+			name += (name.empty() ? "" : " ") + token;
+		std::getline(args >> std::ws, value);
+
+		name = toLower(name);
+		if (name == "hash")
+		{
+			table->resize((size_t)std::clamp(std::atoi(value.c_str()), 1, MaxHashMb));
+		}
+		else if (name == "threads")
+		{
+			setThreads(std::clamp(std::atoi(value.c_str()), 1, MaxThreads));
+		}
+		else if (name == "clear hash")
+		{
+			table->clear();
+		}
+		else if (name == "ponder")
+		{
+			//     ( go ponder ) :     
+		}
+		else
+		{
+			send("info string unknown option " + name);
+		}
+	}
+
+	void UciEngine::setThreads(int count)
+	{
+		searchers.resize(count);
+		for (auto& s : searchers)
+		{
+			if (!s)
+				s = std::make_unique<Searcher>();
+			s->options.table = table;
+		}
+	}
+
+	void UciEngine::setPosition(std::istringstream& args)
+	{
+		// position startpos | fen <6 > [ moves <> ]
+		std::string token, fen;
+		args >> token;
+		if (token == "startpos")
+		{
+			fen = StartFEN;
+			args >> token;
+		}
+		else if (token == "fen")
+		{
+			while (args >> token && token != "moves")
+				fen += token + " ";
+		}
+		else
+		{
+			send("info string invalid position command");
+			return;
+		}
+
+		try
+		{
+			position = Position::fromFEN(fen);
+		}
+		catch (const std::exception& e)
+		{
+			send(core::concat("info string ", e.what()));
+			position = Position::startPosition();
+			return;
+		}
+
+		if (token != "moves")
+			return;
+
+		while (args >> token)
+		{
+			auto full = chess::FullMove::fromString(token);
+			auto m = full.from.isValid() ? position.findMove(full) : Move();
+			if (m.isNone())
+			{
+				send("info string illegal move " + token);
+				return;
+			}
+			Undo undo;
+			position.makeMove(m, undo);
+		}
+	}
+
+	void UciEngine::go(std::istringstream& args)
+	{
+		SearchLimits limits;
+		chess::SideEntries<int64_t> time = {}, increment = {};
+		int64_t movetime = 0;
+		int movesToGo = 0;
+		bool unlimited = false;
+		bool ponder = false;
+
+		std::string token;
+		while (args >> token)
+		{
+			if      (token == "wtime")     args >> time[chess::Side::White];
+			else if (token == "btime")     args >> time[chess::Side::Black];
+			else if (token == "winc")      args >> increment[chess::Side::White];
+			else if (token == "binc")      args >> increment[chess::Side::Black];
+			else if (token == "movestogo") args >> movesToGo;
+			else if (token == "movetime")  args >> movetime;
+			else if (token == "depth")     args >> limits.depth;
+			else if (token == "nodes")     args >> limits.nodes;
+			else if (token == "infinite")  unlimited = true;
+			else if (token == "ponder")    ponder = true;
+			else if (token == "searchmoves")
+			{
+				while (args >> token)
+				{
+					auto full = chess::FullMove::fromString(token);
+					if (auto m = full.from.isValid() ? position.findMove(full) : Move(); !m.isNone())
+						limits.searchMoves.push_back(m);
+				}
+			}
+		}
+		limits.depth = std::clamp(limits.depth, 1, MaxPly - 1);
+
+		//   -       ,
+		//        
+		auto side = position.getSide();
+		if (movetime > 0)
+		{
+			limits.movetimeMs = std::max<int64_t>(1, movetime - MoveOverhead);
+		}
+		else if (!unlimited && time[side] > 0)
+		{
+			int64_t moves = movesToGo > 0 ? std::min(movesToGo, 50) : 30;
+			int64_t budget = time[side] / moves + increment[side] * 3 / 4;
+			limits.movetimeMs = std::max<int64_t>(1, std::min(budget, time[side] - MoveOverhead));
+		}
+
+		//      :       ponderhit
+		int64_t ponderhitMs = 0;
+		if (ponder)
+		{
+			ponderhitMs = limits.movetimeMs;
+			limits.movetimeMs = 0;
+		}
+
+		stopFlag = false;
+		infinite = unlimited || ponder;
+		table->newSearch();
+		searchThread = std::thread(&UciEngine::searchWorker, this, position, std::move(limits), ponderhitMs);
+	}
+
+	void UciEngine::searchWorker(Position root, SearchLimits limits, int64_t ponderhitMs)
+	{
+		auto start = Clock::now();
+		limits.stop = &stopFlag;
+
+		//  ponderhit   ,      
+		std::thread timer;
+		if (ponderhitMs > 0)
+		{
+			timer = std::thread([this, ponderhitMs]()
+			{
+				std::unique_lock lock(stopMutex);
+				stopCondition.wait(lock, [this]() { return stopFlag || !infinite; });
+				stopCondition.wait_for(lock, std::chrono::milliseconds(ponderhitMs), [this]() { return bool(stopFlag); });
+				stopFlag = true;
+			});
+		}
+
+		//          ;
+		//    - -     
+		std::vector<std::thread> helpers;
+		for (size_t i = 1; i < searchers.size(); ++i)
+		{
+			helpers.emplace_back([this, i, root, limits]() mutable
+			{
+				searchers[i]->search(root, limits);
+			});
+		}
+
+		auto& main = *searchers.front();
+		main.onIteration = [&](const SearchResult& r)
+		{
+			if (!r.pv.empty())
+				send(formatInfo(r, main.getStats().nodes, millisecondsSince(start)));
+		};
+		auto result = main.search(root, limits);
+		main.onIteration = nullptr;
+
+		//        stop
+		{
+			std::unique_lock lock(stopMutex);
+			stopCondition.wait(lock, [this]() { return stopFlag || !infinite; });
+			stopFlag = true;
+		}
+		stopCondition.notify_all();
+		if (timer.joinable())
+			timer.join();
+
+		uint64_t nodes = 0;
+		for (auto& t : helpers)
+			t.join();
+		for (auto& s : searchers)
+			nodes += s->getStats().nodes;
+
+		auto elapsed = millisecondsSince(start);
+		send(core::concat("info nodes ", nodes, " nps ", nodes * 1000 / std::max<int64_t>(elapsed, 1),
+			              " time ", elapsed, " hashfull ", table->hashfull()));
+
+		//       -     
+		auto best = result.best;
+		if (best.isNone())
+		{
+			MoveList legal;
+			root.generateLegalMoves(legal);
+			if (!legal.empty())
+				best = legal[0];
+		}
+		send(core::concat("bestmove ", best));
+	}
+
+	void UciEngine::stop()
+	{
+		{
+			std::lock_guard lock(stopMutex);
+			stopFlag = true;
+		}
+		stopCondition.notify_all();
+	}
+
+	void UciEngine::waitSearch()
+	{
+		if (!searchThread.joinable())
+			return;
+		if (infinite)
+			stop();
+		searchThread.join();
+	}
+
+	std::string UciEngine::formatInfo(const SearchResult& result, uint64_t nodes, int64_t elapsedMs) const
+	{
+		std::ostringstream ss;
+		ss << "info depth " << result.depth << " score " << formatScore(result.score)
+		   << " nodes " << nodes << " nps " << nodes * 1000 / std::max<int64_t>(elapsedMs, 1)
+		   << " time " << elapsedMs << " hashfull " << table->hashfull() << " pv";
+		for (auto m : result.pv)
+			ss << " " << m;
+		return ss.str();
+	}
+
+	void UciEngine::bench(int depth)
+	{
+		//      :  ,     
+		SearchLimits limits;
+		limits.depth = depth;
+		auto& searcher = *searchers.front();
+
+		uint64_t nodes = 0;
+		auto start = Clock::now();
+		for (auto fen : BenchPositions)
+		{
+			auto pos = Position::fromFEN(fen);
+			table->clear();
+			searcher.newGame();
+			auto result = searcher.search(pos, limits);
+			nodes += searcher.getStats().nodes;
+			send(core::concat("info string ", fen, " : ", result.best, " ", formatScore(result.score),
+				              " nodes ", searcher.getStats().nodes));
+		}
+		auto elapsed = millisecondsSince(start);
+		send(core::concat(nodes, " nodes ", nodes * 1000 / std::max<int64_t>(elapsed, 1), " nps"));
+	}
+}
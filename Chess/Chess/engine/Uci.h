@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Search.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+	/// <summary>
+	///    UCI :     ,    .
+	///     ,   ( stop, isready, quit )     .
+	///    ( Threads )     ( Hash )
+	/// </summary>
+	class UciEngine
+	{
+	public:
+		UciEngine();
+		~UciEngine();
+
+		UciEngine(const UciEngine&) = delete;
+		UciEngine& operator=(const UciEngine&) = delete;
+
+		/// <summary>
+		///    quit   
+		/// </summary>
+		/// <param name="in"> </param>
+		/// <param name="out"> </param>
+		/// <returns>0 -    main()</returns>
+		int run(std::istream& in, std::ostream& out);
+
+		/// <summary>
+		///   
+		/// </summary>
+		/// <param name="line"> </param>
+		/// <returns>false -    quit</returns>
+		bool execute(const std::string& line);
+
+	private:
+		std::ostream* out = &std::cout;
+		std::mutex outMutex;
+
+		/// <summary>
+		///    position (       )
+		/// </summary>
+		Position position;
+
+		std::shared_ptr<TranspositionTable> table;
+
+		/// <summary>
+		///   :  -  (    ),  - 
+		/// </summary>
+		std::vector<std::unique_ptr<Searcher>> searchers;
+
+		std::thread searchThread;
+		std::atomic<bool> stopFlag = false;
+
+		/// <summary>
+		///    ( go infinite / ponder ) :     stop  ponderhit
+		/// </summary>
+		bool infinite = false;
+		std::mutex stopMutex;
+		std::condition_variable stopCondition;
+
+		/// <summary>
+		///     (       )
+		/// </summary>
+		/// <param name="line">   </param>
+		void send(const std::string& line);
+
+		void uci();
+		void setOption(std::istringstream& args);
+		void setPosition(std::istringstream& args);
+		void go(std::istringstream& args);
+		void bench(int depth);
+
+		/// <summary>
+		///   (      )
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		///    [     ]
+		/// </summary>
+		void waitSearch();
+
+		/// <summary>
+		///     :     ,   bestmove
+		/// </summary>
+		/// <param name="root"></param>
+		/// <param name="limits"> </param>
+		/// <param name="ponderhitMs">    ponderhit [ 0 -  stop    ]</param>
+		void searchWorker(Position root, SearchLimits limits, int64_t ponderhitMs);
+
+		void setThreads(int count);
+
+		/// <summary>
+		///  info    
+		/// </summary>
+		std::string formatInfo(const SearchResult& result, uint64_t nodes, int64_t elapsedMs) const;
+	};
+}
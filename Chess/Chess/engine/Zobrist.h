@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Types.h"
+
+namespace engine::zobrist
+{
+	/// <summary>
+	///    (splitmix64)      
+	/// </summary>
+	/// <param name="state"> </param>
+	/// <returns> </returns>
+	constexpr uint64_t next(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	/// <summary>
+	///   :   ,  ,    ,  
+	/// </summary>
+	struct Keys
+	{
+		uint64_t pieces[16][64] = {};
+		uint64_t castling[16]   = {};
+		uint64_t passing[8]     = {};
+		uint64_t side           = 0;
+
+		constexpr Keys()
+		{
+			uint64_t state = 0x2545F4914F6CDD1Dull;
+			for (auto& piece : pieces)
+				for (auto& key : piece)
+					key = next(state);
+			for (auto& key : castling) key = next(state);
+			for (auto& key : passing)  key = next(state);
+			side = next(state);
+		}
+	};
+
+	inline constexpr Keys keys{};
+}
@@ -0,0 +1,76 @@
+#include "../Chess/engine/Datagen.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "Datagen <.bin> [-g ] [-t ] [-n ] [-r  ] [-s   ]"
+	// -         [    ]
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o datagen
+	std::string path;
+	datagen::Options options;
+	options.threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-g" && i + 1 < argc)      options.games = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "-t" && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+		else if (arg == "-n" && i + 1 < argc) options.nodes = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "-r" && i + 1 < argc) options.randomPlies = std::atoi(argv[++i]);
+		else if (arg == "-s" && i + 1 < argc) options.seed = std::strtoull(argv[++i], nullptr, 10);
+		else if (path.empty() && !arg.empty() && arg[0] != '-') path = arg;
+		else
+		{
+			path.clear();
+			break;
+		}
+	}
+	if (path.empty())
+	{
+		std::cerr << "usage: Datagen <out.bin> [-g games] [-t threads] [-n nodes] [-r random plies] [-s seed]\n";
+		return 1;
+	}
+
+	try
+	{
+		auto stats = datagen::generate(path, options);
+
+		//    :        
+		auto readStart = std::chrono::steady_clock::now();
+		datagen::Reader reader(path);
+		uint64_t wins = 0, draws = 0;
+		auto total = reader.forEach([&](const datagen::Record& r)
+		{
+			wins += r.result != archive::Result::Draw;
+			draws += r.result == archive::Result::Draw;
+		});
+		double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - readStart).count();
+
+		std::cout << std::fixed << std::setprecision(2)
+			      << "games          " << std::setw(12) << stats.games << "\n"
+			      << "positions      " << std::setw(12) << stats.positions << "\n"
+			      << "bytes/position " << std::setw(12) << (stats.positions ? double(stats.bytes) / stats.positions : 0.0) << "\n"
+			      << "time           " << std::setw(12) << stats.seconds << " s ( " << options.threads << " threads )\n"
+			      << "positions/s    " << std::setw(12) << (stats.seconds > 0 ? stats.positions / stats.seconds : 0.0) << "\n"
+			      << "positions/hour " << std::setw(12) << (stats.seconds > 0 ? stats.positions / stats.seconds * 3600 : 0.0) << "\n"
+			      << "knps           " << std::setw(12) << (stats.seconds > 0 ? stats.nodes / stats.seconds / 1000 : 0.0) << "\n"
+			      << "file positions " << std::setw(12) << total << " ( decisive " << wins << ", drawn " << draws << " )\n"
+			      << "read time      " << std::setw(12) << readSeconds << " s" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include "../Chess/engine/Epd.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "Epd <> [-t ] [-m  | -n ] [-j .json]" -    EPD
+	// [   -    ;        ]
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o epd
+	std::string path, jsonPath;
+	epd::RunOptions options;
+	options.threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-t" && i + 1 < argc)      options.threads = std::atoi(argv[++i]);
+		else if (arg == "-m" && i + 1 < argc) options.movetimeMs = std::atoll(argv[++i]);
+		else if (arg == "-n" && i + 1 < argc)
+		{
+			options.nodes = std::strtoull(argv[++i], nullptr, 10);
+			options.movetimeMs = 0;
+		}
+		else if (arg == "-j" && i + 1 < argc) jsonPath = argv[++i];
+		else if (path.empty() && !arg.empty() && arg[0] != '-') path = arg;
+		else
+		{
+			path.clear();
+			break;
+		}
+	}
+	if (path.empty())
+	{
+		std::cerr << "usage: Epd <file.epd> [-t threads] [-m movetime | -n nodes] [-j report.json]\n";
+		return 1;
+	}
+
+	try
+	{
+		auto records = epd::load(path);
+		auto report = epd::run(records, options);
+		epd::writeTable(std::cout, records, report);
+
+		if (!jsonPath.empty())
+		{
+			std::ofstream json(jsonPath);
+			epd::writeJson(json, records, report);
+			if (!json)
+				throw std::runtime_error("epd: cannot write " + jsonPath);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
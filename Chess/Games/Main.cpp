@@ -0,0 +1,183 @@
+#include "../Chess/engine/Archive.h"
+#include "../Chess/engine/Explorer.h"
+#include "../Chess/engine/Pgn.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>
+	///   :  PGN  ,    .
+	///   , ,    
+	/// </summary>
+	void readPgn(const std::string& path, int threads)
+	{
+		pgn::Reader reader(path);
+		auto stats = reader.forEach(threads, [](const pgn::Game&, int) {});
+
+		double mb = stats.bytes / 1e6;
+		std::cout << std::fixed << std::setprecision(2)
+			      << "pgn " << path << " (" << threads << " threads)\n"
+			      << "games    " << std::setw(12) << stats.games << "\n"
+			      << "moves    " << std::setw(12) << stats.moves << "\n"
+			      << "errors   " << std::setw(12) << stats.errors << "\n"
+			      << "size     " << std::setw(12) << mb << " MB\n"
+			      << "time     " << std::setw(12) << stats.seconds << " s\n"
+			      << "speed    " << std::setw(12) << (stats.seconds > 0 ? mb / stats.seconds : 0.0) << " MB/s" << std::endl;
+	}
+
+	/// <summary>
+	///   PGN       :   ,   ,
+	///       
+	/// </summary>
+	void makeArchive(const std::string& pgnPath, const std::string& archivePath)
+	{
+		auto seconds = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+
+		pgn::Reader reader(pgnPath);
+		auto t0 = Clock::now();
+		uint64_t games = 0, plies = 0, skipped = 0, moveBytes = 0;
+		{
+			archive::Writer writer(archivePath);
+			auto parser = reader.parser();
+			pgn::Game game;
+			while (parser.next(game))
+			{
+				if (!game.error.empty())
+				{
+					++skipped;
+					continue;
+				}
+				auto result = game.result == "1-0" ? archive::Result::WhiteWins :
+							  game.result == "0-1" ? archive::Result::BlackWins :
+							  game.result == "1/2-1/2" ? archive::Result::Draw : archive::Result::Unknown;
+				writer.add(game.moves, result, game.tags);
+				++games;
+				plies += game.moves.size();
+			}
+			writer.close();
+		}
+		auto t1 = Clock::now();
+
+		archive::Reader arc(archivePath);
+		std::vector<chess::FullMove> moves;
+		for (size_t i = 0; i < arc.size(); ++i)
+		{
+			arc.readMoves(i, moves);
+			moveBytes += arc.entry(i).size;
+		}
+		auto t2 = Clock::now();
+		auto pgnStats = reader.forEach(1, [](const pgn::Game&, int) {});
+
+		auto archiveSize = double(std::filesystem::file_size(archivePath));
+		std::cout << std::fixed << std::setprecision(2)
+			      << "games          " << std::setw(12) << games << " ( skipped " << skipped << " )\n"
+			      << "plies          " << std::setw(12) << plies << "\n"
+			      << "pgn size       " << std::setw(12) << reader.text().size() / 1e6 << " MB\n"
+			      << "archive size   " << std::setw(12) << archiveSize / 1e6 << " MB ( x"
+			      << (archiveSize > 0 ? reader.text().size() / archiveSize : 0.0) << " smaller )\n"
+			      << "bits per ply   " << std::setw(12) << (plies > 0 ? moveBytes * 8.0 / plies : 0.0) << "\n"
+			      << "write          " << std::setw(12) << seconds(t1 - t0) << " s\n"
+			      << "read archive   " << std::setw(12) << seconds(t2 - t1) << " s\n"
+			      << "read pgn       " << std::setw(12) << pgnStats.seconds << " s" << std::endl;
+	}
+
+	/// <summary>
+	///            :
+	///         
+	/// </summary>
+	void buildExplorer(const std::string& path, const std::vector<std::string>& archives, int threads)
+	{
+		explorer::BuildOptions options;
+		options.threads = threads;
+		auto stats = explorer::Explorer::build(archives, path, options);
+		std::cout << std::fixed << std::setprecision(2)
+			      << "games          " << std::setw(12) << stats.games << " ( skipped " << stats.skipped << " )\n"
+			      << "positions      " << std::setw(12) << stats.positions << "\n"
+			      << "build          " << std::setw(12) << stats.seconds << " s ( " << threads << " threads )" << std::endl;
+
+		//    ,       
+		explorer::Explorer db(path);
+		archive::Reader reader(archives.at(0));
+		Clock::duration total{}, worst{};
+		uint64_t lookups = 0, found = 0;
+		for (size_t i = 0; i < reader.size(); ++i)
+		{
+			reader.replay(i, [&](const Position& pos, Move)
+			{
+				auto t0 = Clock::now();
+				found += db.lookup(pos).has_value();
+				auto d = Clock::now() - t0;
+				total += d;
+				worst = std::max(worst, d);
+				++lookups;
+			});
+		}
+		auto us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+		std::cout << "lookups        " << std::setw(12) << lookups << " ( found " << found << " )\n"
+			      << "lookup mean    " << std::setw(12) << (lookups > 0 ? us(total) / lookups : 0.0) << " us\n"
+			      << "lookup worst   " << std::setw(12) << us(worst) << " us" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	// "Games pgn <.pgn> [-t ]" -   
+	// "Games archive <.pgn> <>" -       
+	// "Games explorer <> <>... [-t ]" -    ( explorer.bin  Chess.exe )   
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o games
+	std::string_view mode = argc > 1 ? argv[1] : "";
+	std::vector<std::string> paths;
+	int threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	bool valid = true;
+	for (int i = 2; i < argc && valid; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-t" && i + 1 < argc)        threads = std::atoi(argv[++i]);
+		else if (!arg.empty() && arg[0] != '-') paths.emplace_back(arg);
+		else valid = false;
+	}
+	valid = valid && threads >= 1 &&
+		((mode == "pgn" && paths.size() == 1) ||
+		 (mode == "archive" && paths.size() == 2) ||
+		 (mode == "explorer" && paths.size() >= 2));
+	if (!valid)
+	{
+		std::cerr << "usage: Games pgn <games.pgn> [-t threads]\n"
+			      << "       Games archive <games.pgn> <archive.cga>\n"
+			      << "       Games explorer <explorer.bin> <archive.cga>... [-t threads]\n";
+		return 1;
+	}
+
+	try
+	{
+		if (mode == "pgn")
+			readPgn(paths[0], threads);
+		else if (mode == "archive")
+			makeArchive(paths[0], paths[1]);
+		else
+			buildExplorer(paths[0], { paths.begin() + 1, paths.end() }, threads);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "../Chess/engine/Match.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "Match [-a ] [-b ] [-o .pgn] [-p ] [-g ] [-t ]
+	//        [-tb ] [-sprt elo0 elo1] [-noadj] [-l ]" -    
+	//  -   ,  "name=new,nnue=net.bin,nodes=50000" ( . match::Player::parse )
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o match
+	std::string_view firstSpec, secondSpec;
+	std::string openingsPath, tablebasePath, logPath;
+	int plies = 8;
+	bool adjudicate = true;
+	match::Options options;
+	options.threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-a" && i + 1 < argc)        firstSpec = argv[++i];
+		else if (arg == "-b" && i + 1 < argc)   secondSpec = argv[++i];
+		else if (arg == "-o" && i + 1 < argc)   openingsPath = argv[++i];
+		else if (arg == "-p" && i + 1 < argc)   plies = std::atoi(argv[++i]);
+		else if (arg == "-g" && i + 1 < argc)   options.games = std::atoi(argv[++i]);
+		else if (arg == "-t" && i + 1 < argc)   options.threads = std::atoi(argv[++i]);
+		else if (arg == "-tb" && i + 1 < argc)  tablebasePath = argv[++i];
+		else if (arg == "-l" && i + 1 < argc)   logPath = argv[++i];
+		else if (arg == "-noadj")               adjudicate = false;
+		else if (arg == "-sprt" && i + 2 < argc)
+		{
+			options.sprt.enabled = true;
+			options.sprt.elo0 = std::atof(argv[++i]);
+			options.sprt.elo1 = std::atof(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "usage: Match [-a player] [-b player] [-o openings.pgn] [-p plies] [-g games] [-t threads]\n"
+				         "             [-tb directory] [-sprt elo0 elo1] [-noadj] [-l log]\n";
+			return 1;
+		}
+	}
+
+	//         :      
+	std::clog.rdbuf(nullptr);
+
+	try
+	{
+		auto first = match::Player::parse(firstSpec, "A");
+		auto second = match::Player::parse(secondSpec, "B");
+		if (!openingsPath.empty())
+		{
+			options.openings = match::loadOpenings(openingsPath, plies);
+			std::cout << options.openings.size() << " openings\n";
+		}
+		if (!tablebasePath.empty())
+			options.adjudication.tablebase = std::make_shared<tb::Tablebase>(tablebasePath);
+		if (!adjudicate)
+		{
+			options.adjudication.resignMoves = 0;
+			options.adjudication.drawMoves = 0;
+		}
+
+		std::ofstream logFile;
+		if (!logPath.empty())
+		{
+			logFile.open(logPath);
+			if (!logFile)
+				throw std::runtime_error("match: can't open " + logPath);
+		}
+
+		auto report = match::run(first, second, options, logPath.empty() ? std::cout : logFile);
+		auto& s = report.score;
+		std::cout << first.name << " vs " << second.name << ": " << s.wins << " - " << s.losses << " - " << s.draws
+			      << ", elo " << s.elo() << " +- " << s.eloError() << ", " << s.errors << " errors, "
+			      << report.seconds << " s\n";
+		if (options.sprt.enabled)
+		{
+			std::cout << "sprt: " << (report.sprtResult > 0 ? "H1 accepted" : report.sprtResult < 0 ? "H0 accepted" : "no decision")
+				      << " ( llr " << s.llr(options.sprt) << " )\n";
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
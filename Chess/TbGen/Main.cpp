@@ -0,0 +1,54 @@
+#include "../Chess/engine/TablebaseGen.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "TbGen [-o ] [-t ] [-n ] [KQvK ...]" -       n 
+	std::string directory = "tablebases";
+	int threads = int(std::max(1u, std::thread::hardware_concurrency()));
+	int pieces = 4;
+	std::vector<std::string> tables;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-o" && i + 1 < argc)      directory = argv[++i];
+		else if (arg == "-t" && i + 1 < argc) threads = std::atoi(argv[++i]);
+		else if (arg == "-n" && i + 1 < argc) pieces = std::atoi(argv[++i]);
+		else if (!arg.empty() && arg[0] != '-') tables.emplace_back(arg);
+		else
+		{
+			std::cerr << "usage: TbGen [-o directory] [-t threads] [-n pieces] [KQvK ...]\n";
+			return 1;
+		}
+	}
+
+	if (pieces < 3 || pieces > tb::MaxPieces)
+	{
+		std::cerr << "pieces must be from 3 to " << tb::MaxPieces << "\n";
+		return 1;
+	}
+	if (tables.empty())
+		tables = tb::Generator::allTables(pieces);
+
+	try
+	{
+		std::filesystem::create_directories(directory);
+		tb::Generator generator(directory, threads);
+		for (auto& material : tables)
+			generator.generate(material, std::cout);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
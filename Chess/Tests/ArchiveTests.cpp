@@ -0,0 +1,109 @@
+#include "Tests.h"
+
+#include "../Chess/engine/Archive.h"
+
+#include <cstdio>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace engine;
+
+namespace
+{
+	/// <summary>
+	///    "e2e4"
+	/// </summary>
+	std::vector<chess::FullMove> fromStrings(std::initializer_list<std::string_view> moves)
+	{
+		std::vector<chess::FullMove> result;
+		for (auto m : moves)
+			result.push_back(chess::FullMove::fromString(m));
+		return result;
+	}
+
+	/// <summary>
+	///     ( "e2e4 e7e5" ) :       
+	/// </summary>
+	std::string movesText(const std::vector<chess::FullMove>& moves)
+	{
+		std::ostringstream s;
+		for (auto& m : moves)
+			s << m << ' ';
+		return s.str();
+	}
+
+	/// <summary>
+	///    (  -     )   
+	/// </summary>
+	/// <param name="encoding"> </param>
+	void roundTrip(archive::Encoding encoding)
+	{
+		// ,   ,   
+		auto first = fromStrings({ "e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "g8f6", "e1g1", "f8c5", "d2d4", "e5d4",
+		                           "e4e5", "d7d5", "e5d6", "e8g8", "d6c7", "c8d7", "c7d8q", "f8d8" });
+		auto second = fromStrings({ "d2d4", "d7d5", "c2c4", "e7e6" });
+
+		auto path = tests::tempPath(encoding == archive::Encoding::Raw ? "chess-tests-raw.cga" : "chess-tests-ranked.cga");
+		{
+			archive::Writer writer(path, encoding);
+			writer.add(first, archive::Result::WhiteWins, { { "White", "Alpha" }, { "Black", "Beta" } });
+			writer.close();
+		}
+		{
+			archive::Writer writer(path, encoding, true);
+			CHECK(writer.size() == 1);
+			writer.add(second, archive::Result::Draw, { { "White", "Gamma" }, { "Event", "Append" } });
+			writer.close();
+		}
+
+		{
+			archive::Reader reader(path);
+			CHECK(reader.size() == 2);
+			CHECK(reader.getEncoding() == encoding);
+			if (reader.size() == 2)
+			{
+				std::vector<chess::FullMove> moves;
+				CHECK(reader.readMoves(0, moves));
+				CHECK(movesText(moves) == movesText(first));
+				CHECK(reader.readMoves(1, moves));
+				CHECK(movesText(moves) == movesText(second));
+
+				CHECK(reader.entry(0).plies == first.size());
+				CHECK(reader.entry(0).result == archive::Result::WhiteWins);
+				CHECK(reader.entry(1).result == archive::Result::Draw);
+
+				// ,      ,    
+				CHECK(reader.header(0, "White") == "Alpha");
+				CHECK(reader.header(0, "Black") == "Beta");
+				CHECK(reader.header(0, "Event").empty());
+				CHECK(reader.header(1, "White") == "Gamma");
+				CHECK(reader.header(1, "Black").empty());
+				CHECK(reader.header(1, "Event") == "Append");
+
+				//      
+				size_t plies = 0;
+				std::string startFen;
+				CHECK(reader.replay(0, [&](const Position& pos, Move)
+				{
+					if (plies++ == 0)
+						startFen = pos.getFEN();
+				}));
+				CHECK(plies == first.size());
+				CHECK(startFen == Position::startPosition().getFEN());
+			}
+		}
+		std::remove(path.c_str());
+	}
+}
+
+TEST(archiveRawRoundTrip)
+{
+	roundTrip(archive::Encoding::Raw);
+}
+
+TEST(archiveRankedRoundTrip)
+{
+	roundTrip(archive::Encoding::Ranked);
+}
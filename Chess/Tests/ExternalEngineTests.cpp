@@ -0,0 +1,106 @@
+#include "Tests.h"
+
+#include "../Chess/chess/Board.h"
+#include "../Chess/engine/ExternalEngine.h"
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <sstream>
+
+using namespace engine;
+
+namespace
+{
+	void onPromotion(chess::Side) {}
+	void onCheckmate(chess::FullMove, chess::Side) {}
+	void onStalemate(chess::FullMove, chess::Side) {}
+	void onDraw(chess::FullMove, std::string_view) {}
+
+	/// <summary>
+	///     [ from == Pos::Invalid -        5  ]
+	/// </summary>
+	chess::FullMove requestAndWait(ExternalEngine& engine, const chess::Board& board)
+	{
+		auto promise = std::make_shared<std::promise<chess::FullMove>>();
+		auto reply = promise->get_future();
+		engine.requestMove(board.getState(), board.getMoveHistory(), 10, [promise](chess::FullMove m) { promise->set_value(m); });
+		if (reply.wait_for(std::chrono::seconds(5)) != std::future_status::ready)
+			return {};
+		return reply.get();
+	}
+}
+
+namespace tests
+{
+	int runStubEngine()
+	{
+		//   go -   1.e4 :  ,  movetime  ,   stop.
+		//    -  ,    
+		bool answered = false, searching = false;
+		std::string line, command;
+		while (std::getline(std::cin, line))
+		{
+			std::istringstream ss(line);
+			if (!(ss >> command))
+				continue;
+			if (command == "uci")
+				std::cout << "id name Stub\nuciok" << std::endl;
+			else if (command == "isready")
+				std::cout << "readyok" << std::endl;
+			else if (command == "position" && answered)
+				std::cout << std::endl;
+			else if (command == "go" || (command == "stop" && searching))
+			{
+				int64_t movetime = 0;
+				if (command == "go" && ss >> command && command == "movetime" && ss >> movetime && movetime >= 1000)
+				{
+					searching = true;
+					continue;
+				}
+				searching = false;
+				answered = true;
+				std::cout << "bestmove e7e5" << std::endl;
+			}
+			else if (command == "quit")
+				break;
+		}
+		return 0;
+	}
+}
+
+TEST(externalEngineRoundTrip)
+{
+	chess::Board board(onPromotion, onCheckmate, onStalemate, onDraw);
+	board.reset();
+	board.doFullMove(chess::FullMove::fromString("e2e4"));
+
+	ExternalEngine engine(tests::selfCommand() + " stub-engine");
+	auto expected = chess::FullMove::fromString("e7e5");
+
+	for (int i = 0; i < 2; ++i)
+	{
+		auto m = requestAndWait(engine, board);
+		CHECK(m.from == expected.from);
+		CHECK(m.to == expected.to);
+	}
+	CHECK(engine.getName() == "Stub");
+	CHECK(engine.isAlive());
+}
+
+TEST(externalEngineBlankLineAfterCancelled)
+{
+	chess::Board board(onPromotion, onCheckmate, onStalemate, onDraw);
+	board.reset();
+	board.doFullMove(chess::FullMove::fromString("e2e4"));
+
+	ExternalEngine engine(tests::selfCommand() + " stub-engine");
+	auto expected = chess::FullMove::fromString("e7e5");
+
+	// bestmove   ,          
+	engine.requestMove(board.getState(), board.getMoveHistory(), 60000, [](chess::FullMove) {});
+	engine.cancel();
+	auto m = requestAndWait(engine, board);
+	CHECK(m.from == expected.from);
+	CHECK(m.to == expected.to);
+}
@@ -0,0 +1,65 @@
+#include "Tests.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+namespace tests
+{
+	namespace
+	{
+		int failures = 0;
+		std::string self;
+	}
+
+	std::vector<Case>& registry()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	void check(bool ok, const char* expr, const char* file, int line)
+	{
+		if (ok)
+			return;
+		++failures;
+		std::cout << "  " << file << ":" << line << ": failed: " << expr << "\n";
+	}
+
+	const std::string& selfCommand() { return self; }
+
+	std::string tempPath(std::string_view name)
+	{
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	// "Tests []" -     [  -  ,      ]
+	// "Tests stub-engine" - -,    ExternalEngine
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess *.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o tests
+	std::string_view filter = argc > 1 ? argv[1] : "";
+	if (filter == "stub-engine")
+		return tests::runStubEngine();
+	tests::self = std::string("\"") + argv[0] + "\"";
+
+	//        
+	std::clog.rdbuf(nullptr);
+
+	int run = 0;
+	for (auto& c : tests::registry())
+	{
+		if (std::string_view(c.name).find(filter) == std::string_view::npos)
+			continue;
+		int before = tests::failures;
+		c.run();
+		++run;
+		std::cout << (tests::failures == before ? "ok     " : "FAILED ") << c.name << "\n";
+	}
+
+	std::cout << run << " tests, " << tests::failures << " failed checks" << std::endl;
+	return tests::failures == 0 ? 0 : 1;
+}
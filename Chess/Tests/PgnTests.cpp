@@ -0,0 +1,112 @@
+#include "Tests.h"
+
+#include "../Chess/engine/Annotate.h"
+#include "../Chess/engine/Pgn.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace engine;
+
+namespace
+{
+	constexpr std::string_view Games =
+		"[Event \"Round trip\"]\n"
+		"[White \"Alpha\"]\n"
+		"[Black \"Beta\"]\n"
+		"[Result \"1-0\"]\n"
+		"\n"
+		"1. e4 e5 2. Nf3 Nc6 3. Bc4 Nf6 4. O-O Bc5 5. d3 d6 6. Bg5 h6 7. Bxf6 Qxf6\n"
+		"8. Nc3 O-O 9. Nd5 Qd8 1-0\n"
+		"\n"
+		"[Event \"Round trip\"]\n"
+		"[SetUp \"1\"]\n"
+		"[FEN \"4k3/1P6/8/3pP3/8/8/8/R3K3 w Q d6 0 1\"]\n"
+		"[Result \"*\"]\n"
+		"\n"
+		"1. exd6 Kd7 2. b8=N+ Kxd6 3. O-O-O+ Kc5 *\n";
+
+	/// <summary>
+	///     ( "e2e4 e7e5" ) :       
+	/// </summary>
+	std::string movesText(const std::vector<chess::FullMove>& moves)
+	{
+		std::ostringstream s;
+		for (auto& m : moves)
+			s << m << ' ';
+		return s.str();
+	}
+
+	/// <summary>
+	///    (     text )
+	/// </summary>
+	std::vector<pgn::Game> parseAll(std::string_view text)
+	{
+		std::vector<pgn::Game> games;
+		pgn::Parser parser(text);
+		pgn::Game game;
+		while (parser.next(game))
+			games.push_back(game);
+		return games;
+	}
+}
+
+TEST(pgnParseSkipsCommentsAndVariations)
+{
+	// , , NAG,      :    
+	constexpr std::string_view noisy =
+		"[Event \"Noise\"]\n"
+		"\n"
+		"1.e4 {king pawn} e5 (1... c5 2. Nf3 {sicilian}) 2.Nf3 $1 Nc6 ; comment\n"
+		"3. Bc4!? 3... Nf6 1/2-1/2\n";
+	constexpr std::string_view plain = "1. e4 e5 2. Nf3 Nc6 3. Bc4 Nf6 1/2-1/2\n";
+
+	auto a = parseAll(noisy);
+	auto b = parseAll(plain);
+	CHECK(a.size() == 1 && b.size() == 1);
+	if (a.size() != 1 || b.size() != 1)
+		return;
+	CHECK(a[0].error.empty());
+	CHECK(a[0].moves.size() == 6);
+	CHECK(movesText(a[0].moves) == movesText(b[0].moves));
+	CHECK(a[0].result == "1/2-1/2");
+	CHECK(a[0].tag("Event") == "Noise");
+}
+
+TEST(pgnAnnotateRoundTrip)
+{
+	//  PGN      : ,     
+	auto inputPath = tests::tempPath("chess-tests-input.pgn");
+	std::ofstream(inputPath, std::ios::binary) << Games;
+
+	annotate::Options options;
+	options.nodes = 0;
+	options.depth = 1;
+	options.hashMegabytes = 1;
+	std::ostringstream out;
+	auto stats = annotate::run(inputPath, out, options);
+	std::remove(inputPath.c_str());
+	CHECK(stats.games == 2);
+	CHECK(stats.errors == 0);
+
+	auto written = out.str();
+	auto source = parseAll(Games);
+	auto read = parseAll(written);
+	CHECK(source.size() == 2);
+	CHECK(read.size() == source.size());
+	if (read.size() != source.size())
+		return;
+
+	for (size_t i = 0; i < source.size(); ++i)
+	{
+		CHECK(read[i].error.empty());
+		CHECK(movesText(read[i].moves) == movesText(source[i].moves));
+		CHECK(read[i].result == source[i].result);
+		for (auto& tag : source[i].tags)
+			CHECK(read[i].tag(tag.name) == tag.value);
+		CHECK(read[i].tag("Annotator") == "Chess");
+	}
+}
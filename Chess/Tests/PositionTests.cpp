@@ -0,0 +1,69 @@
+#include "Tests.h"
+
+#include "../Chess/chess/Board.h"
+#include "../Chess/engine/Position.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <string_view>
+
+using namespace engine;
+
+namespace
+{
+	void onPromotion(chess::Side) {}
+	void onCheckmate(chess::FullMove, chess::Side) {}
+	void onStalemate(chess::FullMove, chess::Side) {}
+	void onDraw(chess::FullMove, std::string_view) {}
+
+	/// <summary>
+	///          
+	/// </summary>
+	Position afterMoves(std::initializer_list<std::string_view> moves)
+	{
+		chess::Board board(onPromotion, onCheckmate, onStalemate, onDraw);
+		board.reset();
+		for (auto m : moves)
+			board.doFullMove(chess::FullMove::fromString(m));
+		return Position::fromState(board.getState());
+	}
+
+	bool hasMove(Position& pos, Square from, Square to, MoveFlag flag)
+	{
+		MoveList list;
+		pos.generateLegalMoves(list);
+		return std::find(list.begin(), list.end(), Move(from, to, flag)) != list.end();
+	}
+}
+
+TEST(fromStatePassingWhite)
+{
+	// 1.e4 a6 2.e5 d5 :     exd6
+	auto pos = afterMoves({ "e2e4", "a7a6", "e4e5", "d7d5" });
+	CHECK(pos.getPassing() == toSquare(3, 5));
+	CHECK(hasMove(pos, toSquare(4, 4), toSquare(3, 5), MoveFlag::Passing));
+	CHECK(pos.getKey() == Position::fromFEN("rnbqkbnr/1pp1pppp/p7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3").getKey());
+}
+
+TEST(fromStateAfterPassingCapture)
+{
+	// 1.e4 a6 2.e5 d5 3.exd6 :       
+	auto pos = afterMoves({ "e2e4", "a7a6", "e4e5", "d7d5", "e5d6" });
+	CHECK(pos.getPassing() == NoSquare);
+	CHECK(pos.at(toSquare(3, 4)) == NoPiece);
+	CHECK(pos.getKey() == Position::fromFEN("rnbqkbnr/1pp1pppp/p2P4/8/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 3").getKey());
+}
+
+TEST(fromStatePassingBlack)
+{
+	// 1.Nf3 d6 2.e4 :    ,   - e3
+	auto pos = afterMoves({ "g1f3", "d7d6", "e2e4" });
+	CHECK(pos.getPassing() == toSquare(4, 2));
+	CHECK(!hasMove(pos, toSquare(3, 5), toSquare(4, 4), MoveFlag::Passing));
+
+	// 1.a3 d5 2.a4 d4 3.e4 :     dxe3
+	pos = afterMoves({ "a2a3", "d7d5", "a3a4", "d5d4", "e2e4" });
+	CHECK(pos.getPassing() == toSquare(4, 2));
+	CHECK(hasMove(pos, toSquare(3, 3), toSquare(4, 2), MoveFlag::Passing));
+	CHECK(pos.getKey() == Position::fromFEN("rnbqkbnr/ppp1pppp/8/8/P2pP3/8/1PPP1PPP/RNBQKBNR b KQkq e3 0 3").getKey());
+}
@@ -0,0 +1,80 @@
+#include "Tests.h"
+
+#include "../Chess/engine/San.h"
+
+#include <initializer_list>
+#include <string_view>
+
+using namespace engine;
+
+namespace
+{
+	/// <summary>
+	///        :     
+	/// </summary>
+	/// <param name="fen"> </param>
+	/// <param name="moves">  SAN</param>
+	void roundTrip(std::string_view fen, std::initializer_list<std::string_view> moves)
+	{
+		auto pos = Position::fromFEN(fen);
+		for (auto text : moves)
+		{
+			auto m = san::parse(pos, text);
+			CHECK(!m.isNone());
+			if (m.isNone())
+				return;
+
+			char buffer[san::BufferSize];
+			int length = san::write(pos, m, buffer);
+			CHECK(std::string_view(buffer, length) == text);
+
+			Undo undo;
+			CHECK(pos.makeMove(m, undo));
+		}
+	}
+
+	constexpr std::string_view StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+}
+
+TEST(sanRoundTripGame)
+{
+	//  - , 1992 : ,    ( Nbd7, Nbd2, Rae8 ),   
+	roundTrip(StartFEN, {
+		"e4", "e5", "Nf3", "Nc6", "Bb5", "a6", "Ba4", "Nf6", "O-O", "Be7",
+		"Re1", "b5", "Bb3", "d6", "c3", "O-O", "h3", "Nb8", "d4", "Nbd7",
+		"c4", "c6", "cxb5", "axb5", "Nc3", "Bb7", "Bg5", "b4", "Nb1", "h6",
+		"Bh4", "c5", "dxe5", "Nxe4", "Bxe7", "Qxe7", "exd6", "Qf6", "Nbd2", "Nxd6",
+		"Nc4", "Nxc4", "Bxc4", "Nb6", "Ne5", "Rae8", "Bxf7+", "Rxf7", "Nxf7", "Rxe1+",
+		"Qxe1", "Kxf7", "Qe3", "Qg5", "Qxg5", "hxg5", "b3", "Ke6", "a3", "Kd6",
+		"axb4", "cxb4", "Ra5", "Nd5", "f3", "Bc8", "Kf2", "Bf5", "Ra7", "g6",
+		"Ra6+", "Kc5", "Ke1", "Nf4", "g3", "Nxh3", "Kd2", "Kb5", "Rd6", "Kc5",
+		"Ra6", "Nf2", "g4", "Bd3", "Re6" });
+}
+
+TEST(sanRoundTripSpecialMoves)
+{
+	//   ,     ,    
+	roundTrip("4k3/1P6/8/3pP3/8/8/8/R3K3 w Q d6 0 1", { "exd6", "Kd7", "b8=N+", "Kxd6", "O-O-O+" });
+
+	//     
+	roundTrip("1r2k3/2P5/8/8/8/8/8/4K3 w - - 0 1", { "cxb8=Q+", "Kd7", "Qb7+" });
+
+	// 
+	roundTrip(StartFEN, { "f3", "e5", "g4", "Qh4#" });
+}
+
+TEST(sanParseVariants)
+{
+	//    ,  , "0-0"    - 
+	auto pos = Position::fromFEN("4k3/8/8/8/8/8/8/1N2KN2 w - - 0 1");
+	CHECK(san::parse(pos, "Nd2").isNone());
+	CHECK(!san::parse(pos, "Nbd2").isNone());
+	CHECK(san::parse(pos, "Nb1d2") == san::parse(pos, "Nbd2"));
+	CHECK(san::parse(pos, "Nfd2!?") == san::parse(pos, "Nfd2"));
+	CHECK(san::parse(pos, "Nbd2") != san::parse(pos, "Nfd2"));
+
+	auto castle = Position::fromFEN("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+	CHECK(!san::parse(castle, "O-O").isNone());
+	CHECK(san::parse(castle, "0-0") == san::parse(castle, "O-O"));
+	CHECK(san::parse(castle, "0-0-0") == san::parse(castle, "O-O-O"));
+}
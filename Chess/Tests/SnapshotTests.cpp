@@ -0,0 +1,121 @@
+#include "Tests.h"
+
+#include "../Chess/chess/Board.h"
+#include "../Chess/engine/Position.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace engine;
+
+namespace
+{
+	void onPromotion(chess::Side) {}
+	void onCheckmate(chess::FullMove, chess::Side) {}
+	void onStalemate(chess::FullMove, chess::Side) {}
+	void onDraw(chess::FullMove, std::string_view) {}
+
+	chess::Board makeBoard()
+	{
+		return chess::Board(onPromotion, onCheckmate, onStalemate, onDraw);
+	}
+
+	void play(chess::Board& board, std::initializer_list<std::string_view> moves)
+	{
+		for (auto m : moves)
+			board.doFullMove(chess::FullMove::fromString(m));
+	}
+
+	std::vector<std::byte> snapshot(const chess::Board& board)
+	{
+		std::vector<std::byte> data(board.getSerializedSize());
+		data.resize(board.serialize(data));
+		return data;
+	}
+
+	/// <summary>
+	///  ,    ,    : , ,    
+	/// </summary>
+	void checkRestored(const chess::Board& source, const chess::Board& restored)
+	{
+		auto& a = source.getState();
+		auto& b = restored.getState();
+		CHECK(Position::fromState(a).getFEN() == Position::fromState(b).getFEN());
+		CHECK(Position::fromState(a).getKey() == Position::fromState(b).getKey());
+		CHECK(a.getHalfMoveClock() == b.getHalfMoveClock());
+		CHECK(a.getMoveCounter() == b.getMoveCounter());
+		CHECK(a.getCurrentSide() == b.getCurrentSide());
+		CHECK(a.getPassingTarget() == b.getPassingTarget());
+
+		auto& ha = source.getMoveHistory();
+		auto& hb = restored.getMoveHistory();
+		CHECK(ha.size() == hb.size());
+		for (size_t i = 0; i < std::min(ha.size(), hb.size()); ++i)
+			CHECK(ha[i].from == hb[i].from && ha[i].to == hb[i].to && ha[i].promotionResult == hb[i].promotionResult);
+
+		for (auto side : { chess::Side::White, chess::Side::Black })
+			CHECK(source.getEatenPieces(side).size() == restored.getEatenPieces(side).size());
+	}
+}
+
+TEST(snapshotPassingAndCastling)
+{
+	// 1.e4 a6 2.e5 d5 :   ,     
+	auto board = makeBoard();
+	board.reset();
+	play(board, { "e2e4", "a7a6", "e4e5", "d7d5" });
+
+	auto restored = makeBoard();
+	restored.reset();
+	restored.deserialize(snapshot(board));
+	checkRestored(board, restored);
+
+	auto pos = Position::fromState(restored.getState());
+	CHECK(pos.getPassing() == toSquare(3, 5));
+	CHECK(pos.getKey() == Position::fromFEN("rnbqkbnr/1pp1pppp/p7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3").getKey());
+
+	//      ,  
+	play(board, { "e5d6" });
+	play(restored, { "e5d6" });
+	checkRestored(board, restored);
+	CHECK(restored.getState().getPassingTarget() == chess::Pos::Invalid);
+	CHECK(restored.getEatenPieces(chess::Side::Black).size() == 1);
+}
+
+TEST(snapshotLostCastling)
+{
+	//  ,   h8  :     
+	auto board = makeBoard();
+	board.reset();
+	play(board, { "e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "g8f6", "e1g1", "h8g8" });
+
+	auto restored = makeBoard();
+	restored.deserialize(snapshot(board));
+	checkRestored(board, restored);
+	CHECK(Position::fromState(restored.getState()).getKey()
+		== Position::fromFEN("r1bqkbr1/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQ1RK1 w q - 6 5").getKey());
+}
+
+TEST(snapshotRejectsDamagedData)
+{
+	//   ,   
+	auto board = makeBoard();
+	board.reset();
+	play(board, { "e2e4", "e7e5" });
+	auto data = snapshot(board);
+
+	auto restored = makeBoard();
+	restored.reset();
+	auto before = Position::fromState(restored.getState()).getKey();
+
+	bool thrown = false;
+	try { restored.deserialize(std::span(data).first(data.size() - 1)); }
+	catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+	CHECK(Position::fromState(restored.getState()).getKey() == before);
+	CHECK(restored.getMoveHistory().empty());
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tests
+{
+	/// <summary>
+	///  :   
+	/// </summary>
+	struct Case
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	/// <summary>
+	///    (    Register  main() )
+	/// </summary>
+	std::vector<Case>& registry();
+
+	struct Register
+	{
+		Register(const char* name, void (*run)()) { registry().push_back({ name, run }); }
+	};
+
+	/// <summary>
+	///    :  ,  
+	/// </summary>
+	/// <param name="ok"> </param>
+	/// <param name="expr"> </param>
+	/// <param name="file"></param>
+	/// <param name="line"></param>
+	void check(bool ok, const char* expr, const char* file, int line);
+
+	/// <summary>
+	///      (      )
+	/// </summary>
+	const std::string& selfCommand();
+
+	/// <summary>
+	///         [    ]
+	/// </summary>
+	/// <param name="name"> </param>
+	std::string tempPath(std::string_view name);
+
+	/// <summary>
+	///  "Tests stub-engine" :   UCI   ExternalEngine
+	/// </summary>
+	/// <returns> </returns>
+	int runStubEngine();
+}
+
+#define TEST(name) \
+	static void name(); \
+	static tests::Register name##Registered(#name, name); \
+	static void name()
+
+#define CHECK(expr) tests::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
@@ -0,0 +1,80 @@
+#include "../Chess/engine/Tune.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace engine;
+
+int main(int argc, char* argv[])
+{
+	// "Tune <.bin> <EvalWeights.h> [-t ] [-e ]"
+	// -       (  Datagen ),     
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Parallel.cpp ../Chess/core/Utils.cpp -o tune
+	std::string dataPath, headerPath;
+	tune::Options options;
+	options.threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+	bool valid = true;
+	for (int i = 1; i < argc && valid; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "-t" && i + 1 < argc)      options.threads = std::atoi(argv[++i]);
+		else if (arg == "-e" && i + 1 < argc) options.epochs = std::atoi(argv[++i]);
+		else if (dataPath.empty() && !arg.empty() && arg[0] != '-') dataPath = arg;
+		else if (headerPath.empty() && !arg.empty() && arg[0] != '-') headerPath = arg;
+		else valid = false;
+	}
+	if (!valid || headerPath.empty() || options.threads < 1 || options.epochs < 1)
+	{
+		std::cerr << "usage: Tune <positions.bin> <EvalWeights.h> [-t threads] [-e epochs]\n";
+		return 1;
+	}
+
+	try
+	{
+		auto loadStart = std::chrono::steady_clock::now();
+		auto data = tune::Dataset::load(dataPath, options.threads);
+		double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+		std::cout << std::fixed << std::setprecision(2)
+			      << "positions      " << std::setw(12) << data.size() << " ( skipped " << data.skipped() << " )\n"
+			      << "bytes/position " << std::setw(12) << data.bytesPerPosition() << "\n"
+			      << "load time      " << std::setw(12) << loadSeconds << " s ( " << options.threads << " threads )" << std::endl;
+		if (data.size() == 0)
+		{
+			std::cerr << "no quiet positions in " << dataPath << "\n";
+			return 1;
+		}
+
+		auto weights = tune::Weights::current();
+		auto report = tune::run(data, options, weights, std::cout);
+
+		std::ofstream header(headerPath, std::ios::binary);
+		tune::writeHeader(header, weights);
+		if (!header)
+		{
+			std::cerr << "cannot write " << headerPath << "\n";
+			return 1;
+		}
+		std::cout << std::fixed << std::setprecision(6)
+			      << "k              " << std::setw(12) << report.k << "\n"
+			      << "loss before    " << std::setw(12) << report.lossBefore << "\n"
+			      << "loss after     " << std::setw(12) << report.lossAfter << "\n"
+			      << std::setprecision(2)
+			      << "tune time      " << std::setw(12) << report.seconds << " s\n"
+			      << "positions/s    " << std::setw(12) << (report.seconds > 0 ? double(data.size()) * options.epochs / report.seconds : 0.0) << "\n"
+			      << "header         " << std::setw(12) << headerPath << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,33 @@
+#include "../Chess/engine/Uci.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+int main(int argc, char* argv[])
+{
+	// "chess-uci" -     ( cutechess, arena )   UCI
+	// "chess-uci bench [depth]" -     
+	//   Visual Studio :
+	//   g++ -std=c++20 -O2 -pthread -I../Chess Main.cpp ../Chess/engine/*.cpp ../Chess/chess/*.cpp
+	//       ../Chess/core/ChildProcess.cpp ../Chess/core/MappedFile.cpp ../Chess/core/Utils.cpp -o chess-uci
+	std::ios::sync_with_stdio(false);
+	std::cin.tie(nullptr);
+
+	engine::UciEngine uci;
+	if (argc > 1 && std::string_view(argv[1]) == "bench")
+	{
+		uci.execute(std::string("bench ") + (argc > 2 ? argv[2] : ""));
+		return 0;
+	}
+
+	try
+	{
+		return uci.run(std::cin, std::cout);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+}